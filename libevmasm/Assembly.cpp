@@ -34,7 +34,9 @@
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 #include <libsolutil/StringUtils.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <fmt/format.h>
 
@@ -46,6 +48,7 @@
 #include <fstream>
 #include <limits>
 #include <iterator>
+#include <mutex>
 #include <stack>
 
 using namespace solidity;
@@ -54,6 +57,7 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 
 std::map<std::string, std::shared_ptr<std::string const>> Assembly::s_sharedSourceNames;
+std::mutex Assembly::s_sharedSourceNamesMutex;
 
 AssemblyItem const& Assembly::append(AssemblyItem _i)
 {
@@ -70,15 +74,23 @@ AssemblyItem const& Assembly::append(AssemblyItem _i)
 
 unsigned Assembly::codeSize(unsigned subTagSize) const
 {
+	// Only the items pushing tags, data or sub-assembly offsets depend on the tag size,
+	// so the items are sized once and the tag size is resolved arithmetically.
+	size_t sizeWithoutAddresses = 1;
+	size_t addressCount = 0;
+	for (auto const& i: m_data)
+		sizeWithoutAddresses += i.second.size();
+	for (auto const& codeSection: m_codeSections)
+		for (AssemblyItem const& i: codeSection.items)
+		{
+			sizeWithoutAddresses += i.bytesRequired(0, m_evmVersion, Precision::Precise);
+			if (i.type() == PushTag || i.type() == PushData || i.type() == PushSub)
+				++addressCount;
+		}
+
 	for (unsigned tagSize = subTagSize; true; ++tagSize)
 	{
-		size_t ret = 1;
-		for (auto const& i: m_data)
-			ret += i.second.size();
-
-		for (auto const& codeSection: m_codeSections)
-			for (AssemblyItem const& i: codeSection.items)
-				ret += i.bytesRequired(tagSize, m_evmVersion, Precision::Precise);
+		size_t ret = sizeWithoutAddresses + addressCount * tagSize;
 		if (numberEncodingSize(ret) <= tagSize)
 			return static_cast<unsigned>(ret);
 	}
@@ -683,6 +695,7 @@ void Assembly::encodeAllPossibleSubPathsInAssemblyTree(std::vector<size_t> _path
 
 std::shared_ptr<std::string const> Assembly::sharedSourceName(std::string const& _name) const
 {
+	std::lock_guard<std::mutex> lock(s_sharedSourceNamesMutex);
 	if (s_sharedSourceNames.find(_name) == s_sharedSourceNames.end())
 		s_sharedSourceNames[_name] = std::make_shared<std::string>(_name);
 
@@ -772,36 +785,72 @@ AssemblyItem Assembly::newAuxDataLoadN(size_t _offset)
 	return AssemblyItem{AuxDataLoadN, _offset};
 }
 
-Assembly& Assembly::optimise(OptimiserSettings const& _settings)
+Assembly& Assembly::optimise(OptimiserSettings const& _settings, size_t _threadCount)
 {
-	optimiseInternal(_settings, {});
+	// Assemblies only exchange tag replacements with the assemblies containing them, so every
+	// assembly can be optimised as soon as all its subs are. Collecting them in a sequential
+	// traversal fixes which tags are considered referenced from outside a shared sub, so the
+	// result does not depend on the order in which the tasks finish.
+	std::vector<std::pair<Assembly*, std::set<size_t>>> assemblies;
+	std::vector<std::set<size_t>> dependencies;
+	std::map<Assembly const*, size_t> indices;
+	collectAssembliesToOptimise({}, assemblies, dependencies, indices);
+
+	util::runTaskGraph(dependencies, _threadCount, [&](size_t _index) {
+		auto& [assembly, tagsReferencedFromOutside] = assemblies[_index];
+		assembly->optimiseInternal(_settings, std::move(tagsReferencedFromOutside));
+	});
 	return *this;
 }
 
-std::map<u256, u256> const& Assembly::optimiseInternal(
-	OptimiserSettings const& _settings,
-	std::set<size_t> _tagsReferencedFromOutside
+std::optional<size_t> Assembly::collectAssembliesToOptimise(
+	std::set<size_t> _tagsReferencedFromOutside,
+	std::vector<std::pair<Assembly*, std::set<size_t>>>& _assemblies,
+	std::vector<std::set<size_t>>& _dependencies,
+	std::map<Assembly const*, size_t>& _indices
 )
 {
 	if (m_tagReplacements)
-		return *m_tagReplacements;
+		return std::nullopt;
+	if (auto it = _indices.find(this); it != _indices.end())
+		return it->second;
 
-	// Run optimisation for sub-assemblies.
+	std::set<size_t> dependencies;
 	// TODO: verify and double-check this for EOF.
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 	{
-		OptimiserSettings settings = _settings;
-		Assembly& sub = *m_subs[subId];
+		// Tag replacements of other subs do not touch references to this one,
+		// so it does not matter that they are not applied yet.
 		std::set<size_t> referencedTags;
 		for (auto& codeSection: m_codeSections)
 			referencedTags += JumpdestRemover::referencedTags(codeSection.items, subId);
-		std::map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
-			settings,
-			referencedTags
-		);
-		// Apply the replacements (can be empty).
+		if (
+			std::optional<size_t> subIndex =
+				m_subs[subId]->collectAssembliesToOptimise(std::move(referencedTags), _assemblies, _dependencies, _indices)
+		)
+			dependencies.insert(*subIndex);
+	}
+
+	size_t index = _assemblies.size();
+	_assemblies.emplace_back(this, std::move(_tagsReferencedFromOutside));
+	_dependencies.emplace_back(std::move(dependencies));
+	_indices[this] = index;
+	return index;
+}
+
+void Assembly::optimiseInternal(
+	OptimiserSettings const& _settings,
+	std::set<size_t> _tagsReferencedFromOutside
+)
+{
+	solAssert(!m_tagReplacements);
+
+	// Apply the replacements of the already optimised sub-assemblies (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		solAssert(m_subs[subId]->m_tagReplacements, "Sub-assembly not optimised.");
 		for (auto& codeSection: m_codeSections)
-			BlockDeduplicator::applyTagReplacement(codeSection.items, subTagReplacements, subId);
+			BlockDeduplicator::applyTagReplacement(codeSection.items, *m_subs[subId]->m_tagReplacements, subId);
 	}
 
 	std::map<u256, u256> tagReplacements;
@@ -813,6 +862,7 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		// TODO: verify this for EOF.
 		if (_settings.runInliner && !m_eofVersion.has_value())
 		{
+			util::Profiler::Probe probe("Inliner", "evmasm-optimizer");
 			solAssert(m_codeSections.size() == 1);
 			Inliner{
 				m_codeSections.front().items,
@@ -825,6 +875,7 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		// TODO: verify this for EOF.
 		if (_settings.runJumpdestRemover && !m_eofVersion.has_value())
 		{
+			util::Profiler::Probe probe("JumpdestRemover", "evmasm-optimizer");
 			for (auto& codeSection: m_codeSections)
 			{
 				JumpdestRemover jumpdestOpt{codeSection.items};
@@ -836,6 +887,7 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		// TODO: verify this for EOF.
 		if (_settings.runPeephole && !m_eofVersion.has_value())
 		{
+			util::Profiler::Probe probe("PeepholeOptimiser", "evmasm-optimizer");
 			for (auto& codeSection: m_codeSections)
 			{
 				PeepholeOptimiser peepOpt{codeSection.items, m_evmVersion};
@@ -850,6 +902,8 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		// This only modifies PushTags, we have to run again to actually remove code.
 		// TODO: implement for EOF.
 		if (_settings.runDeduplicate && !m_eofVersion.has_value())
+		{
+			util::Profiler::Probe probe("BlockDeduplicator", "evmasm-optimizer");
 			for (auto& section: m_codeSections)
 			{
 				BlockDeduplicator deduplicator{section.items};
@@ -874,10 +928,12 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 					count++;
 				}
 			}
+		}
 
 		// TODO: investigate for EOF
 		if (_settings.runCSE && !m_eofVersion.has_value())
 		{
+			util::Profiler::Probe probe("CommonSubexpressionEliminator", "evmasm-optimizer");
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
@@ -932,15 +988,17 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 
 	// TODO: investigate for EOF
 	if (_settings.runConstantOptimiser && !m_eofVersion.has_value())
+	{
+		util::Profiler::Probe probe("ConstantOptimiser", "evmasm-optimizer");
 		ConstantOptimisationMethod::optimiseConstants(
 			isCreation(),
 			isCreation() ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
 			*this
 		);
+	}
 
 	m_tagReplacements = std::move(tagReplacements);
-	return *m_tagReplacements;
 }
 
 namespace
@@ -1118,6 +1176,7 @@ LinkerObject const& Assembly::assemble() const
 	if (!m_assembledObject.bytecode.empty())
 		return m_assembledObject;
 
+	util::Profiler::Probe probe("Assembly", "evmasm", m_name);
 	// Otherwise ensure the object is actually clear.
 	solRequire(m_assembledObject.linkReferences.empty(), AssemblyException, "Unexpected link references.");
 
@@ -1130,63 +1189,63 @@ LinkerObject const& Assembly::assemble() const
 		return assembleEOF();
 }
 
-[[nodiscard]] bytes Assembly::assembleOperation(AssemblyItem const& _item) const
+void Assembly::assembleOperation(AssemblyItem const& _item, bytes& _bytecode) const
 {
 	// solidity::evmasm::Instructions underlying type is uint8_t
 	// TODO: Change to std::to_underlying since C++23
-	return {static_cast<uint8_t>(_item.instruction())};
+	_bytecode.push_back(static_cast<uint8_t>(_item.instruction()));
 }
 
-[[nodiscard]] bytes Assembly::assemblePush(AssemblyItem const& _item) const
+void Assembly::assemblePush(AssemblyItem const& _item, bytes& _bytecode) const
 {
-	bytes ret;
 	unsigned pushValueSize = numberEncodingSize(_item.data());
 	if (pushValueSize == 0 && !m_evmVersion.hasPush0())
 		pushValueSize = 1;
 
 	// solidity::evmasm::Instructions underlying type is uint8_t
 	// TODO: Change to std::to_underlying since C++23
-	ret.push_back(static_cast<uint8_t>(pushInstruction(pushValueSize)));
+	_bytecode.push_back(static_cast<uint8_t>(pushInstruction(pushValueSize)));
 	if (pushValueSize > 0)
-		appendBigEndian(ret, pushValueSize, _item.data());
-
-	return ret;
+		appendBigEndian(_bytecode, pushValueSize, _item.data());
 }
 
-[[nodiscard]] std::pair<bytes, Assembly::LinkRef> Assembly::assemblePushLibraryAddress(AssemblyItem const& _item, size_t _pos) const
+Assembly::LinkRef Assembly::assemblePushLibraryAddress(AssemblyItem const& _item, bytes& _bytecode) const
 {
-	return {
-		// solidity::evmasm::Instructions underlying type is uint8_t
-		// TODO: Change to std::to_underlying since C++23
-		bytes(1, static_cast<uint8_t>(Instruction::PUSH20)) + bytes(20),
-		{_pos + 1, m_libraries.at(_item.data())}
-	};
+	// solidity::evmasm::Instructions underlying type is uint8_t
+	// TODO: Change to std::to_underlying since C++23
+	_bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH20));
+	LinkRef linkRef{_bytecode.size(), m_libraries.at(_item.data())};
+	_bytecode.resize(_bytecode.size() + 20);
+	return linkRef;
 }
 
-[[nodiscard]] bytes Assembly::assembleVerbatimBytecode(AssemblyItem const& item) const
+void Assembly::assembleVerbatimBytecode(AssemblyItem const& _item, bytes& _bytecode) const
 {
-	return item.verbatimData();
+	_bytecode += _item.verbatimData();
 }
 
-[[nodiscard]] bytes Assembly::assemblePushDeployTimeAddress() const
+void Assembly::assemblePushDeployTimeAddress(bytes& _bytecode) const
 {
 	// solidity::evmasm::Instructions underlying type is uint8_t
 	// TODO: Change to std::to_underlying since C++23
-	return bytes(1, static_cast<uint8_t>(Instruction::PUSH20)) + bytes(20);
+	_bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH20));
+	_bytecode.resize(_bytecode.size() + 20);
 }
 
-[[nodiscard]] bytes Assembly::assembleTag(AssemblyItem const& _item, size_t _pos, bool _addJumpDest) const
+void Assembly::assembleTag(AssemblyItem const& _item, bytes& _bytecode, bool _addJumpDest) const
 {
+	size_t const position = _bytecode.size();
 	solRequire(_item.data() != 0, AssemblyException, "Invalid tag position.");
 	solRequire(_item.splitForeignPushTag().first == std::numeric_limits<size_t>::max(), AssemblyException, "Foreign tag.");
-	solRequire(_pos < 0xffffffffL, AssemblyException, "Tag too large.");
+	solRequire(position < 0xffffffffL, AssemblyException, "Tag too large.");
 	size_t tagId = static_cast<size_t>(_item.data());
 	solRequire(m_tagPositionsInBytecode[tagId] == std::numeric_limits<size_t>::max(), AssemblyException, "Duplicate tag position.");
-	m_tagPositionsInBytecode[tagId] = _pos;
+	m_tagPositionsInBytecode[tagId] = position;
 
 	// solidity::evmasm::Instructions underlying type is uint8_t
 	// TODO: Change to std::to_underlying since C++23
-	return _addJumpDest ? bytes(1, static_cast<uint8_t>(Instruction::JUMPDEST)) : bytes();
+	if (_addJumpDest)
+		_bytecode.push_back(static_cast<uint8_t>(Instruction::JUMPDEST));
 }
 
 LinkerObject const& Assembly::assembleLegacy() const
@@ -1226,6 +1285,10 @@ LinkerObject const& Assembly::assembleLegacy() const
 	assertThrow(m_codeSections.size() == 1, AssemblyException, "Expected exactly one code section in non-EOF code.");
 	AssemblyItems const& items = m_codeSections.front().items;
 
+	// Determine everything the layout depends on in a single pass, so that the bytecode
+	// can be emitted in one go afterwards: the size of the immutable assignments and
+	// the widest position of a tag in a sub-assembly that is referenced from here.
+	size_t maxSubTagPosition = 0;
 	for (auto const& item: items)
 		if (item.type() == AssignImmutable)
 		{
@@ -1234,6 +1297,16 @@ LinkerObject const& Assembly::assembleLegacy() const
 		}
 		else if (item.type() == PushImmutable)
 			pushesImmutables = true;
+		else if (item.type() == PushTag)
+		{
+			auto [subId, tagId] = item.splitForeignPushTag();
+			if (subId == std::numeric_limits<size_t>::max())
+				continue;
+			assertThrow(subId < m_subs.size(), AssemblyException, "Invalid sub id");
+			auto subTagPosition = m_subs[subId]->m_tagPositionsInBytecode.at(tagId);
+			assertThrow(subTagPosition != std::numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
+			maxSubTagPosition = std::max(maxSubTagPosition, subTagPosition);
+		}
 	if (setsImmutables || pushesImmutables)
 		assertThrow(
 			setsImmutables != pushesImmutables,
@@ -1243,19 +1316,8 @@ LinkerObject const& Assembly::assembleLegacy() const
 
 	unsigned bytesRequiredForCode = codeSize(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = std::vector<size_t>(m_usedTags, std::numeric_limits<size_t>::max());
-	unsigned bytesPerTag = numberEncodingSize(bytesRequiredForCode);
 	// Adjust bytesPerTag for references to sub assemblies.
-	for (AssemblyItem const& item: items)
-		if (item.type() == PushTag)
-		{
-			auto [subId, tagId] = item.splitForeignPushTag();
-			if (subId == std::numeric_limits<size_t>::max())
-				continue;
-			assertThrow(subId < m_subs.size(), AssemblyException, "Invalid sub id");
-			auto subTagPosition = m_subs[subId]->m_tagPositionsInBytecode.at(tagId);
-			assertThrow(subTagPosition != std::numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
-			bytesPerTag = std::max(bytesPerTag, numberEncodingSize(subTagPosition));
-		}
+	unsigned bytesPerTag = std::max(numberEncodingSize(bytesRequiredForCode), numberEncodingSize(maxSubTagPosition));
 
 	unsigned bytesRequiredIncludingData = bytesRequiredForCode + 1 + static_cast<unsigned>(m_auxiliaryData.size());
 	for (auto const& sub: m_subs)
@@ -1280,15 +1342,15 @@ LinkerObject const& Assembly::assembleLegacy() const
 		switch (item.type())
 		{
 		case Operation:
-			ret.bytecode += assembleOperation(item);
+			assembleOperation(item, ret.bytecode);
 			break;
 		case Push:
-			ret.bytecode += assemblePush(item);
+			assemblePush(item, ret.bytecode);
 			break;
 		case PushTag:
 		{
 			ret.bytecode.push_back(tagPush);
-			tagRefs[ret.bytecode.size()] = item.splitForeignPushTag();
+			tagRefs.emplace_back(ret.bytecode.size(), item.splitForeignPushTag());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
@@ -1307,7 +1369,7 @@ LinkerObject const& Assembly::assembleLegacy() const
 		{
 			assertThrow(item.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
 			auto s = subAssemblyById(static_cast<size_t>(item.data()))->assemble().bytecode.size();
-			item.setPushedValue(u256(s));
+			item.setPushedValue(s);
 			unsigned b = std::max<unsigned>(1, numberEncodingSize(s));
 			ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
 			ret.bytecode.resize(ret.bytecode.size() + b);
@@ -1323,12 +1385,8 @@ LinkerObject const& Assembly::assembleLegacy() const
 			break;
 		}
 		case PushLibraryAddress:
-		{
-			auto const [bytecode, linkRef] = assemblePushLibraryAddress(item, ret.bytecode.size());
-			ret.bytecode += bytecode;
-			ret.linkReferences.insert(linkRef);
+			ret.linkReferences.insert(assemblePushLibraryAddress(item, ret.bytecode));
 			break;
-		}
 		case PushImmutable:
 			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH32));
 			// Maps keccak back to the "identifier" std::string of that immutable.
@@ -1339,7 +1397,7 @@ LinkerObject const& Assembly::assembleLegacy() const
 			ret.bytecode.resize(ret.bytecode.size() + 32);
 			break;
 		case VerbatimBytecode:
-			ret.bytecode += assembleVerbatimBytecode(item);
+			assembleVerbatimBytecode(item, ret.bytecode);
 			break;
 		case AssignImmutable:
 		{
@@ -1368,10 +1426,10 @@ LinkerObject const& Assembly::assembleLegacy() const
 			break;
 		}
 		case PushDeployTimeAddress:
-			ret.bytecode += assemblePushDeployTimeAddress();
+			assemblePushDeployTimeAddress(ret.bytecode);
 			break;
 		case Tag:
-			ret.bytecode += assembleTag(item, ret.bytecode.size(), true);
+			assembleTag(item, ret.bytecode, true);
 			break;
 		default:
 			solAssert(false, "Unexpected opcode while assembling.");
@@ -1390,24 +1448,22 @@ LinkerObject const& Assembly::assembleLegacy() const
 		// Append an INVALID here to help tests find miscompilation.
 		ret.bytecode.push_back(static_cast<uint8_t>(Instruction::INVALID));
 
-	std::map<LinkerObject, size_t> subAssemblyOffsets;
+	// Sub-assemblies are assembled and cached already, so they are compared in place.
+	auto compareLinkerObjects = [](LinkerObject const* _a, LinkerObject const* _b) { return *_a < *_b; };
+	std::map<LinkerObject const*, size_t, decltype(compareLinkerObjects)> subAssemblyOffsets(compareLinkerObjects);
 	for (auto const& [subIdPath, bytecodeOffset]: subRefs)
 	{
-		LinkerObject subObject = subAssemblyById(subIdPath)->assemble();
+		LinkerObject const& subObject = subAssemblyById(subIdPath)->assemble();
 		bytesRef r(ret.bytecode.data() + bytecodeOffset, bytesPerDataRef);
 
 		// In order for de-duplication to kick in, not only must the bytecode be identical, but
 		// link and immutables references as well.
-		if (size_t* subAssemblyOffset = util::valueOrNullptr(subAssemblyOffsets, subObject))
-			toBigEndian(*subAssemblyOffset, r);
-		else
-		{
-			toBigEndian(ret.bytecode.size(), r);
-			subAssemblyOffsets[subObject] = ret.bytecode.size();
+		auto [subAssemblyOffset, inserted] = subAssemblyOffsets.try_emplace(&subObject, ret.bytecode.size());
+		toBigEndian(subAssemblyOffset->second, r);
+		if (inserted)
 			ret.bytecode += subObject.bytecode;
-		}
 		for (auto const& ref: subObject.linkReferences)
-			ret.linkReferences[ref.first + subAssemblyOffsets[subObject]] = ref.second;
+			ret.linkReferences[ref.first + subAssemblyOffset->second] = ref.second;
 	}
 	for (auto const& i: tagRefs)
 	{
@@ -1426,16 +1482,23 @@ LinkerObject const& Assembly::assembleLegacy() const
 		bytesRef r(ret.bytecode.data() + i.first, bytesPerTag);
 		toBigEndian(pos, r);
 	}
-	for (auto const& [name, tagInfo]: m_namedTags)
+	// Index of the first occurrence of each tag in the items, looked up for the named tags.
+	std::vector<std::optional<size_t>> tagIndices;
+	if (!m_namedTags.empty())
 	{
-		size_t position = m_tagPositionsInBytecode.at(tagInfo.id);
-		std::optional<size_t> tagIndex;
+		tagIndices.resize(m_usedTags);
 		for (auto&& [index, item]: items | ranges::views::enumerate)
-			if (item.type() == Tag && static_cast<size_t>(item.data()) == tagInfo.id)
+			if (item.type() == Tag && static_cast<size_t>(item.data()) < tagIndices.size())
 			{
-				tagIndex = index;
-				break;
+				std::optional<size_t>& tagIndex = tagIndices[static_cast<size_t>(item.data())];
+				if (!tagIndex)
+					tagIndex = index;
 			}
+	}
+	for (auto const& [name, tagInfo]: m_namedTags)
+	{
+		size_t position = m_tagPositionsInBytecode.at(tagInfo.id);
+		std::optional<size_t> tagIndex = tagInfo.id < tagIndices.size() ? tagIndices[tagInfo.id] : std::nullopt;
 		ret.functionDebugData[name] = {
 			position == std::numeric_limits<size_t>::max() ? std::nullopt : std::optional<size_t>{position},
 			tagIndex,
@@ -1534,8 +1597,9 @@ LinkerObject const& Assembly::assembleEOF() const
 	ret.bytecode = headerBytecode;
 
 	m_tagPositionsInBytecode = std::vector<size_t>(m_usedTags, std::numeric_limits<size_t>::max());
-	std::map<size_t, uint16_t> dataSectionRef;
-	std::map<size_t, size_t> tagRef;
+	// Reference positions are collected in ascending order.
+	std::vector<std::pair<size_t, uint16_t>> dataSectionRef;
+	std::vector<std::pair<size_t, size_t>> tagRef;
 
 	for (auto&& [codeSectionIndex, codeSection]: m_codeSections | ranges::views::enumerate)
 	{
@@ -1561,23 +1625,19 @@ LinkerObject const& Assembly::assembleEOF() const
 					item.instruction() != Instruction::RETF
 				);
 				solAssert(!(item.instruction() >= Instruction::PUSH0 && item.instruction() <= Instruction::PUSH32));
-				ret.bytecode += assembleOperation(item);
+				assembleOperation(item, ret.bytecode);
 				break;
 			case Push:
-				ret.bytecode += assemblePush(item);
+				assemblePush(item, ret.bytecode);
 				break;
 			case PushLibraryAddress:
-			{
-				auto const [pushLibraryAddressBytecode, linkRef] = assemblePushLibraryAddress(item, ret.bytecode.size());
-				ret.bytecode += pushLibraryAddressBytecode;
-				ret.linkReferences.insert(linkRef);
+				ret.linkReferences.insert(assemblePushLibraryAddress(item, ret.bytecode));
 				break;
-			}
 			case RelativeJump:
 			case ConditionalRelativeJump:
 			{
 				ret.bytecode.push_back(static_cast<uint8_t>(item.instruction()));
-				tagRef[ret.bytecode.size()] = item.relativeJumpTagID();
+				tagRef.emplace_back(ret.bytecode.size(), item.relativeJumpTagID());
 				appendBigEndianUint16(ret.bytecode, 0u);
 				break;
 			}
@@ -1600,20 +1660,20 @@ LinkerObject const& Assembly::assembleEOF() const
 				break;
 			}
 			case VerbatimBytecode:
-				ret.bytecode += assembleVerbatimBytecode(item);
+				assembleVerbatimBytecode(item, ret.bytecode);
 				break;
 			case PushDeployTimeAddress:
-				ret.bytecode += assemblePushDeployTimeAddress();
+				assemblePushDeployTimeAddress(ret.bytecode);
 				break;
 			case Tag:
-				ret.bytecode += assembleTag(item, ret.bytecode.size(), false);
+				assembleTag(item, ret.bytecode, false);
 				break;
 			case AuxDataLoadN:
 			{
 				// In findMaxAuxDataLoadNOffset we already verified that unsigned data value fits 2 bytes
 				solAssert(item.data() <= std::numeric_limits<uint16_t>::max(), "Invalid auxdataloadn position.");
 				ret.bytecode.push_back(uint8_t(Instruction::DATALOADN));
-				dataSectionRef[ret.bytecode.size()] = static_cast<uint16_t>(item.data());
+				dataSectionRef.emplace_back(ret.bytecode.size(), static_cast<uint16_t>(item.data()));
 				appendBigEndianUint16(ret.bytecode, item.data());
 				break;
 			}
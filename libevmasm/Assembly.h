@@ -38,6 +38,7 @@
 #include <sstream>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <utility>
 
 namespace solidity::evmasm
@@ -47,7 +48,8 @@ using AssemblyPointer = std::shared_ptr<Assembly>;
 
 class Assembly
 {
-	using TagRefs = std::map<size_t, std::pair<size_t, size_t>>;
+	/// Positions of tag references in the bytecode, in ascending order, with the referenced sub id and tag.
+	using TagRefs = std::vector<std::pair<size_t, std::pair<size_t, size_t>>>;
 	using DataRefs = std::multimap<util::h256, unsigned>;
 	using SubAssemblyRefs = std::multimap<size_t, size_t>;
 	using ProgramSizeRefs = std::vector<unsigned>;
@@ -176,7 +178,9 @@ public:
 
 	/// Modify and return the current assembly such that creation and execution gas usage
 	/// is optimised according to the settings in @a _settings.
-	Assembly& optimise(OptimiserSettings const& _settings);
+	/// Sub-assemblies that do not contain each other are optimised concurrently on up to
+	/// @a _threadCount threads. The result does not depend on the number of threads.
+	Assembly& optimise(OptimiserSettings const& _settings, size_t _threadCount = 1);
 
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
@@ -239,10 +243,22 @@ public:
 	}
 
 protected:
-	/// Does the same operations as @a optimise, but should only be applied to a sub and
-	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
+	/// Appends this assembly and all its sub-assemblies that have not been optimised yet to
+	/// @a _assemblies in the order a depth-first traversal finishes them, together with the tags
+	/// referenced from the super-assembly that reaches them first. @a _dependencies receives
+	/// the indices of the sub-assemblies each of them has to wait for.
+	/// @returns the index of this assembly in @a _assemblies or nullopt if it is already optimised.
+	std::optional<size_t> collectAssembliesToOptimise(
+		std::set<size_t> _tagsReferencedFromOutside,
+		std::vector<std::pair<Assembly*, std::set<size_t>>>& _assemblies,
+		std::vector<std::set<size_t>>& _dependencies,
+		std::map<Assembly const*, size_t>& _indices
+	);
+	/// Does the same operations as @a optimise, but requires all sub-assemblies to have been
+	/// optimised already and only applies their tag replacements. Stores the replaced tags
+	/// of this assembly. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
-	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	void optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
 
 	/// For EOF and legacy it calculates approximate size of "pure" code without data.
 	unsigned codeSize(unsigned subTagSize) const;
@@ -279,13 +295,13 @@ private:
 	/// Returns max AuxDataLoadN offset for the assembly.
 	std::optional<uint16_t> findMaxAuxDataLoadNOffset() const;
 
-	/// Assemble bytecode for AssemblyItem type.
-	[[nodiscard]] bytes assembleOperation(AssemblyItem const& _item) const;
-	[[nodiscard]] bytes assemblePush(AssemblyItem const& _item) const;
-	[[nodiscard]] std::pair<bytes, Assembly::LinkRef> assemblePushLibraryAddress(AssemblyItem const& _item, size_t _pos) const;
-	[[nodiscard]] bytes assembleVerbatimBytecode(AssemblyItem const& item) const;
-	[[nodiscard]] bytes assemblePushDeployTimeAddress() const;
-	[[nodiscard]] bytes assembleTag(AssemblyItem const& _item, size_t _pos, bool _addJumpDest) const;
+	/// Append bytecode for AssemblyItem type to @a _bytecode, without temporary buffers.
+	void assembleOperation(AssemblyItem const& _item, bytes& _bytecode) const;
+	void assemblePush(AssemblyItem const& _item, bytes& _bytecode) const;
+	[[nodiscard]] LinkRef assemblePushLibraryAddress(AssemblyItem const& _item, bytes& _bytecode) const;
+	void assembleVerbatimBytecode(AssemblyItem const& _item, bytes& _bytecode) const;
+	void assemblePushDeployTimeAddress(bytes& _bytecode) const;
+	void assembleTag(AssemblyItem const& _item, bytes& _bytecode, bool _addJumpDest) const;
 
 protected:
 	/// 0 is reserved for exception
@@ -334,6 +350,7 @@ protected:
 
 	// FIXME: This being static means that the strings won't be freed when they're no longer needed
 	static std::map<std::string, std::shared_ptr<std::string const>> s_sharedSourceNames;
+	static std::mutex s_sharedSourceNamesMutex;
 
 public:
 	size_t m_currentModifierDepth = 0;
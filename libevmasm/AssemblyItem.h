@@ -29,6 +29,8 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Assertions.h>
+#include <limits>
+#include <memory>
 #include <optional>
 #include <iostream>
 #include <sstream>
@@ -75,7 +77,7 @@ using ContainerID = uint8_t;
 class AssemblyItem
 {
 public:
-	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
+	enum class JumpType: uint8_t { Ordinary, IntoFunction, OutOfFunction };
 
 	AssemblyItem(u256 _push, langutil::DebugData::ConstPtr _debugData = langutil::DebugData::create()):
 		AssemblyItem(Push, std::move(_push), std::move(_debugData)) { }
@@ -91,20 +93,21 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			setData(_data);
 	}
 
 	explicit AssemblyItem(AssemblyItemType _type, Instruction _instruction, u256 _data = 0, langutil::DebugData::ConstPtr _debugData = langutil::DebugData::create()):
 		m_type(_type),
 		m_instruction(_instruction),
-		m_data(std::make_shared<u256>(std::move(_data))),
 		m_debugData(std::move(_debugData))
-	{}
+	{
+		setData(_data);
+	}
 
 	explicit AssemblyItem(bytes _verbatimData, size_t _arguments, size_t _returnVariables):
 		m_type(VerbatimBytecode),
 		m_instruction{},
-		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}},
+		m_verbatimBytecode{std::make_shared<std::tuple<size_t, size_t, bytes> const>(_arguments, _returnVariables, std::move(_verbatimData))},
 		m_debugData{langutil::DebugData::create()}
 	{}
 
@@ -167,8 +170,25 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { solAssert(m_type != Operation && m_data != nullptr); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const
+	{
+		solAssert(m_type != Operation && m_type != VerbatimBytecode);
+		return m_largeData ? *m_largeData : u256(m_data);
+	}
+	void setData(u256 const& _data)
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		if (_data <= std::numeric_limits<uint64_t>::max())
+		{
+			m_data = static_cast<uint64_t>(_data);
+			m_largeData.reset();
+		}
+		else
+		{
+			m_data = 0;
+			m_largeData = std::make_shared<u256 const>(_data);
+		}
+	}
 
 	/// This function is used in `Assembly::assemblyJSON`.
 	/// It returns the name & data of the current assembly item.
@@ -209,6 +229,8 @@ public:
 			return instruction() == _other.instruction();
 		else if (type() == VerbatimBytecode)
 			return *m_verbatimBytecode == *_other.m_verbatimBytecode;
+		else if (!m_largeData && !_other.m_largeData)
+			return m_data == _other.m_data;
 		else
 			return data() == _other.data();
 	}
@@ -222,6 +244,8 @@ public:
 			return instruction() < _other.instruction();
 		else if (type() == VerbatimBytecode)
 			return *m_verbatimBytecode < *_other.m_verbatimBytecode;
+		else if (!m_largeData && !_other.m_largeData)
+			return m_data < _other.m_data;
 		else
 			return data() < _other.data();
 	}
@@ -281,8 +305,8 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(size_t _value) const { m_pushedValue = _value; }
+	std::optional<size_t> pushedValue() const { return m_pushedValue; }
 
 	std::string toAssemblyText(Assembly const& _assembly) const;
 
@@ -308,18 +332,24 @@ public:
 private:
 	size_t opcodeCount() const noexcept;
 
+	// The members are ordered to avoid padding. Items are copied a lot by the optimiser,
+	// so data that most items do not need is kept out of line.
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
+	JumpType m_jumpType = JumpType::Ordinary;
 	std::optional<FunctionSignature> m_functionSignature; ///< Only valid if m_type == CallF or JumpF
+	/// Data of the item if it fits into 64 bits. Only valid if m_type != Operation.
+	uint64_t m_data = 0;
+	/// Data of the item if it does not fit into m_data, e.g. hashes and foreign tags.
+	/// Never modified and thus shared between copies.
+	std::shared_ptr<u256 const> m_largeData;
 	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
-	/// return variables and verbatim bytecode.
-	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
+	/// return variables and verbatim bytecode. Never modified and thus shared between copies.
+	std::shared_ptr<std::tuple<size_t, size_t, bytes> const> m_verbatimBytecode;
 	langutil::DebugData::ConstPtr m_debugData;
-	JumpType m_jumpType = JumpType::Ordinary;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
+	mutable std::optional<size_t> m_pushedValue;
 	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
 	mutable std::optional<size_t> m_immutableOccurrences;
 };
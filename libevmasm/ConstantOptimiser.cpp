@@ -22,6 +22,7 @@
 
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantRepresentationCache.h>
 #include <libevmasm/GasMeter.h>
 
 using namespace solidity;
@@ -55,21 +56,29 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 			params.isCreation = _isCreation;
 			params.runs = _runs;
 			params.evmVersion = _evmVersion;
-			LiteralMethod lit(params, item.data());
-			bigint literalGas = lit.gasNeeded();
-			CodeCopyMethod copy(params, item.data());
-			bigint copyGas = copy.gasNeeded();
-			ComputeMethod compute(params, item.data());
-			bigint computeGas = compute.gasNeeded();
+			ConstantRepresentationCache::Key key{
+				ConstantRepresentationCache::CostModel::Assembly,
+				item.data(),
+				_evmVersion,
+				_isCreation,
+				_runs,
+				it.second
+			};
+			std::optional<ConstantRepresentationCache::Entry> choice = ConstantRepresentationCache::find(key);
+			if (!choice)
+			{
+				choice = chooseMethod(params, item.data());
+				ConstantRepresentationCache::store(std::move(key), *choice);
+			}
 			AssemblyItems replacement;
-			if (copyGas < literalGas && copyGas < computeGas)
+			if (choice->method == ConstantRepresentationCache::Method::CodeCopy)
 			{
-				replacement = copy.execute(_assembly);
+				replacement = CodeCopyMethod(params, item.data()).execute(_assembly);
 				optimisations++;
 			}
-			else if (computeGas < literalGas && computeGas <= copyGas)
+			else if (choice->method == ConstantRepresentationCache::Method::Compute)
 			{
-				replacement = compute.execute(_assembly);
+				replacement = std::move(choice->routine);
 				optimisations++;
 			}
 			if (!replacement.empty())
@@ -81,6 +90,22 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	return optimisations;
 }
 
+ConstantRepresentationCache::Entry ConstantOptimisationMethod::chooseMethod(Params const& _params, u256 const& _value)
+{
+	LiteralMethod lit(_params, _value);
+	bigint literalGas = lit.gasNeeded();
+	CodeCopyMethod copy(_params, _value);
+	bigint copyGas = copy.gasNeeded();
+	ComputeMethod compute(_params, _value);
+	bigint computeGas = compute.gasNeeded();
+	if (copyGas < literalGas && copyGas < computeGas)
+		return {ConstantRepresentationCache::Method::CodeCopy, {}};
+	else if (computeGas < literalGas && computeGas <= copyGas)
+		return {ConstantRepresentationCache::Method::Compute, compute.routine()};
+	else
+		return {ConstantRepresentationCache::Method::Literal, {}};
+}
+
 bigint ConstantOptimisationMethod::simpleRunGas(AssemblyItems const& _items, langutil::EVMVersion _evmVersion)
 {
 	bigint gas = 0;
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <libevmasm/ConstantRepresentationCache.h>
 #include <libevmasm/Exceptions.h>
 
 #include <liblangutil/EVMVersion.h>
@@ -34,8 +35,6 @@
 namespace solidity::evmasm
 {
 
-class AssemblyItem;
-using AssemblyItems = std::vector<AssemblyItem>;
 class Assembly;
 
 /**
@@ -45,7 +44,7 @@ class ConstantOptimisationMethod
 {
 public:
 	/// Tries to optimised how constants are represented in the source code and modifies
-	/// @a _assembly.
+	/// @a _assembly. The chosen representations are memoised in ConstantRepresentationCache.
 	/// @returns zero if no optimisations could be performed.
 	static unsigned optimiseConstants(
 		bool _isCreation,
@@ -75,6 +74,9 @@ protected:
 	virtual AssemblyItems execute(Assembly& _assembly) const = 0;
 
 protected:
+	/// Compares the costs of all methods for @a _value.
+	/// @returns the cheapest method, together with the routine if the value should be computed.
+	static ConstantRepresentationCache::Entry chooseMethod(Params const& _params, u256 const& _value);
 	/// @returns the run gas for the given items ignoring special gas costs
 	static bigint simpleRunGas(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
 	/// @returns the gas needed to store the given data literally
@@ -95,7 +97,7 @@ protected:
 	static void replaceConstants(AssemblyItems& _items, std::map<u256, AssemblyItems> const& _replacements);
 
 	Params m_params;
-	u256 const& m_value;
+	u256 const m_value;
 };
 
 /**
@@ -148,6 +150,7 @@ public:
 	{
 		return m_routine;
 	}
+	AssemblyItems const& routine() const { return m_routine; }
 
 protected:
 	/// Tries to recursively find a way to compute @a _value.
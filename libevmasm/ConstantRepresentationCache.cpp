@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libevmasm/ConstantRepresentationCache.h>
+
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+struct Memo
+{
+	std::shared_mutex mutex;
+	std::map<ConstantRepresentationCache::Key, ConstantRepresentationCache::Entry> entries;
+};
+
+Memo& memo()
+{
+	static Memo memo;
+	return memo;
+}
+
+}
+
+bool ConstantRepresentationCache::Key::operator<(Key const& _other) const
+{
+	return
+		std::tie(costModel, value, evmVersion, isCreation, runs, multiplicity) <
+		std::tie(_other.costModel, _other.value, _other.evmVersion, _other.isCreation, _other.runs, _other.multiplicity);
+}
+
+std::optional<ConstantRepresentationCache::Entry> ConstantRepresentationCache::find(Key const& _key)
+{
+	Memo& cache = memo();
+	std::shared_lock<std::shared_mutex> lock(cache.mutex);
+	auto it = cache.entries.find(_key);
+	if (it == cache.entries.end())
+		return std::nullopt;
+	return it->second;
+}
+
+void ConstantRepresentationCache::store(Key _key, Entry _entry)
+{
+	Memo& cache = memo();
+	std::unique_lock<std::shared_mutex> lock(cache.mutex);
+	if (cache.entries.size() >= maxEntries)
+		cache.entries.clear();
+	// Concurrent searches for the same key produce the same entry, so keeping the first is fine.
+	cache.entries.try_emplace(std::move(_key), std::move(_entry));
+}
+
+void ConstantRepresentationCache::clear()
+{
+	Memo& cache = memo();
+	std::unique_lock<std::shared_mutex> lock(cache.mutex);
+	cache.entries.clear();
+}
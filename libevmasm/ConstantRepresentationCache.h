@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Process-wide memo of the representations the constant optimisers chose for constants.
+ */
+
+#pragma once
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <optional>
+#include <vector>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Memo of the cheapest representation found for a constant, shared between assemblies,
+ * compilations and threads.
+ *
+ * Searching for a representation is a pure function of the constant and the parameters of
+ * the cost model, so masks, selectors and other constants that appear in many contracts only
+ * have to be searched once per process. Both the evmasm and the Yul constant optimiser store
+ * their results here, distinguished by @a Key::costModel.
+ * The memo is bounded and starts over once it is full.
+ */
+class ConstantRepresentationCache
+{
+public:
+	enum class CostModel { Assembly, Yul };
+	enum class Method { Literal, CodeCopy, Compute };
+
+	struct Key
+	{
+		CostModel costModel;
+		u256 value;
+		langutil::EVMVersion evmVersion;
+		bool isCreation;
+		bigint runs;
+		/// Number of occurrences of the constant; only part of the assembly cost model.
+		size_t multiplicity = 0;
+
+		bool operator<(Key const& _other) const;
+	};
+
+	struct Entry
+	{
+		Method method;
+		/// Items computing the constant if @a method is Compute, in execution order.
+		/// They do not carry any debug data.
+		/// For the Yul cost model, parts that are representations of other constants are not
+		/// expanded but pushed as the constant, since the Yul search reuses their representations.
+		AssemblyItems routine;
+		/// The following are only used by the Yul cost model.
+		/// Cost of the representation.
+		bigint cost = 0;
+		/// Constants the search looked up while searching this one, in order.
+		std::vector<u256> searchedConstants = {};
+		/// Upper bound on the steps a search from scratch takes.
+		size_t searchSteps = 0;
+	};
+
+	/// @returns the memoised representation for @a _key, if any.
+	static std::optional<Entry> find(Key const& _key);
+	/// Memoises @a _entry as the representation for @a _key.
+	static void store(Key _key, Entry _entry);
+	/// Removes all entries.
+	static void clear();
+
+	static size_t constexpr maxEntries = 0x10000;
+};
+
+}
@@ -690,68 +690,150 @@ struct DeduplicateNextTagSize1 : SimplePeepholeOptimizerMethod<DeduplicateNextTa
 	}
 };
 
-void applyMethods(OptimiserState&)
+bool applyMethods(OptimiserState&)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
+/// Applies the first of the given methods that matches at the current position.
+/// @returns false if none of them matched.
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+bool applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return Method::apply(_state) || applyMethods(_state, _other...);
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+/// The maximum number of items, starting at the current position, that a rule examines when it does not apply.
+/// A rule can thus only start to apply at a position if one of the items in this window has changed.
+size_t constexpr maxWindowSize = 8;
+
+/// Quantities of a sequence of items that determine whether the optimised sequence is better.
+struct CodeMetrics
 {
-	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
-}
+	size_t items = 0;
+	size_t bytes = 0;
+	size_t pops = 0;
+
+	void add(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end, langutil::EVMVersion _evmVersion)
+	{
+		// Avoid referencing immutables too early by using approx. counting in bytesRequired()
+		for (auto it = _begin; it != _end; ++it)
+		{
+			++items;
+			bytes += it->bytesRequired(3, _evmVersion, evmasm::Precision::Approximate);
+			if (*it == Instruction::POP)
+				++pops;
+		}
+	}
+};
 
 }
 
 bool PeepholeOptimiser::optimise()
 {
-	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
-	auto const approx = evmasm::Precision::Approximate;
-	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems), m_evmVersion};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(),
-			OpPop(),
-			OpStop(),
-			OpReturnRevert(),
-			DoublePush(),
-			DoubleSwap(),
-			CommutativeSwap(),
-			SwapComparison(),
-			DupSwap(),
-			IsZeroIsZeroJumpI(),
-			IsZeroIsZeroRJumpI(), // EOF specific
-			EqIsZeroJumpI(),
-			EqIsZeroRJumpI(),     // EOF specific
-			DoubleJump(),
-			DoubleRJump(),        // EOF specific
-			JumpToNext(),
-			RJumpToNext(),        // EOF specific
-			UnreachableCode(),
-			DeduplicateNextTagSize3(),
-			DeduplicateNextTagSize2(),
-			DeduplicateNextTagSize1(),
-			TagConjunctions(),
-			TruthyAnd(),
-			Identity()
+	// Consecutive positions examined by this round. All other items are kept as they are.
+	struct Region
+	{
+		Range input;
+		/// End of the items produced for this region in optimisedItems. It begins where the previous region ends.
+		size_t outputEnd;
+	};
+	std::vector<Region> regions;
+	AssemblyItems optimisedItems;
+	std::vector<Range> rewrittenRanges;
+	/// Number of items before the current position that are kept because they are not examined.
+	size_t unexaminedItems = 0;
+
+	OptimiserState state {m_items, 0, back_inserter(optimisedItems), m_evmVersion};
+	for (Range const& changed: m_rewrittenRanges.value_or(std::vector<Range>{{0, m_items.size()}}))
+	{
+		if (state.i >= changed.end && !regions.empty())
+			continue;
+		size_t begin = std::max(state.i, changed.begin > maxWindowSize ? changed.begin - maxWindowSize : 0);
+		if (regions.empty() || begin > state.i)
+		{
+			unexaminedItems += begin - state.i;
+			regions.push_back({{begin, begin}, optimisedItems.size()});
+			state.i = begin;
+		}
+		while (state.i < changed.end)
+		{
+			size_t rewriteBegin = optimisedItems.size();
+			if (applyMethods(
+				state,
+				PushPop(),
+				OpPop(),
+				OpStop(),
+				OpReturnRevert(),
+				DoublePush(),
+				DoubleSwap(),
+				CommutativeSwap(),
+				SwapComparison(),
+				DupSwap(),
+				IsZeroIsZeroJumpI(),
+				IsZeroIsZeroRJumpI(), // EOF specific
+				EqIsZeroJumpI(),
+				EqIsZeroRJumpI(),     // EOF specific
+				DoubleJump(),
+				DoubleRJump(),        // EOF specific
+				JumpToNext(),
+				RJumpToNext(),        // EOF specific
+				UnreachableCode(),
+				DeduplicateNextTagSize3(),
+				DeduplicateNextTagSize2(),
+				DeduplicateNextTagSize1(),
+				TagConjunctions(),
+				TruthyAnd()
+			))
+				rewrittenRanges.push_back({unexaminedItems + rewriteBegin, unexaminedItems + optimisedItems.size()});
+			else
+				assertThrow(Identity::apply(state), OptimizerException, "Peephole optimizer failed to apply identity.");
+		}
+		regions.back().input.end = state.i;
+		regions.back().outputEnd = optimisedItems.size();
+	}
+
+	// Items outside of the regions are the same before and after, so it suffices to compare the regions.
+	CodeMetrics before;
+	for (Region const& region: regions)
+		before.add(
+			m_items.begin() + static_cast<ptrdiff_t>(region.input.begin),
+			m_items.begin() + static_cast<ptrdiff_t>(region.input.end),
+			m_evmVersion
 		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			evmasm::bytesRequired(m_optimisedItems, 3, m_evmVersion, approx) < evmasm::bytesRequired(m_items, 3, m_evmVersion, approx) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
+	CodeMetrics after;
+	after.add(optimisedItems.begin(), optimisedItems.end(), m_evmVersion);
+
+	if (!(after.items < before.items || (
+		after.items == before.items && (
+			after.bytes < before.bytes ||
+			after.pops > before.pops
 		)
-	))
+	)))
+		return false;
+
+	AssemblyItems items;
+	items.reserve(m_items.size() - before.items + after.items);
+	size_t inputPosition = 0;
+	size_t outputPosition = 0;
+	for (Region const& region: regions)
 	{
-		m_items = std::move(m_optimisedItems);
-		return true;
+		std::move(
+			m_items.begin() + static_cast<ptrdiff_t>(inputPosition),
+			m_items.begin() + static_cast<ptrdiff_t>(region.input.begin),
+			std::back_inserter(items)
+		);
+		std::move(
+			optimisedItems.begin() + static_cast<ptrdiff_t>(outputPosition),
+			optimisedItems.begin() + static_cast<ptrdiff_t>(region.outputEnd),
+			std::back_inserter(items)
+		);
+		inputPosition = region.input.end;
+		outputPosition = region.outputEnd;
 	}
-	else
-		return false;
+	std::move(m_items.begin() + static_cast<ptrdiff_t>(inputPosition), m_items.end(), std::back_inserter(items));
+
+	m_items = std::move(items);
+	m_rewrittenRanges = std::move(rewrittenRanges);
+	return true;
 }
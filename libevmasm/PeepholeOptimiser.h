@@ -24,6 +24,7 @@
 #include <vector>
 #include <cstddef>
 #include <iterator>
+#include <optional>
 
 #include <liblangutil/EVMVersion.h>
 
@@ -50,12 +51,26 @@ public:
 	}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Performs one round of peephole optimisation and keeps its result only if it improves the code.
+	/// @returns true if the items were changed.
+	/// The first round examines all items. Later rounds only re-examine the items around the places
+	/// rewritten by the previous round, since the rules did not apply anywhere else and their input
+	/// there is unchanged. The result is the same as if every round examined all items.
 	bool optimise();
 
 private:
+	/// Range [begin, end) of positions in m_items.
+	struct Range
+	{
+		size_t begin;
+		size_t end;
+	};
+
 	AssemblyItems& m_items;
-	AssemblyItems m_optimisedItems;
 	langutil::EVMVersion const m_evmVersion;
+	/// Sorted ranges of m_items that were produced by rewrites in the previous round.
+	/// Ranges can be empty if a rewrite only removed items. Not set before the first round.
+	std::optional<std::vector<Range>> m_rewrittenRanges;
 };
 
 }
@@ -50,9 +50,12 @@
 
 #pragma once
 
+#include <libsolutil/SharedText.h>
+
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -71,10 +74,11 @@ class CharStream
 {
 public:
 	CharStream() = default;
-	CharStream(std::string _source, std::string _name):
-		m_source(std::move(_source)), m_name(std::move(_name)) {}
-	CharStream(std::string _source, std::string _name, bool _importedFromAST):
-		m_source(std::move(_source)),
+	CharStream(util::SharedText _source, std::string _name):
+		m_text(std::move(_source)), m_source(m_text.view()), m_name(std::move(_name)) {}
+	CharStream(util::SharedText _source, std::string _name, bool _importedFromAST):
+		m_text(std::move(_source)),
+		m_source(m_text.view()),
 		m_name(std::move(_name)),
 		m_importedFromAST(_importedFromAST)
 	{ }
@@ -83,7 +87,9 @@ public:
 	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
 	bool isImportedFromAST() const { return m_importedFromAST; }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	/// @returns the character @a _charsForward characters ahead. Reading one character past the
+	/// end of input returns 0 (see @a util::SharedText), anything further is not allowed.
+	char get(size_t _charsForward = 0) const { return m_source.data()[m_position + _charsForward]; }
 	char advanceAndGet(size_t _chars = 1);
 	/// Sets scanner position to @ _amount characters backwards in source text.
 	/// @returns The character of the current location after update is returned.
@@ -95,7 +101,7 @@ public:
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	std::string_view source() const noexcept { return m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
 	size_t size() const { return m_source.size(); }
@@ -112,7 +118,7 @@ public:
 	std::optional<int> translateLineColumnToPosition(LineColumn const& _lineColumn) const;
 
 	/// Translates a line:column to the absolute position for the given input text.
-	static std::optional<int> translateLineColumnToPosition(std::string const& _text, LineColumn const& _input);
+	static std::optional<int> translateLineColumnToPosition(std::string_view _text, LineColumn const& _input);
 
 	/// Tests whether or not given octet sequence is present at the current position in stream.
 	/// @returns true if the sequence could be found, false otherwise.
@@ -139,10 +145,12 @@ public:
 		return singleLineSnippet(m_source, _location);
 	}
 
-	static std::string singleLineSnippet(std::string const& _sourceCode, SourceLocation const& _location);
+	static std::string singleLineSnippet(std::string_view _sourceCode, SourceLocation const& _location);
 
 private:
-	std::string m_source;
+	/// Owns the characters, which may be shared with other streams and with the caller.
+	util::SharedText m_text;
+	std::string_view m_source = "";
 	std::string m_name;
 	bool m_importedFromAST{false};
 	size_t m_position{0};
@@ -0,0 +1,194 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <liblangutil/CharacterScan.h>
+
+#include <liblangutil/Common.h>
+#include <liblangutil/Exceptions.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOL_CHARACTER_SCAN_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+using namespace solidity;
+using namespace solidity::langutil;
+
+namespace
+{
+
+#if SOL_CHARACTER_SCAN_SSE2
+
+size_t constexpr c_chunkSize = sizeof(__m128i);
+
+/// @returns the index of the lowest set bit of the non-zero @a _mask.
+size_t lowestSetBit(unsigned _mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index = 0;
+	_BitScanForward(&index, _mask);
+	return index;
+#else
+	return static_cast<size_t>(__builtin_ctz(_mask));
+#endif
+}
+
+__m128i equals(__m128i _chunk, char _character)
+{
+	return _mm_cmpeq_epi8(_chunk, _mm_set1_epi8(_character));
+}
+
+/// Marks the bytes between @a _first and @a _last, which both have to be ASCII.
+/// Bytes above 0x7f are negative in the signed comparisons and therefore never match.
+__m128i inRange(__m128i _chunk, char _first, char _last)
+{
+	return _mm_and_si128(
+		_mm_cmpgt_epi8(_chunk, _mm_set1_epi8(static_cast<char>(_first - 1))),
+		_mm_cmplt_epi8(_chunk, _mm_set1_epi8(static_cast<char>(_last + 1)))
+	);
+}
+
+/// Maps upper case ASCII letters to lower case ones and no other byte to a letter.
+__m128i toLowerCase(__m128i _chunk)
+{
+	return _mm_or_si128(_chunk, _mm_set1_epi8(0x20));
+}
+
+__m128i negate(__m128i _mask)
+{
+	return _mm_xor_si128(_mask, _mm_set1_epi8(-1));
+}
+
+#endif
+
+/// @returns the position of the first character at or after @a _position for which
+/// @a _matches is true. @a _vectorMatches has to mark exactly the same characters
+/// in a chunk of 16 of them.
+template <typename VectorPredicate, typename Predicate>
+size_t findFirst(
+	std::string_view _text,
+	size_t _position,
+	[[maybe_unused]] VectorPredicate _vectorMatches,
+	Predicate _matches
+)
+{
+	solAssert(_position <= _text.size());
+#if SOL_CHARACTER_SCAN_SSE2
+	for (; _text.size() - _position >= c_chunkSize; _position += c_chunkSize)
+	{
+		__m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_text.data() + _position));
+		if (unsigned const mask = static_cast<unsigned>(_mm_movemask_epi8(_vectorMatches(chunk))))
+			return _position + lowestSetBit(mask);
+	}
+#endif
+	while (_position < _text.size() && !_matches(_text[_position]))
+		++_position;
+	return _position;
+}
+
+#if SOL_CHARACTER_SCAN_SSE2
+#define SOL_VECTOR_PREDICATE(_body) [](__m128i _chunk) { return _body; }
+#else
+#define SOL_VECTOR_PREDICATE(_body) nullptr
+#endif
+
+}
+
+size_t solidity::langutil::skipWhiteSpace(std::string_view _text, size_t _position)
+{
+	return findFirst(
+		_text,
+		_position,
+		SOL_VECTOR_PREDICATE(negate(_mm_or_si128(
+			_mm_or_si128(equals(_chunk, ' '), equals(_chunk, '\n')),
+			_mm_or_si128(equals(_chunk, '\t'), equals(_chunk, '\r'))
+		))),
+		[](char _c) { return !isWhiteSpace(_c); }
+	);
+}
+
+size_t solidity::langutil::skipIdentifierParts(std::string_view _text, size_t _position)
+{
+	return findFirst(
+		_text,
+		_position,
+		SOL_VECTOR_PREDICATE(negate(_mm_or_si128(
+			_mm_or_si128(inRange(toLowerCase(_chunk), 'a', 'z'), inRange(_chunk, '0', '9')),
+			_mm_or_si128(equals(_chunk, '_'), equals(_chunk, '$'))
+		))),
+		[](char _c) { return !isIdentifierPart(_c); }
+	);
+}
+
+size_t solidity::langutil::skipHexDigits(std::string_view _text, size_t _position)
+{
+	return findFirst(
+		_text,
+		_position,
+		SOL_VECTOR_PREDICATE(negate(_mm_or_si128(
+			inRange(_chunk, '0', '9'),
+			inRange(toLowerCase(_chunk), 'a', 'f')
+		))),
+		[](char _c) { return !isHexDigit(_c); }
+	);
+}
+
+size_t solidity::langutil::skipPlainStringCharacters(std::string_view _text, size_t _position)
+{
+	return findFirst(
+		_text,
+		_position,
+		SOL_VECTOR_PREDICATE(_mm_or_si128(
+			negate(inRange(_chunk, 0x20, 0x7e)),
+			_mm_or_si128(
+				_mm_or_si128(equals(_chunk, '"'), equals(_chunk, '\'')),
+				equals(_chunk, '\\')
+			)
+		)),
+		[](char _c) { return _c < 0x20 || _c > 0x7e || _c == '"' || _c == '\'' || _c == '\\'; }
+	);
+}
+
+size_t solidity::langutil::findLineTerminatorCandidate(std::string_view _text, size_t _position)
+{
+	return findFirst(
+		_text,
+		_position,
+		SOL_VECTOR_PREDICATE(_mm_or_si128(
+			inRange(_chunk, 0x0a, 0x0d),
+			_mm_or_si128(equals(_chunk, '\xc2'), equals(_chunk, '\xe2'))
+		)),
+		[](char _c) { return (0x0a <= _c && _c <= 0x0d) || _c == '\xc2' || _c == '\xe2'; }
+	);
+}
+
+size_t solidity::langutil::findMultiLineCommentSpecial(std::string_view _text, size_t _position)
+{
+	return findFirst(
+		_text,
+		_position,
+		SOL_VECTOR_PREDICATE(_mm_or_si128(
+			_mm_or_si128(equals(_chunk, '\n'), equals(_chunk, '\r')),
+			equals(_chunk, '*')
+		)),
+		[](char _c) { return _c == '\n' || _c == '\r' || _c == '*'; }
+	);
+}
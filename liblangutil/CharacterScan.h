@@ -0,0 +1,54 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Routines that find the end of runs of characters of the same class in source text.
+ * They let the scanner consume long comments, identifiers and literals at once instead
+ * of character by character and use SSE2 where it is available.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace solidity::langutil
+{
+
+/// All functions below start at @a _position, which must not exceed the size of @a _text,
+/// and return the size of @a _text if the run extends up to the end of the text.
+
+/// @returns the position of the first character that is not whitespace (see @a isWhiteSpace()).
+size_t skipWhiteSpace(std::string_view _text, size_t _position);
+/// @returns the position of the first character that cannot be part of an identifier
+/// (see @a isIdentifierPart()).
+size_t skipIdentifierParts(std::string_view _text, size_t _position);
+/// @returns the position of the first character that is not a hexadecimal digit.
+size_t skipHexDigits(std::string_view _text, size_t _position);
+/// @returns the position of the first character that is not printable ASCII or that is a quote
+/// or a backslash, i.e. the first character that needs attention inside a string literal.
+size_t skipPlainStringCharacters(std::string_view _text, size_t _position);
+
+/// @returns the position of the first character that may start a line terminator: one of the
+/// ASCII characters LF, VT, FF, CR or the first byte of the UTF-8 encoding of NEL, LS or PS.
+/// The encodings are not verified.
+size_t findLineTerminatorCandidate(std::string_view _text, size_t _position);
+/// @returns the position of the first LF, CR or '*', i.e. the first character that needs
+/// attention inside a multi-line comment.
+size_t findMultiLineCommentSpecial(std::string_view _text, size_t _position);
+
+}
@@ -50,6 +50,7 @@
  * Solidity scanner.
  */
 
+#include <liblangutil/CharacterScan.h>
 #include <liblangutil/Common.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/Scanner.h>
@@ -208,6 +209,18 @@ void Scanner::addUnicodeAsUTF8(unsigned codepoint)
 	}
 }
 
+void Scanner::addLiteralRun(size_t _end)
+{
+	m_tokens[NextNext].literal += m_source.source().substr(sourcePos(), _end - sourcePos());
+	m_char = m_source.setPosition(_end);
+}
+
+void Scanner::addCommentLiteralRun(size_t _end)
+{
+	m_skippedComments[NextNext].literal += m_source.source().substr(sourcePos(), _end - sourcePos());
+	m_char = m_source.setPosition(_end);
+}
+
 void Scanner::rescan()
 {
 	size_t rollbackTo = 0;
@@ -247,11 +260,12 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 
 bool Scanner::skipWhitespace()
 {
-	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
-	// Return whether or not we skipped any characters.
-	return sourcePos() != startPosition;
+	// The current character does not have to match the source, e.g. after a multi-line comment.
+	if (!isWhiteSpace(m_char))
+		return false;
+	advance();
+	m_char = m_source.setPosition(langutil::skipWhiteSpace(m_source.source(), sourcePos()));
+	return true;
 }
 
 bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
@@ -283,11 +297,16 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 	};
 
 	size_t endPosition = _stream.position();
-	_stream.setPosition(_startPosition);
+	std::string_view const text = _stream.source().substr(0, endPosition);
 
 	int directionOverrideDepth = 0;
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	// All sequences start with the same byte, which is rare enough to look only at its occurrences.
+	for (
+		size_t currentPos = text.find('\xE2', _startPosition);
+		currentPos != std::string_view::npos;
+		currentPos = text.find('\xE2', currentPos + 1)
+	)
 	{
 		_stream.setPosition(currentPos);
 
@@ -311,9 +330,9 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
-			break;
+	m_char = m_source.setPosition(findLineTerminatorCandidate(m_source.source(), startPosition));
+	while (!isSourcePastEndOfInput() && !isUnicodeLinebreak())
+		m_char = m_source.setPosition(findLineTerminatorCandidate(m_source.source(), sourcePos() + 1));
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -381,8 +400,7 @@ size_t Scanner::scanSingleLineDocComment()
 			// Any line terminator that is not '\n' is considered to end the
 			// comment.
 			break;
-		addCommentLiteralChar(m_char);
-		advance();
+		addCommentLiteralRun(findLineTerminatorCandidate(m_source.source(), sourcePos() + 1));
 	}
 	literal.complete();
 	return endPosition;
@@ -391,26 +409,24 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source.position();
-	while (!isSourcePastEndOfInput())
+	size_t const endPosition = m_source.source().find("*/", startPosition);
+	if (endPosition == std::string_view::npos)
 	{
-		char prevChar = m_char;
-		advance();
+		// Unterminated multi-line comment.
+		m_char = m_source.setPosition(m_source.size());
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+	// We have reached the end of the multi-line comment, we consume
+	// the '/' and insert a whitespace. This way all multi-line
+	// comments are treated as whitespace.
+	m_char = m_source.setPosition(endPosition + 1);
+	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+		return setError(unicodeDirectionError);
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
-	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -457,9 +473,10 @@ Token Scanner::scanMultiLineDocComment()
 			endFound = true;
 			break;
 		}
-		addCommentLiteralChar(m_char);
+		if (isSourcePastEndOfInput()) // only whitespace after the last line break
+			break;
+		addCommentLiteralRun(findMultiLineCommentSpecial(m_source.source(), sourcePos() + 1));
 		charsAdded = true;
-		advance();
 	}
 	literal.complete();
 	if (!endFound)
@@ -829,6 +846,13 @@ Token Scanner::scanString(bool const _isUnicode)
 	// for source location comments we allow multiline string literals
 	while (m_char != quote && !isSourcePastEndOfInput() && (!isUnicodeLinebreak() || m_kind == ScannerKind::SpecialComment))
 	{
+		// Printable ASCII characters other than quotes and backslashes are taken as they are.
+		if (size_t const plainEnd = skipPlainStringCharacters(m_source.source(), sourcePos()); plainEnd != sourcePos())
+		{
+			addLiteralRun(plainEnd);
+			continue;
+		}
+
 		char c = m_char;
 		advance();
 
@@ -892,6 +916,18 @@ Token Scanner::scanHexString()
 	bool allowUnderscore = false;
 	while (m_char != quote && !isSourcePastEndOfInput())
 	{
+		// Decode all complete pairs of hex digits up to the next underscore or quote at once.
+		size_t const position = sourcePos();
+		if (size_t const digits = (skipHexDigits(m_source.source(), position) - position) & ~size_t(1))
+		{
+			std::string_view const pairs = m_source.source().substr(position, digits);
+			for (size_t i = 0; i < digits; i += 2)
+				addLiteralChar(static_cast<char>(hexValue(pairs[i]) * 16 + hexValue(pairs[i + 1])));
+			m_char = m_source.setPosition(position + digits);
+			allowUnderscore = true;
+			continue;
+		}
+
 		char c = m_char;
 
 		if (scanHexByte(c))
@@ -1033,8 +1069,12 @@ std::tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	addLiteralCharAndAdvance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
+	addLiteralRun(skipIdentifierParts(m_source.source(), sourcePos()));
+	while (m_char == '.' && m_kind == ScannerKind::Yul)
+	{
 		addLiteralCharAndAdvance();
+		addLiteralRun(skipIdentifierParts(m_source.source(), sourcePos()));
+	}
 	literal.complete();
 
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
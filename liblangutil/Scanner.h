@@ -199,6 +199,9 @@ private:
 	inline void addLiteralChar(char c) { m_tokens[NextNext].literal.push_back(c); }
 	inline void addCommentLiteralChar(char c) { m_skippedComments[NextNext].literal.push_back(c); }
 	inline void addLiteralCharAndAdvance() { addLiteralChar(m_char); advance(); }
+	/// Adds the source characters from the current position up to @a _end and advances to @a _end.
+	void addLiteralRun(size_t _end);
+	void addCommentLiteralRun(size_t _end);
 	void addUnicodeAsUTF8(unsigned codepoint);
 	///@}
 
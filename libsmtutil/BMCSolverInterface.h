@@ -44,6 +44,12 @@ public:
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
+	/// @returns true if check() can run on another thread, concurrently with the checks of other solvers.
+	virtual bool supportsConcurrentCheck() const { return false; }
+	/// Makes a call to check() running on another thread return without an answer as soon as
+	/// possible, as well as the calls made while @a _interrupted is true.
+	virtual void setInterrupted(bool /*_interrupted*/) {}
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
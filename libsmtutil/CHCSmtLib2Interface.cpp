@@ -95,30 +95,57 @@ CHCSolverInterface::QueryResult CHCSmtLib2Interface::query(Expression const& _bl
 	std::string query = dumpQuery(_block);
 	try
 	{
-		std::string response = querySolver(query);
+		return interpretResponses(solve(query));
+	}
+	catch(smtutil::SMTSolverInteractionError const&)
+	{
+		return {CheckResult::ERROR, Expression(true), {}};
+	}
+}
 
-		CheckResult result;
-		// NOTE: Our internal semantics is UNSAT -> SAFE and SAT -> UNSAFE, which corresponds to usual SMT-based model checking
-		// However, with CHC solvers, the meaning is flipped, UNSAT -> UNSAFE and SAT -> SAFE.
-		// So we have to flip the answer.
-		if (boost::starts_with(response, "sat"))
-		{
-			auto maybeInvariants = invariantsFromSolverResponse(response);
-			return {CheckResult::UNSATISFIABLE, maybeInvariants.value_or(Expression(true)), {}};
-		}
-		else if (boost::starts_with(response, "unsat"))
-			result = CheckResult::SATISFIABLE;
-		else if (boost::starts_with(response, "unknown"))
-			result = CheckResult::UNKNOWN;
-		else
-			result = CheckResult::ERROR;
-		return {result, Expression(true), {}};
+std::vector<std::string> CHCSmtLib2Interface::solveConcurrently(std::string const& /*_query*/) const
+{
+	smtAssert(false, "Concurrent queries are not supported by this solver interface.");
+}
+
+CHCSolverInterface::QueryResult CHCSmtLib2Interface::resultFromResponses(std::vector<std::string> const& _responses) const
+{
+	try
+	{
+		return interpretResponses(_responses);
 	}
 	catch(smtutil::SMTSolverInteractionError const&)
 	{
 		return {CheckResult::ERROR, Expression(true), {}};
 	}
+}
 
+std::vector<std::string> CHCSmtLib2Interface::solve(std::string const& _query)
+{
+	return {querySolver(_query)};
+}
+
+CHCSolverInterface::QueryResult CHCSmtLib2Interface::interpretResponses(std::vector<std::string> const& _responses) const
+{
+	smtAssert(_responses.size() == 1);
+	std::string const& response = _responses.front();
+
+	CheckResult result;
+	// NOTE: Our internal semantics is UNSAT -> SAFE and SAT -> UNSAFE, which corresponds to usual SMT-based model checking
+	// However, with CHC solvers, the meaning is flipped, UNSAT -> UNSAFE and SAT -> SAFE.
+	// So we have to flip the answer.
+	if (boost::starts_with(response, "sat"))
+	{
+		auto maybeInvariants = invariantsFromSolverResponse(response);
+		return {CheckResult::UNSATISFIABLE, maybeInvariants.value_or(Expression(true)), {}};
+	}
+	else if (boost::starts_with(response, "unsat"))
+		result = CheckResult::SATISFIABLE;
+	else if (boost::starts_with(response, "unknown"))
+		result = CheckResult::UNKNOWN;
+	else
+		result = CheckResult::ERROR;
+	return {result, Expression(true), {}};
 }
 
 void CHCSmtLib2Interface::declareVariable(std::string const& _name, SortPointer const& _sort)
@@ -180,7 +207,7 @@ std::string CHCSmtLib2Interface::querySolver(std::string const& _input)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
-			return result.responseOrErrorMessage;
+			return result.responseOrErrorMessage.str();
 	}
 
 	m_unhandledQueries.push_back(_input);
@@ -53,6 +53,18 @@ public:
 
 	std::string dumpQuery(Expression const& _expr);
 
+	/// @returns true if @a solveConcurrently() can be used.
+	virtual bool supportsConcurrentQueries() const { return false; }
+
+	/// Sends @a _query, which was returned by @a dumpQuery(), to the solver and @returns its
+	/// responses, to be passed to @a resultFromResponses().
+	/// Can be called from several threads at the same time as long as the interface is not
+	/// modified meanwhile. Throws SMTSolverInteractionError if the solver could not be run.
+	virtual std::vector<std::string> solveConcurrently(std::string const& _query) const;
+
+	/// @returns the result of a query from the responses of the solver to it.
+	QueryResult resultFromResponses(std::vector<std::string> const& _responses) const;
+
 	std::vector<std::string> unhandledQueries() const { return m_unhandledQueries; }
 
 protected:
@@ -94,6 +106,13 @@ protected:
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
 	virtual std::string querySolver(std::string const& _input);
 
+	/// Sends @a _query to the solver via @a querySolver() and @returns its responses.
+	virtual std::vector<std::string> solve(std::string const& _query);
+
+	/// Translates the responses to a query to a @a QueryResult.
+	/// Throws SMTSolverInteractionError if they cannot be interpreted.
+	virtual QueryResult interpretResponses(std::vector<std::string> const& _responses) const;
+
 	/// Translates CHC solver response with a model to our representation of invariants. Returns None on error.
 	std::optional<smtutil::Expression> invariantsFromSolverResponse(std::string const& _response) const;
 
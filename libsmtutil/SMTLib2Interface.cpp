@@ -222,7 +222,7 @@ std::string SMTLib2Interface::querySolver(std::string const& _input)
 		setupSmtCallback();
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
-			return result.responseOrErrorMessage;
+			return result.responseOrErrorMessage.str();
 	}
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
@@ -20,6 +20,11 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
@@ -27,10 +32,18 @@ using namespace solidity::smtutil;
 
 SMTPortfolio::SMTPortfolio(
 	std::vector<std::unique_ptr<BMCSolverInterface>> _solvers,
-	std::optional<unsigned> _queryTimeout
+	std::optional<unsigned> _queryTimeout,
+	bool _crossCheck
 ):
-	BMCSolverInterface(_queryTimeout), m_solvers(std::move(_solvers))
-{}
+	BMCSolverInterface(_queryTimeout), m_solvers(std::move(_solvers)), m_crossCheck(_crossCheck)
+{
+	size_t concurrentSolvers = 0;
+	for (auto const& s: m_solvers)
+		if (s->supportsConcurrentCheck())
+			++concurrentSolvers;
+	if (m_solvers.size() > 1 && concurrentSolvers > 0)
+		m_threadPool = std::make_unique<ThreadPool>(concurrentSolvers);
+}
 
 
 void SMTPortfolio::reset()
@@ -75,10 +88,18 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  * A solver did not answer the query if it returns either:
  *   UNKNOWN (it tried but couldn't solve it) or ERROR (crash, internal error, API error, etc).
  *
- * Ideally all solvers answer the query and agree on what the answer is
- * (all say SAT or all say UNSAT).
+ * The solvers that support it are queried concurrently on the thread pool, the others one after
+ * the other on the calling thread.
  *
- * The actual logic as as follows:
+ * Unless cross-checking, the result is the answer of the first solver in the order of the solvers
+ * that answers. As soon as it is known, i.e. once a solver answered and all the solvers before it
+ * finished, the other solvers are interrupted. This keeps the result (including the model)
+ * independent of which solver happens to answer first.
+ *
+ * When cross-checking, all solvers are queried and ideally they all answer the query and agree on
+ * what the answer is (all say SAT or all say UNSAT).
+ *
+ * The actual logic as as follows, looking at the results in the order of the solvers:
  * 1) If at least one solver answers the query, all the non-answer results are ignored.
  *   Here SAT/UNSAT is preferred over UNKNOWN since it's an actual answer, and over ERROR
  *   because one buggy solver/integration shouldn't break the portfolio.
@@ -93,16 +114,109 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * An exception thrown by a solver is rethrown unless a solver before it answered or, when
+ * cross-checking, the answers of the solvers before it already conflict.
 */
 std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
+	std::vector<std::pair<CheckResult, std::vector<std::string>>> results(m_solvers.size(), {CheckResult::ERROR, {}});
+	std::vector<std::exception_ptr> exceptions(m_solvers.size());
+	std::vector<bool> finished(m_solvers.size(), false);
+	size_t runningSolvers = 0;
+	std::mutex mutex;
+	std::condition_variable solverFinished;
+
+	// The solvers after a solver that answered or threw do not affect the result unless cross-checking.
+	auto const decisive = [&](size_t _index) {
+		return finished[_index] && (exceptions[_index] || solverAnswered(results[_index].first));
+	};
+	auto const decisiveBefore = [&](size_t _end) {
+		for (size_t i = 0; i < _end; ++i)
+			if (decisive(i))
+				return true;
+		return false;
+	};
+	auto const resultKnown = [&]() {
+		for (size_t i = 0; i < m_solvers.size(); ++i)
+			if (!finished[i])
+				return false;
+			else if (decisive(i))
+				return true;
+		return true;
+	};
+
+	auto const runSolver = [&](size_t _index, bool _concurrently) {
+		std::pair<CheckResult, std::vector<std::string>> result{CheckResult::ERROR, {}};
+		std::exception_ptr exception;
+		try
+		{
+			result = m_solvers[_index]->check(_expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			exception = std::current_exception();
+		}
+		{
+			std::lock_guard lock(mutex);
+			results[_index] = std::move(result);
+			exceptions[_index] = exception;
+			finished[_index] = true;
+			if (_concurrently)
+				--runningSolvers;
+		}
+		solverFinished.notify_all();
+	};
+
+	std::vector<std::future<void>> concurrentChecks;
+	if (m_threadPool)
+		for (size_t i = 0; i < m_solvers.size(); ++i)
+			if (m_solvers[i]->supportsConcurrentCheck())
+			{
+				std::lock_guard lock(mutex);
+				++runningSolvers;
+				concurrentChecks.emplace_back(m_threadPool->submit([&, i]() { runSolver(i, true); }));
+			}
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		if (!m_threadPool || !m_solvers[i]->supportsConcurrentCheck())
+		{
+			{
+				std::lock_guard lock(mutex);
+				if (!m_crossCheck && decisiveBefore(i))
+					break;
+			}
+			runSolver(i, false);
+		}
+
+	if (!concurrentChecks.empty())
+	{
+		bool interrupt = false;
+		{
+			std::unique_lock lock(mutex);
+			solverFinished.wait(lock, [&]() { return runningSolvers == 0 || (!m_crossCheck && resultKnown()); });
+			interrupt = runningSolvers > 0;
+		}
+		if (interrupt)
+			for (auto const& s: m_solvers)
+				if (s->supportsConcurrentCheck())
+					s->setInterrupted(true);
+		for (auto& check: concurrentChecks)
+			check.get();
+		if (interrupt)
+			for (auto const& s: m_solvers)
+				if (s->supportsConcurrentCheck())
+					s->setInterrupted(false);
+	}
+
 	CheckResult lastResult = CheckResult::ERROR;
 	std::vector<std::string> finalValues;
-	for (auto const& s: m_solvers)
+	for (size_t i = 0; i < m_solvers.size(); ++i)
 	{
-		CheckResult result;
-		std::vector<std::string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
+		if (exceptions[i])
+			std::rethrow_exception(exceptions[i]);
+		auto& [result, values] = results[i];
+		if (!m_crossCheck && solverAnswered(result))
+			return std::move(results[i]);
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
@@ -22,8 +22,10 @@
 #include <libsmtutil/BMCSolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
@@ -32,8 +34,9 @@ namespace solidity::smtutil
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
- * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ * Queries are sent to the solvers concurrently where they support it. By default, the first
+ * answer is used and the other solvers are interrupted. When cross-checking, all solvers are
+ * queried and it is checked whether they give conflicting answers.
  */
 class SMTPortfolio: public BMCSolverInterface
 {
@@ -42,7 +45,11 @@ public:
 	SMTPortfolio(SMTPortfolio const&) = delete;
 	SMTPortfolio& operator=(SMTPortfolio const&) = delete;
 
-	SMTPortfolio(std::vector<std::unique_ptr<BMCSolverInterface>> solvers, std::optional<unsigned> _queryTimeout);
+	SMTPortfolio(
+		std::vector<std::unique_ptr<BMCSolverInterface>> solvers,
+		std::optional<unsigned> _queryTimeout,
+		bool _crossCheck
+	);
 
 	void reset() override;
 
@@ -64,6 +71,9 @@ private:
 	static bool solverAnswered(CheckResult result);
 
 	std::vector<std::unique_ptr<BMCSolverInterface>> m_solvers;
+	bool m_crossCheck = false;
+	/// Runs the checks of the solvers that support concurrent checks, if there is more than one solver.
+	std::unique_ptr<util::ThreadPool> m_threadPool;
 
 	std::vector<Expression> m_assertions;
 };
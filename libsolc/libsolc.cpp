@@ -28,6 +28,7 @@
 
 #include <cstdlib>
 #include <list>
+#include <mutex>
 #include <string>
 
 #include "license.h"
@@ -44,6 +45,8 @@ namespace
 // The std::strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static std::list<std::string> solidityAllocations;
+/// Guards solidityAllocations, since solidity_compile() can be called from multiple threads.
+static std::mutex solidityAllocationsMutex;
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -52,6 +55,7 @@ static std::list<std::string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 std::string takeOverAllocation(char const* _data)
 {
+	std::lock_guard<std::mutex> lock(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -82,23 +86,25 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 			char* error_c = nullptr;
 			_readCallback(_readContext, _kind.data(), _data.data(), &contents_c, &error_c);
 			ReadCallback::Result result;
+			std::string responseOrErrorMessage;
 			result.success = true;
 			if (!contents_c && !error_c)
 			{
 				result.success = false;
-				result.responseOrErrorMessage = "Callback not supported.";
+				responseOrErrorMessage = "Callback not supported.";
 			}
 			if (contents_c)
 			{
 				result.success = true;
-				result.responseOrErrorMessage = takeOverAllocation(contents_c);
+				responseOrErrorMessage = takeOverAllocation(contents_c);
 			}
 			if (error_c)
 			{
 				result.success = false;
-				result.responseOrErrorMessage = takeOverAllocation(error_c);
+				responseOrErrorMessage = takeOverAllocation(error_c);
 			}
-			truncateCString(result.responseOrErrorMessage);
+			truncateCString(responseOrErrorMessage);
+			result.responseOrErrorMessage = std::move(responseOrErrorMessage);
 			return result;
 		};
 	}
@@ -128,13 +134,16 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	std::string output = compile(_input, _readCallback, _readContext);
+	std::lock_guard<std::mutex> lock(solidityAllocationsMutex);
+	return solidityAllocations.emplace_back(std::move(output)).data();
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
+		std::lock_guard<std::mutex> lock(solidityAllocationsMutex);
 		return solidityAllocations.emplace_back(_size, '\0').data();
 	}
 	catch (...)
@@ -153,7 +162,8 @@ extern void solidity_reset() noexcept
 {
 	// This is called right before each compilation, but not at the end, so additional memory
 	// can be freed here.
-	yul::YulStringRepository::reset();
+	yul::YulStringRepository::resetIfUnused();
+	std::lock_guard<std::mutex> lock(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
 }
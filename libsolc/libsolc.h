@@ -88,6 +88,8 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
 ///
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
+///
+/// This function can be called concurrently from multiple threads.
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
 /// Frees up any allocated memory.
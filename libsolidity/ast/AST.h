@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/ast/ASTArena.h>
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/ast/ASTAnnotations.h>
@@ -40,6 +41,7 @@
 #include <range/v3/view/map.hpp>
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <utility>
@@ -127,20 +129,27 @@ public:
 	virtual bool experimentalSolidityOnly() const { return false; }
 
 protected:
-	size_t const m_id = 0;
+	/// Only changed by the parser when it adopts a source unit parsed by a different parser.
+	size_t m_id = 0;
 
+	/// Creates the annotation on first use. Code generation might request it from several threads at once.
 	template <class T>
 	T& initAnnotation() const
 	{
-		if (!m_annotation)
-			m_annotation = std::make_unique<T>();
+		std::call_once(m_annotationCreated, [&]() { m_annotation = ASTArena::makeUnique<T>(m_arena); });
 		return dynamic_cast<T&>(*m_annotation);
 	}
 
 private:
+	friend class ASTArena;
+	friend class Parser;
+
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
-	mutable std::unique_ptr<ASTAnnotation> m_annotation;
+	mutable ASTArena::UniquePtr<ASTAnnotation> m_annotation;
+	mutable std::once_flag m_annotationCreated;
 	SourceLocation m_location;
+	/// Arena the node was allocated in, if any. The annotation is allocated there as well.
+	ASTArena* m_arena = nullptr;
 };
 
 template <class T>
@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Bump allocator for the nodes and annotations of a source unit.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace solidity::frontend
+{
+
+/**
+ * Arena in which the parser allocates the nodes, names and annotations of one source unit.
+ *
+ * Objects in the arena are still destroyed individually, but their storage is only handed
+ * out in large chunks and released in one go together with the arena. Every shared pointer
+ * created via @a make keeps the arena alive, so it goes away with the last node of its source
+ * unit, i.e. when the source unit is dropped on CompilerStack::reset.
+ */
+class ASTArena
+{
+public:
+	/// Allocator handing out storage from an arena that it keeps alive.
+	template <class T>
+	class Allocator
+	{
+	public:
+		using value_type = T;
+
+		explicit Allocator(std::shared_ptr<ASTArena> _arena): m_arena(std::move(_arena)) {}
+		template <class U>
+		Allocator(Allocator<U> const& _other): m_arena(_other.arena()) {}
+
+		T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(_count * sizeof(T), alignof(T))); }
+		void deallocate(T*, size_t) noexcept {}
+
+		std::shared_ptr<ASTArena> const& arena() const { return m_arena; }
+
+		template <class U>
+		bool operator==(Allocator<U> const& _other) const { return m_arena == _other.arena(); }
+
+	private:
+		std::shared_ptr<ASTArena> m_arena;
+	};
+
+	/// Deleter for objects that live either in an arena or on the heap.
+	struct Deleter
+	{
+		bool inArena = false;
+
+		template <class T>
+		void operator()(T* _object) const
+		{
+			if (inArena)
+				std::destroy_at(_object);
+			else
+				delete _object;
+		}
+	};
+	template <class T>
+	using UniquePtr = std::unique_ptr<T, Deleter>;
+
+	/// @returns a new object allocated in @a _arena or on the heap if @a _arena is null.
+	/// AST nodes remember their arena so that their annotations can be allocated in it as well.
+	template <class T, class... Args>
+	static std::shared_ptr<T> make(std::shared_ptr<ASTArena> const& _arena, Args&&... _args)
+	{
+		if (!_arena)
+			return std::make_shared<T>(std::forward<Args>(_args)...);
+		auto object = std::allocate_shared<T>(Allocator<T>(_arena), std::forward<Args>(_args)...);
+		if constexpr (std::is_base_of_v<ASTNode, T>)
+			object->m_arena = _arena.get();
+		return object;
+	}
+
+	/// @returns a new object owned by the returned pointer, allocated in @a _arena or on the heap
+	/// if @a _arena is null. The arena has to outlive the object.
+	template <class T, class... Args>
+	static UniquePtr<T> makeUnique(ASTArena* _arena, Args&&... _args)
+	{
+		if (!_arena)
+			return UniquePtr<T>(new T(std::forward<Args>(_args)...), Deleter{false});
+		void* storage = _arena->allocate(sizeof(T), alignof(T));
+		return UniquePtr<T>(new (storage) T(std::forward<Args>(_args)...), Deleter{true});
+	}
+
+	/// @returns @a _size bytes of storage aligned to @a _alignment, valid until the arena is destroyed.
+	void* allocate(size_t _size, size_t _alignment);
+
+private:
+	/// Annotations are created lazily and might be requested from several threads at once.
+	std::mutex m_mutex;
+	std::pmr::monotonic_buffer_resource m_resource{initialChunkSize};
+
+	static size_t constexpr initialChunkSize = 0x1000;
+};
+
+}
@@ -201,11 +201,38 @@ Json ASTJsonExporter::inlineAssemblyIdentifierToJson(std::pair<yul::Identifier c
 
 void ASTJsonExporter::print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format)
 {
-	_stream << util::jsonPrint(toJson(_node), _format);
+	util::JsonStreamWriter writer(_stream, _format);
+	print(writer, _node);
+}
+
+void ASTJsonExporter::print(util::JsonStreamWriter& _writer, ASTNode const& _node)
+{
+	solAssert(!m_deferredNodes);
+	std::vector<DeferredNode> deferredNodes;
+	m_deferredNodes = &deferredNodes;
+	ScopeGuard resetDeferredNodes([&] { m_deferredNodes = nullptr; });
+
+	// Only the attributes of the nodes on the path to the current one are held in memory.
+	// Their children are converted once the writer reaches their placeholders.
+	std::function<void(util::JsonStreamWriter&, uint64_t)> writeDeferredNode = [&](util::JsonStreamWriter& _nodeWriter, uint64_t _index) {
+		size_t const firstChild = deferredNodes.size();
+		auto const [node, inEvent] = deferredNodes.at(_index);
+		m_inEvent = inEvent;
+		node->accept(*this);
+		_nodeWriter.value(util::removeNullMembers(std::move(m_currentValue)), writeDeferredNode);
+		deferredNodes.resize(firstChild);
+	};
+	deferredNodes.push_back({&_node, m_inEvent});
+	writeDeferredNode(_writer, 0);
 }
 
 Json ASTJsonExporter::toJson(ASTNode const& _node)
 {
+	if (m_deferredNodes)
+	{
+		m_deferredNodes->push_back({&_node, m_inEvent});
+		return util::JsonStreamWriter::deferredValue(m_deferredNodes->size() - 1);
+	}
 	_node.accept(*this);
 	return util::removeNullMembers(std::move(m_currentValue));
 }
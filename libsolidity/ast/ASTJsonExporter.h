@@ -58,7 +58,10 @@ public:
 		std::map<std::string, unsigned> _sourceIndices = std::map<std::string, unsigned>()
 	);
 	/// Output the json representation of the AST to _stream.
+	/// The nodes are converted one at a time while writing, the complete JSON is never held in memory.
 	void print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format);
+	/// Writes the json representation of the AST as the next value of @a _writer.
+	void print(util::JsonStreamWriter& _writer, ASTNode const& _node);
 	Json toJson(ASTNode const& _node);
 	template <class T>
 	Json toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -195,8 +198,17 @@ private:
 		_array.emplace_back(std::move(_value));
 	}
 
+	/// Node whose conversion is deferred until it is written, see @a print().
+	struct DeferredNode
+	{
+		ASTNode const* node = nullptr;
+		bool inEvent = false;
+	};
+
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
+	/// While printing, @a toJson() only records the nodes here and returns placeholders for them.
+	std::vector<DeferredNode>* m_deferredNodes = nullptr;
 	Json m_currentValue;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
@@ -41,9 +41,11 @@ public:
 		langutil::EVMVersion _evmVersion,
 		std::optional<uint8_t> _eofVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		size_t _optimiserThreadCount = 1
 	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_optimiserThreadCount(_optimiserThreadCount),
 		m_runtimeContext(_evmVersion, _eofVersion, _revertStrings),
 		m_context(_evmVersion, _eofVersion, _revertStrings, &m_runtimeContext)
 	{ }
@@ -69,6 +71,7 @@ public:
 
 private:
 	OptimiserSettings const m_optimiserSettings;
+	size_t const m_optimiserThreadCount; ///< Number of threads the assembly optimiser may use.
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
@@ -56,7 +56,8 @@ struct ArraySlicePredicate
 
 private:
 	/// Maps a unique sort name to its slice data.
-	static std::map<std::string, SliceData> m_slicePredicates;
+	/// Thread-local so that separate compilations can run the model checker concurrently.
+	thread_local static std::map<std::string, SliceData> m_slicePredicates;
 };
 
 }
@@ -57,7 +57,7 @@ BMC::BMC(
 		solvers.emplace_back(std::make_unique<Cvc5SMTLib2Interface>(_smtCallback, _settings.timeout));
 	if (_settings.solvers.z3 )
 		solvers.emplace_back(std::make_unique<Z3SMTLib2Interface>(_smtCallback, _settings.timeout));
-	m_interface = std::make_unique<SMTPortfolio>(std::move(solvers), _settings.timeout);
+	m_interface = std::make_unique<SMTPortfolio>(std::move(solvers), _settings.timeout, _settings.crossCheckSolvers);
 #if defined (HAVE_Z3)
 	if (m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
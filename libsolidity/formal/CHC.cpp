@@ -33,6 +33,7 @@
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/StringUtils.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -42,6 +43,7 @@
 #include <range/v3/view/reverse.hpp>
 
 #include <charconv>
+#include <future>
 #include <queue>
 
 using namespace solidity;
@@ -1902,14 +1904,25 @@ CHCSolverInterface::QueryResult CHC::query(smtutil::Expression const& _query, la
 	{
 		auto smtLibInterface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
 		solAssert(smtLibInterface, "Requested to print queries but CHCSmtLib2Interface not available");
-		std::string smtLibCode = smtLibInterface->dumpQuery(_query);
+		reportQuery(smtLibInterface->dumpQuery(_query));
+	}
+	auto result = m_interface->query(_query);
+	reportQueryAnswer(result.answer, _location);
+	return result;
+}
+
+void CHC::reportQuery(std::string const& _smtLibCode)
+{
+	if (m_settings.printQuery)
 		m_errorReporter.info(
 			2339_error,
-			"CHC: Requested query:\n" + smtLibCode
+			"CHC: Requested query:\n" + _smtLibCode
 		);
-	}
-	auto result = m_interface->query(_query);
-	switch (result.answer)
+}
+
+void CHC::reportQueryAnswer(CheckResult _answer, langutil::SourceLocation const& _location)
+{
+	switch (_answer)
 	{
 	case CheckResult::SATISFIABLE:
 	case CheckResult::UNSATISFIABLE:
@@ -1922,7 +1935,6 @@ CHCSolverInterface::QueryResult CHC::query(smtutil::Expression const& _query, la
 		m_errorReporter.warning(1218_error, _location, "CHC: Error during interaction with the solver.");
 		break;
 	}
-	return result;
 }
 
 void CHC::verificationTargetEncountered(
@@ -2024,15 +2036,26 @@ void CHC::checkVerificationTargets()
 				targetEntryPoints[id].push_back(placeholder);
 	}
 
-	std::set<unsigned> checkedErrorIds;
-	for (auto const& [targetId, placeholders]: targetEntryPoints)
-	{
-		auto const& target = m_verificationTargets.at(targetId);
-		auto [errorType, errorReporterId] = targetDescription(target);
+	auto const* smtLibInterface = dynamic_cast<CHCSmtLib2Interface const*>(m_interface.get());
+	if (
+		m_settings.chcThreads > 1 &&
+		targetEntryPoints.size() > 1 &&
+		smtLibInterface &&
+		smtLibInterface->supportsConcurrentQueries()
+	)
+		checkAndReportTargetsConcurrently(targetEntryPoints);
+	else
+		for (auto const& [targetId, placeholders]: targetEntryPoints)
+		{
+			auto const& target = m_verificationTargets.at(targetId);
+			auto [errorType, errorReporterId] = targetDescription(target);
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
-		checkedErrorIds.insert(target.errorId);
-	}
+			checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		}
+
+	std::set<unsigned> checkedErrorIds;
+	for (unsigned targetId: targetEntryPoints | ranges::views::keys)
+		checkedErrorIds.insert(m_verificationTargets.at(targetId).errorId);
 
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
@@ -2163,8 +2186,96 @@ void CHC::checkAndReportTarget(
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
+	reportTarget(
+		_target,
+		query(error(), _target.errorNode->location()),
+		error().name,
+		_errorReporterId,
+		_satMsg,
+		_unknownMsg
+	);
+}
+
+void CHC::checkAndReportTargetsConcurrently(std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints)
+{
+	auto* smtLibInterface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
+	solAssert(smtLibInterface && smtLibInterface->supportsConcurrentQueries());
+
+	// Every target has its own error block, so the rules added for the other targets do not
+	// affect the answer to its query and all queries can be built before any of them is sent.
+	// Unlike in the sequential mode, targets whose error node turns out to be unsafe
+	// for an earlier target are still sent to the solver, so the queries do not depend on the answers.
+	// As in the sequential mode, neither their queries nor their answers are reported.
+	struct TargetQuery
+	{
+		CHCVerificationTarget const* target;
+		std::string errorBlockName;
+		std::string smtLibCode;
+	};
+	std::vector<TargetQuery> targetQueries;
+	for (auto const& [targetId, placeholders]: _targetEntryPoints)
+	{
+		auto const& target = m_verificationTargets.at(targetId);
+		createErrorBlock();
+		for (auto const& placeholder: placeholders)
+			connectBlocks(
+				placeholder.fromPredicate,
+				error(),
+				placeholder.constraints && placeholder.errorExpression == target.errorId
+			);
+		targetQueries.push_back({&target, error().name, smtLibInterface->dumpQuery(error())});
+	}
+
+	std::vector<std::future<std::vector<std::string>>> responses;
+	util::ThreadPool threadPool(std::min<size_t>(m_settings.chcThreads, targetQueries.size()));
+	for (TargetQuery const& targetQuery: targetQueries)
+		responses.emplace_back(threadPool.submit([smtLibInterface, &targetQuery]() {
+			return smtLibInterface->solveConcurrently(targetQuery.smtLibCode);
+		}));
+
+	for (size_t i = 0; i < targetQueries.size(); ++i)
+	{
+		TargetQuery const& targetQuery = targetQueries[i];
+		auto const& target = *targetQuery.target;
+		auto const& location = target.errorNode->location();
+		if (m_unsafeTargets.count(target.errorNode) && m_unsafeTargets.at(target.errorNode).count(target.type))
+			continue;
+		reportQuery(targetQuery.smtLibCode);
+
+		CHCSolverInterface::QueryResult result{CheckResult::ERROR, smtutil::Expression(true), {}};
+		try
+		{
+			result = smtLibInterface->resultFromResponses(responses[i].get());
+		}
+		catch (SMTSolverInteractionError const&)
+		{
+			// The solver could not be run, which is reported as an error below.
+		}
+		reportQueryAnswer(result.answer, location);
+
+		auto [errorType, errorReporterId] = targetDescription(target);
+		reportTarget(
+			target,
+			result,
+			targetQuery.errorBlockName,
+			errorReporterId,
+			errorType + " happens here.",
+			errorType + " might happen here."
+		);
+	}
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	CHCSolverInterface::QueryResult const& _result,
+	std::string const& _errorBlockName,
+	ErrorId _errorReporterId,
+	std::string const& _satMsg,
+	std::string const& _unknownMsg
+)
+{
+	auto const& [result, invariant, model] = _result;
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
 	if (result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target);
@@ -2180,7 +2291,7 @@ void CHC::checkAndReportTarget(
 	else if (result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		auto cex = generateCounterexample(model, _errorBlockName);
 		if (cex)
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
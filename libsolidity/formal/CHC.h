@@ -297,6 +297,10 @@ private:
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	smtutil::CHCSolverInterface::QueryResult query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Reports @a _smtLibCode if the user requested to print the queries.
+	void reportQuery(std::string const& _smtLibCode);
+	/// Warns about answers of the solver that are neither safe, unsafe nor unknown.
+	void reportQueryAnswer(smtutil::CheckResult _answer, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -310,6 +314,20 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Checks all targets like checkAndReportTarget(), but sends the queries for the targets to
+	/// up to m_settings.chcThreads solver processes at the same time.
+	/// The results are reported in the order of the targets.
+	void checkAndReportTargetsConcurrently(std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints);
+	/// Records the safety of @a _target according to @a _result of the query for the error
+	/// block @a _errorBlockName.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		smtutil::CHCSolverInterface::QueryResult const& _result,
+		std::string const& _errorBlockName,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg
+	);
 
 	std::pair<std::string, langutil::ErrorId> targetDescription(CHCVerificationTarget const& _target);
 
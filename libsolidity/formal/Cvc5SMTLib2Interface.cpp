@@ -27,9 +27,16 @@ Cvc5SMTLib2Interface::Cvc5SMTLib2Interface(
 	std::optional<unsigned int> _queryTimeout
 ): SMTLib2Interface({}, std::move(_smtCallback), _queryTimeout)
 {
+	if (m_smtCallback.target<frontend::UniversalCallback>())
+	{
+		m_solverCommand.emplace();
+		m_solverCommand->setCvc5(m_queryTimeout);
+		m_smtCallback = m_solverCommand->solver();
+	}
 }
 
-void Cvc5SMTLib2Interface::setupSmtCallback() {
-	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
-		universalCallback->smtCommand().setCvc5(m_queryTimeout);
+void Cvc5SMTLib2Interface::setInterrupted(bool _interrupted)
+{
+	if (m_solverCommand)
+		m_solverCommand->setInterrupted(_interrupted);
 }
@@ -18,6 +18,7 @@
 
 #include <libsolidity/formal/EldaricaCHCSmtLib2Interface.h>
 
+#include <libsolidity/interface/SMTSolverCommand.h>
 #include <libsolidity/interface/UniversalCallback.h>
 
 using namespace solidity::frontend::smt;
@@ -37,3 +38,18 @@ std::string EldaricaCHCSmtLib2Interface::querySolver(std::string const& _input)
 
 	return CHCSmtLib2Interface::querySolver(_input);
 }
+
+bool EldaricaCHCSmtLib2Interface::supportsConcurrentQueries() const
+{
+	return m_smtCallback.target<frontend::UniversalCallback>();
+}
+
+std::vector<std::string> EldaricaCHCSmtLib2Interface::solveConcurrently(std::string const& _query) const
+{
+	smtAssert(supportsConcurrentQueries());
+	SMTSolverCommand command;
+	command.setEldarica(m_queryTimeout, m_computeInvariants);
+	auto result = command.solve(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _query);
+	smtSolverInteractionRequire(result.success, result.responseOrErrorMessage.str());
+	return {result.responseOrErrorMessage.str()};
+}
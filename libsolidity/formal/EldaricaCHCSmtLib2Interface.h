@@ -32,6 +32,11 @@ public:
 		bool computeInvariants
 	);
 
+	/// Concurrent queries run their own Eldarica process and are only supported if Eldarica
+	/// is called via its binary.
+	bool supportsConcurrentQueries() const override;
+	std::vector<std::string> solveConcurrently(std::string const& _query) const override;
+
 private:
 	std::string querySolver(std::string const& _input) override;
 
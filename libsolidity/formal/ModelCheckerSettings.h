@@ -158,7 +158,15 @@ struct ModelCheckerExtCalls
 struct ModelCheckerSettings
 {
 	std::optional<unsigned> bmcLoopIterations;
+	/// Number of solver processes the CHC engine queries at the same time, one query per
+	/// verification target. Only used with Z3 or Eldarica called via their binaries.
+	/// With more than one, targets already found unsafe via another target are queried anyway,
+	/// so that all queries can be built before any of them is answered.
+	unsigned chcThreads = 1;
 	ModelCheckerContracts contracts = ModelCheckerContracts::Default();
+	/// By default, BMC uses the answer of the solver that answers a query first.
+	/// This option makes it wait for all solvers and report conflicting answers.
+	bool crossCheckSolvers = false;
 	/// Currently division and modulo are replaced by multiplication with slack vars, such that
 	/// a / b <=> a = b * k + m
 	/// where k and m are slack variables.
@@ -182,7 +190,9 @@ struct ModelCheckerSettings
 	{
 		return
 			bmcLoopIterations == _other.bmcLoopIterations &&
+			chcThreads == _other.chcThreads &&
 			contracts == _other.contracts &&
+			crossCheckSolvers == _other.crossCheckSolvers &&
 			divModNoSlacks == _other.divModNoSlacks &&
 			engine == _other.engine &&
 			externalCalls.mode == _other.externalCalls.mode &&
@@ -18,6 +18,7 @@
 
 #include <libsolidity/formal/Z3CHCSmtLib2Interface.h>
 
+#include <libsolidity/interface/SMTSolverCommand.h>
 #include <libsolidity/interface/UniversalCallback.h>
 
 #include <libsmtutil/SMTLib2Parser.h>
@@ -58,59 +59,89 @@ void Z3CHCSmtLib2Interface::setupSmtCallback(bool _enablePreprocessing)
 		universalCallback->smtCommand().setZ3(m_queryTimeout, _enablePreprocessing, m_computeInvariants);
 }
 
-CHCSolverInterface::QueryResult Z3CHCSmtLib2Interface::query(smtutil::Expression const& _block)
+bool Z3CHCSmtLib2Interface::supportsConcurrentQueries() const
 {
-	setupSmtCallback(true);
-	std::string query = dumpQuery(_block);
-	try
-	{
 #ifdef EMSCRIPTEN_BUILD
-		z3::set_param("fp.xform.slice", true);
-		z3::set_param("fp.xform.inline_linear", true);
-		z3::set_param("fp.xform.inline_eager", true);
-		std::string response = Z3_eval_smtlib2_string(z3::context{}, query.c_str());
+	return false;
 #else
-		std::string response = querySolver(query);
+	return m_smtCallback.target<frontend::UniversalCallback>();
 #endif
-		// NOTE: Our internal semantics is UNSAT -> SAFE and SAT -> UNSAFE, which corresponds to usual SMT-based model checking
-		// However, with CHC solvers, the meaning is flipped, UNSAT -> UNSAFE and SAT -> SAFE.
-		// So we have to flip the answer.
-		if (boost::starts_with(response, "unsat"))
-		{
-			// Repeat the query with preprocessing disabled, to get the full proof
-			setupSmtCallback(false);
-			query = "(set-option :produce-proofs true)" + query + "\n(get-proof)";
+}
+
+std::vector<std::string> Z3CHCSmtLib2Interface::solveConcurrently(std::string const& _query) const
+{
+	smtAssert(supportsConcurrentQueries());
+	SMTSolverCommand command;
+	return solve(_query, [&](std::string const& _input, bool _preprocessing) {
+		command.setZ3(m_queryTimeout, _preprocessing, m_computeInvariants);
+		auto result = command.solve(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
+		smtSolverInteractionRequire(result.success, result.responseOrErrorMessage.str());
+		return result.responseOrErrorMessage.str();
+	});
+}
+
+std::string Z3CHCSmtLib2Interface::querySolver(std::string const& _input, bool _preprocessing)
+{
 #ifdef EMSCRIPTEN_BUILD
-			z3::set_param("fp.xform.slice", false);
-			z3::set_param("fp.xform.inline_linear", false);
-			z3::set_param("fp.xform.inline_eager", false);
-			response = Z3_eval_smtlib2_string(z3::context{}, query.c_str());
+	z3::set_param("fp.xform.slice", _preprocessing);
+	z3::set_param("fp.xform.inline_linear", _preprocessing);
+	z3::set_param("fp.xform.inline_eager", _preprocessing);
+	return Z3_eval_smtlib2_string(z3::context{}, _input.c_str());
 #else
-			response = querySolver(query);
+	setupSmtCallback(_preprocessing);
+	std::string response = CHCSmtLib2Interface::querySolver(_input);
+	setupSmtCallback(true);
+	return response;
 #endif
-			setupSmtCallback(true);
-			if (!boost::starts_with(response, "unsat"))
-				return {CheckResult::SATISFIABLE, Expression(true), {}};
-			return {CheckResult::SATISFIABLE, Expression(true), graphFromZ3Answer(response)};
-		}
+}
 
-		CheckResult result;
-		if (boost::starts_with(response, "sat"))
-		{
-			auto maybeInvariants = invariantsFromSolverResponse(response);
-			return {CheckResult::UNSATISFIABLE, maybeInvariants.value_or(Expression(true)), {}};
-		}
-		else if (boost::starts_with(response, "unknown"))
-			result = CheckResult::UNKNOWN;
-		else
-			result = CheckResult::ERROR;
+std::vector<std::string> Z3CHCSmtLib2Interface::solve(std::string const& _query)
+{
+	return solve(_query, [&](std::string const& _input, bool _preprocessing) {
+		return querySolver(_input, _preprocessing);
+	});
+}
 
-		return {result, Expression(true), {}};
+std::vector<std::string> Z3CHCSmtLib2Interface::solve(
+	std::string const& _query,
+	std::function<std::string(std::string const&, bool)> const& _querySolver
+)
+{
+	std::vector<std::string> responses{_querySolver(_query, true)};
+	// Repeat the query with preprocessing disabled, to get the full proof
+	if (boost::starts_with(responses.front(), "unsat"))
+		responses.emplace_back(_querySolver("(set-option :produce-proofs true)" + _query + "\n(get-proof)", false));
+	return responses;
+}
+
+CHCSolverInterface::QueryResult Z3CHCSmtLib2Interface::interpretResponses(std::vector<std::string> const& _responses) const
+{
+	smtAssert(!_responses.empty());
+	std::string const& response = _responses.front();
+	// NOTE: Our internal semantics is UNSAT -> SAFE and SAT -> UNSAFE, which corresponds to usual SMT-based model checking
+	// However, with CHC solvers, the meaning is flipped, UNSAT -> UNSAFE and SAT -> SAFE.
+	// So we have to flip the answer.
+	if (boost::starts_with(response, "unsat"))
+	{
+		smtAssert(_responses.size() == 2);
+		std::string const& proofResponse = _responses.back();
+		if (!boost::starts_with(proofResponse, "unsat"))
+			return {CheckResult::SATISFIABLE, Expression(true), {}};
+		return {CheckResult::SATISFIABLE, Expression(true), graphFromZ3Answer(proofResponse)};
 	}
-	catch(smtutil::SMTSolverInteractionError const&)
+
+	CheckResult result;
+	if (boost::starts_with(response, "sat"))
 	{
-		return {CheckResult::ERROR, Expression(true), {}};
+		auto maybeInvariants = invariantsFromSolverResponse(response);
+		return {CheckResult::UNSATISFIABLE, maybeInvariants.value_or(Expression(true)), {}};
 	}
+	else if (boost::starts_with(response, "unknown"))
+		result = CheckResult::UNKNOWN;
+	else
+		result = CheckResult::ERROR;
+
+	return {result, Expression(true), {}};
 }
 
 
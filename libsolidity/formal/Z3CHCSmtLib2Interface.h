@@ -20,6 +20,8 @@
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 
+#include <functional>
+
 namespace solidity::frontend::smt
 {
 
@@ -32,10 +34,25 @@ public:
 		bool _computeInvariants
 	);
 
+	/// Concurrent queries run their own Z3 process and are only supported if Z3 is called via
+	/// its binary.
+	bool supportsConcurrentQueries() const override;
+	std::vector<std::string> solveConcurrently(std::string const& _query) const override;
+
 private:
 	void setupSmtCallback(bool _disablePreprocessing);
 
-	CHCSolverInterface::QueryResult query(smtutil::Expression const& _expr) override;
+	/// Queries Z3 with preprocessing enabled or disabled.
+	std::string querySolver(std::string const& _input, bool _preprocessing);
+
+	std::vector<std::string> solve(std::string const& _query) override;
+	/// Sends @a _query to Z3 via @a _querySolver and, if Z3 finds the target reachable,
+	/// repeats it with preprocessing disabled to obtain the full proof.
+	static std::vector<std::string> solve(
+		std::string const& _query,
+		std::function<std::string(std::string const&, bool)> const& _querySolver
+	);
+	QueryResult interpretResponses(std::vector<std::string> const& _responses) const override;
 
 	CHCSolverInterface::CexGraph graphFromZ3Answer(std::string const& _proof) const;
 
@@ -41,12 +41,20 @@ Z3SMTLib2Interface::Z3SMTLib2Interface(
 	z3::set_param("fp.spacer.q3.use_qgen", true);
 	z3::set_param("fp.spacer.mbqi", false);
 	z3::set_param("fp.spacer.ground_pobs", false);
+#else
+	if (m_smtCallback.target<frontend::UniversalCallback>())
+	{
+		m_solverCommand.emplace();
+		m_solverCommand->setZ3(m_queryTimeout, true, false);
+		m_smtCallback = m_solverCommand->solver();
+	}
 #endif
 }
 
-void Z3SMTLib2Interface::setupSmtCallback() {
-	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
-		universalCallback->smtCommand().setZ3(m_queryTimeout, true, false);
+void Z3SMTLib2Interface::setInterrupted(bool _interrupted)
+{
+	if (m_solverCommand)
+		m_solverCommand->setInterrupted(_interrupted);
 }
 
 std::string Z3SMTLib2Interface::querySolver(std::string const& _query)
@@ -20,6 +20,10 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsolidity/interface/SMTSolverCommand.h>
+
+#include <optional>
+
 namespace solidity::frontend::smt
 {
 
@@ -30,9 +34,16 @@ public:
 		frontend::ReadCallback::Callback _smtCallback = {},
 		std::optional<unsigned> _queryTimeout = {}
 	);
+
+	bool supportsConcurrentCheck() const override { return m_solverCommand.has_value(); }
+	void setInterrupted(bool _interrupted) override;
+
 private:
-	void setupSmtCallback() override;
 	std::string querySolver(std::string const& _query) override;
+
+	/// Calls the solver binary if the callback would do so, which makes the queries independent of
+	/// other solvers sharing the callback and lets them be interrupted.
+	std::optional<SMTSolverCommand> m_solverCommand;
 };
 
 }
@@ -84,6 +84,8 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -93,6 +95,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <utility>
 #include <map>
 #include <limits>
@@ -107,24 +110,15 @@ using namespace std::string_literals;
 
 using solidity::util::errinfo_comment;
 
-static int g_compilerStackCounts = 0;
-
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
+	m_typeProvider(std::make_unique<TypeProvider>()),
 	m_objectOptimizer(std::make_shared<yul::ObjectOptimizer>()),
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
 }
 
-CompilerStack::~CompilerStack()
-{
-	--g_compilerStackCounts;
-	TypeProvider::reset();
-}
+CompilerStack::~CompilerStack() = default;
 
 void CompilerStack::createAndAssignCallGraphs()
 {
@@ -228,6 +222,37 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setParallelism(size_t _threadCount)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set parallelism before compiling.");
+	m_parallelism = (_threadCount == 0 ? util::ThreadPool::hardwareConcurrency() : _threadCount);
+}
+
+void CompilerStack::setObjectOptimizer(std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set the object optimizer before compiling.");
+	solAssert(_objectOptimizer);
+	m_objectOptimizer = std::move(_objectOptimizer);
+}
+
+void CompilerStack::setOptimizerCacheDirectory(boost::filesystem::path _directory)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set the optimizer cache directory before compiling.");
+	m_objectOptimizer->setPersistentCacheDirectory(std::move(_directory), VersionStringStrict);
+}
+
+void CompilerStack::setBuildCache(std::shared_ptr<BuildCache> _cache)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set the build cache before compiling.");
+	m_buildCache = std::move(_cache);
+}
+
+void CompilerStack::setProfiler(std::shared_ptr<util::Profiler> _profiler)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set the profiler before compiling.");
+	m_profiler = std::move(_profiler);
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	solAssert(m_stackState < ParsedAndImported, "Must set EVM version before parsing.");
@@ -318,6 +343,9 @@ void CompilerStack::reset(bool _keepSettings)
 		m_importRemapper.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_parallelism = 1;
+		m_buildCache.reset();
+		m_profiler.reset();
 		m_evmVersion = langutil::EVMVersion();
 		m_eofVersion.reset();
 		m_modelCheckerSettings = ModelCheckerSettings{};
@@ -335,21 +363,30 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
-	TypeProvider::reset();
+	m_typeProvider = std::make_unique<TypeProvider>();
 }
 
 void CompilerStack::setSources(StringMap _sources)
+{
+	std::map<std::string, util::SharedText> sources;
+	for (auto& [name, content]: _sources)
+		sources.emplace(name, std::move(content));
+	setSourceTexts(std::move(sources));
+}
+
+void CompilerStack::setSourceTexts(std::map<std::string, util::SharedText> _sources)
 {
 	solAssert(m_stackState != SourcesSet, "Cannot change sources once set.");
 	solAssert(m_stackState == Empty, "Must set sources before parsing.");
-	for (auto source: _sources)
-		m_sources[source.first].charStream = std::make_unique<CharStream>(/*content*/std::move(source.second), /*name*/source.first);
+	for (auto& [name, content]: _sources)
+		m_sources[name].charStream = std::make_unique<CharStream>(/*content*/std::move(content), /*name*/name);
 	m_stackState = SourcesSet;
 }
 
 bool CompilerStack::parse()
 {
 	solAssert(m_stackState == SourcesSet, "Must call parse only after the SourcesSet state.");
+	util::Profiler::Scope profilerScope(m_profiler.get());
 	m_errorReporter.clear();
 
 	if (SemVerVersion{std::string(VersionString)}.isPrerelease())
@@ -359,6 +396,13 @@ bool CompilerStack::parse()
 	{
 		Parser parser{m_errorReporter, m_evmVersion, m_eofVersion};
 
+		// Parsing on several threads only does the expensive part ahead of time. The loop below
+		// still runs in the usual order and takes over the results, so that node IDs, the order
+		// of the sources and the diagnostics are the same as when parsing sequentially.
+		PreparsedSources preparsedSources;
+		if (m_parallelism > 1)
+			preparsedSources = parseConcurrently();
+
 		std::vector<std::string> sourcesToParse;
 		for (auto const& s: m_sources)
 			sourcesToParse.push_back(s.first);
@@ -367,7 +411,25 @@ bool CompilerStack::parse()
 		{
 			std::string const& path = sourcesToParse[i];
 			Source& source = m_sources[path];
-			source.ast = parser.parse(*source.charStream);
+			auto preparsed = preparsedSources.sources.find(path);
+			if (
+				preparsed != preparsedSources.sources.end() &&
+				(
+					preparsed->second.charStream == source.charStream ||
+					preparsed->second.charStream->source() == source.charStream->source()
+				)
+			)
+			{
+				source.charStream = preparsed->second.charStream;
+				source.ast = preparsed->second.ast;
+				parser.adopt(preparsed->second.nodes);
+				preparsedSources.sources.erase(preparsed);
+			}
+			else
+			{
+				util::Profiler::Probe probe("Parsing", "parsing", path);
+				source.ast = parser.parse(*source.charStream);
+			}
 			if (!source.ast)
 				solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 			else
@@ -397,10 +459,10 @@ bool CompilerStack::parse()
 				}
 
 				if (m_stopAfter >= ParsedAndImported)
-					for (auto const& newSource: loadMissingSources(*source.ast))
+					for (auto const& newSource: loadMissingSources(*source.ast, preparsedSources.readResults))
 					{
 						std::string const& newPath = newSource.first;
-						std::string const& newContents = newSource.second;
+						util::SharedText const& newContents = newSource.second;
 						m_sources[newPath].charStream = std::make_shared<CharStream>(newContents, newPath);
 						sourcesToParse.push_back(newPath);
 					}
@@ -452,6 +514,9 @@ void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 bool CompilerStack::analyze()
 {
 	solAssert(m_stackState == ParsedAndImported, "Must call analyze only after parsing was successful.");
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
+	util::Profiler::Scope profilerScope(m_profiler.get());
+	util::Profiler::Probe probe("Analysis", "analysis");
 
 	if (!resolveImports())
 		return false;
@@ -466,38 +531,48 @@ bool CompilerStack::analyze()
 	{
 		bool experimentalSolidity = isExperimentalSolidity();
 
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		{
+			util::Profiler::Probe probe("SyntaxChecker", "analysis");
+			SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+		}
 
 		m_globalContext = std::make_shared<GlobalContext>(m_evmVersion);
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter, experimentalSolidity);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.registerDeclarations(*source->ast))
-				return false;
+		{
+			util::Profiler::Probe probe("Declaration registration", "analysis");
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.registerDeclarations(*source->ast))
+					return false;
 
-		std::map<std::string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
+			std::map<std::string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
 
-		resolver.warnHomonymDeclarations();
+			resolver.warnHomonymDeclarations();
+		}
 
 		{
+			util::Profiler::Probe probe("DocStringTagParser", "analysis");
 			DocStringTagParser docStringTagParser(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
 					noErrors = false;
 		}
 
-		// Requires DocStringTagParser
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
-				return false;
+		{
+			util::Profiler::Probe probe("NameAndTypeResolver", "analysis");
+			// Requires DocStringTagParser
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
+					return false;
+		}
 
 		if (experimentalSolidity)
 		{
@@ -530,41 +605,54 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 {
 	bool noErrors = _noErrorsSoFar;
 
-	DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !declarationTypeChecker.check(*source->ast))
-			return false;
+	{
+		util::Profiler::Probe probe("DeclarationTypeChecker", "analysis");
+		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !declarationTypeChecker.check(*source->ast))
+				return false;
+	}
 
-	// Requires DeclarationTypeChecker to have run
-	DocStringTagParser docStringTagParser(m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
-			noErrors = false;
+	{
+		util::Profiler::Probe probe("DocStringTagParser validation", "analysis");
+		// Requires DeclarationTypeChecker to have run
+		DocStringTagParser docStringTagParser(m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
+				noErrors = false;
+	}
 
-	// Next, we check inheritance, overrides, function collisions and other things at
-	// contract or function level.
-	// This also calculates whether a contract is abstract, which is needed by the
-	// type checker.
-	ContractLevelChecker contractLevelChecker(m_errorReporter);
+	{
+		util::Profiler::Probe probe("ContractLevelChecker", "analysis");
+		// Next, we check inheritance, overrides, function collisions and other things at
+		// contract or function level.
+		// This also calculates whether a contract is abstract, which is needed by the
+		// type checker.
+		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
-	for (Source const* source: m_sourceOrder)
-		if (auto sourceAst = source->ast)
-			noErrors = contractLevelChecker.check(*sourceAst);
-
-	// Now we run full type checks that go down to the expression level. This
-	// cannot be done earlier, because we need cross-contract types and information
-	// about whether a contract is abstract for the `new` expression.
-	// This populates the `type` annotation for all expressions.
-	//
-	// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
-	// which is only done one step later.
-	TypeChecker typeChecker(m_evmVersion, m_eofVersion, m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
-			noErrors = false;
+		for (Source const* source: m_sourceOrder)
+			if (auto sourceAst = source->ast)
+				noErrors = contractLevelChecker.check(*sourceAst);
+	}
+
+	{
+		util::Profiler::Probe probe("TypeChecker", "analysis");
+		// Now we run full type checks that go down to the expression level. This
+		// cannot be done earlier, because we need cross-contract types and information
+		// about whether a contract is abstract for the `new` expression.
+		// This populates the `type` annotation for all expressions.
+		//
+		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
+		// which is only done one step later.
+		TypeChecker typeChecker(m_evmVersion, m_eofVersion, m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
+				noErrors = false;
+	}
 
 	if (noErrors)
 	{
+		util::Profiler::Probe probe("DocStringAnalyser", "analysis");
 		// Requires ContractLevelChecker and TypeChecker
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -574,6 +662,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		util::Profiler::Probe probe("PostTypeChecker", "analysis");
 		// Checks that can only be done when all types of all AST nodes are known.
 		PostTypeChecker postTypeChecker(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -586,27 +675,35 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	// Create & assign callgraphs and check for contract dependency cycles
 	if (noErrors)
 	{
+		util::Profiler::Probe probe("Call graphs", "analysis");
 		createAndAssignCallGraphs();
 		annotateInternalFunctionIDs();
 		findAndReportCyclicContractDependencies();
 	}
 
 	if (noErrors)
+	{
+		util::Profiler::Probe probe("PostTypeContractLevelChecker", "analysis");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
 				noErrors = false;
+	}
 
 	// Check that immutable variables are never read in c'tors and assigned
 	// exactly once
 	if (noErrors)
+	{
+		util::Profiler::Probe probe("ImmutableValidator", "analysis");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
 				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 						ImmutableValidator(m_errorReporter, *contract).analyze();
+	}
 
 	if (noErrors)
 	{
+		util::Profiler::Probe probe("Control flow analysis", "analysis");
 		// Control flow graph generator and analyzer. It can check for issues such as
 		// variable is used before it is assigned to.
 		CFG cfg(m_errorReporter);
@@ -627,6 +724,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		util::Profiler::Probe probe("StaticAnalyzer", "analysis");
 		// Checks for common mistakes. Only generates warnings.
 		StaticAnalyzer staticAnalyzer(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -636,6 +734,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		util::Profiler::Probe probe("ViewPureChecker", "analysis");
 		// Check for state mutability in every function.
 		std::vector<ASTPointer<ASTNode>> ast;
 		for (Source const* source: m_sourceOrder)
@@ -648,6 +747,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		util::Profiler::Probe probe("SMTChecker", "analysis");
 		// Run SMTChecker
 
 		auto allSources = util::applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
@@ -672,6 +772,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 bool CompilerStack::analyzeExperimental()
 {
+	util::Profiler::Probe probe("Experimental analysis", "analysis");
 	solAssert(!m_experimentalAnalysis);
 	solAssert(m_maxAstId && *m_maxAstId >= 0);
 	m_experimentalAnalysis = std::make_unique<experimental::Analysis>(m_errorReporter, static_cast<std::uint64_t>(*m_maxAstId));
@@ -743,6 +844,9 @@ CompilerStack::PipelineConfig CompilerStack::requestedPipelineConfig(ContractDef
 
 bool CompilerStack::compile(State _stopAfter)
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
+	util::Profiler::Scope profilerScope(m_profiler.get());
+
 	m_stopAfter = _stopAfter;
 	if (m_stackState < AnalysisSuccessful)
 		if (!parseAndAnalyze(_stopAfter))
@@ -751,13 +855,37 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_stackState >= m_stopAfter)
 		return true;
 
+	std::vector<std::pair<ContractDefinition const*, h256>> cacheKeys;
+	std::set<ContractDefinition const*> restoredContracts;
+	if (m_buildCache && !m_experimentalAnalysis && m_compilationSourceType == CompilationSourceType::Solidity)
+	{
+		cacheKeys = buildCacheKeys();
+		restoredContracts = restoreFromBuildCache(cacheKeys);
+	}
+
+	if (m_viaIR && m_parallelism > 1 && !m_experimentalAnalysis)
+	{
+		// Code generation steps skip contracts whose results have been restored.
+		if (!compileViaIRConcurrently())
+			return false;
+
+		solAssert(!m_errorReporter.hasErrors());
+		for (auto& [name, compiledContract]: m_contracts)
+			compiledContract.yulStack.reset();
+		if (m_buildCache)
+			storeInBuildCache(cacheKeys, restoredContracts);
+		m_stackState = CompilationSuccessful;
+		this->link();
+		return true;
+	}
+
 	// Only compile contracts individually which have been requested.
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
 
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				if (isRequestedContract(*contract))
+				if (isRequestedContract(*contract) && !restoredContracts.count(contract))
 				{
 					PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
 
@@ -768,7 +896,7 @@ bool CompilerStack::compile(State _stopAfter)
 						if (pipelineConfig.needBytecode())
 						{
 							if (m_viaIR)
-								generateEVMFromIR(*contract);
+								generateEVMFromIR(*contract, m_errorReporter);
 							else
 							{
 								if (m_experimentalAnalysis)
@@ -791,11 +919,254 @@ bool CompilerStack::compile(State _stopAfter)
 				}
 
 	solAssert(!m_errorReporter.hasErrors());
+	for (auto& [name, compiledContract]: m_contracts)
+		compiledContract.yulStack.reset();
+	if (m_buildCache)
+		storeInBuildCache(cacheKeys, restoredContracts);
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
 }
 
+bool CompilerStack::compileViaIRConcurrently()
+{
+	solAssert(m_viaIR);
+
+	// IR generation works on the Solidity AST, its annotations and the type system, none of
+	// which can be accessed concurrently, so it is done up front on this thread.
+	// Contracts needing optimized IR are collected in dependency order, including the
+	// dependencies, which are optimized as well when compiling sequentially.
+	std::vector<ContractDefinition const*> contractsToOptimize;
+	std::set<ContractDefinition const*> contractsToAssemble;
+	std::function<void(ContractDefinition const&)> collectForOptimization = [&](ContractDefinition const& _contract) {
+		if (util::contains(contractsToOptimize, &_contract))
+			return;
+		for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+			collectForOptimization(*dependency);
+		if (_contract.canBeDeployed())
+			contractsToOptimize.push_back(&_contract);
+	};
+
+	for (Source const* source: m_sourceOrder)
+		for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+			if (isRequestedContract(*contract))
+			{
+				PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
+				if (!pipelineConfig.needIR(m_viaIR))
+					continue;
+
+				try
+				{
+					generateIR(*contract, true /* _unoptimizedOnly */);
+				}
+				catch (Error const& _error)
+				{
+					reportCodeGenerationError(_error, contract);
+				}
+				catch (UnimplementedFeatureError const& _error)
+				{
+					reportUnimplementedFeatureError(_error, contract);
+				}
+
+				if (m_errorReporter.hasErrors())
+					return false;
+
+				if (!pipelineConfig.needIRCodegenOnly(m_viaIR))
+					collectForOptimization(*contract);
+				if (pipelineConfig.needBytecode() && contract->canBeDeployed())
+					contractsToAssemble.insert(contract);
+			}
+
+	std::map<ContractDefinition const*, size_t> taskIndices;
+	for (size_t index = 0; index < contractsToOptimize.size(); ++index)
+		taskIndices[contractsToOptimize[index]] = index;
+
+	std::vector<std::set<size_t>> taskDependencies(contractsToOptimize.size());
+	for (size_t index = 0; index < contractsToOptimize.size(); ++index)
+		for (auto const& [dependency, referencee]: contractsToOptimize[index]->annotation().contractDependencies)
+			if (taskIndices.count(dependency))
+				taskDependencies[index].insert(taskIndices.at(dependency));
+
+	// From here on only Yul and EVM assembly are processed. Each task writes only to the
+	// Contract entry of its own contract and collects its errors separately.
+	// The threads are split between the contracts so that with few contracts the objects
+	// inside each of them are optimized concurrently as well.
+	size_t const optimizerThreadCount = std::max<size_t>(m_parallelism / std::max<size_t>(contractsToOptimize.size(), 1), 1);
+	std::vector<ErrorList> taskErrors(contractsToOptimize.size());
+	util::runTaskGraph(taskDependencies, m_parallelism, [&](size_t _index) {
+		ContractDefinition const& contract = *contractsToOptimize[_index];
+		ErrorReporter errorReporter(taskErrors[_index]);
+		try
+		{
+			optimizeIR(contract, optimizerThreadCount);
+			if (contractsToAssemble.count(&contract))
+				generateEVMFromIR(contract, errorReporter, optimizerThreadCount);
+		}
+		catch (Error const& _error)
+		{
+			reportCodeGenerationError(_error, &contract, errorReporter);
+		}
+		catch (UnimplementedFeatureError const& _error)
+		{
+			reportUnimplementedFeatureError(_error, &contract, errorReporter);
+		}
+	});
+
+	for (ErrorList const& errors: taskErrors)
+		m_errorReporter.append(errors);
+
+	return !m_errorReporter.hasErrors();
+}
+
+std::vector<std::pair<ContractDefinition const*, h256>> CompilerStack::buildCacheKeys() const
+{
+	std::vector<std::pair<ContractDefinition const*, h256>> keys;
+	for (Source const* source: m_sourceOrder)
+		for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+			if (isRequestedContract(*contract) && contract->canBeDeployed())
+				keys.emplace_back(contract, buildCacheKey(*contract));
+	return keys;
+}
+
+h256 CompilerStack::buildCacheKey(ContractDefinition const& _contract) const
+{
+	// The metadata covers the content of all sources the contract depends on and most of the
+	// settings affecting its bytecode. Only the remaining inputs of code generation are added here.
+	bytes rawKey = util::keccak256(metadata(m_contracts.at(_contract.fullyQualifiedName()))).asBytes();
+
+	// Source indices and AST IDs depend on the other sources and end up in the IR and source maps.
+	// Within a source, AST IDs are assigned consecutively, so the ID of the source unit is enough.
+	std::map<std::string, unsigned> const indices = sourceIndices();
+	std::set<std::string> referencedSources{*_contract.sourceUnit().annotation().path};
+	for (SourceUnit const* sourceUnit: _contract.sourceUnit().referencedSourceUnits(true))
+		referencedSources.insert(*sourceUnit->annotation().path);
+	for (std::string const& sourceName: referencedSources)
+	{
+		rawKey += util::keccak256(sourceName).asBytes();
+		rawKey += h256(u256(indices.at(sourceName))).asBytes();
+		rawKey += h256(u256(m_sources.at(sourceName).ast->id())).asBytes();
+	}
+
+	PipelineConfig pipelineConfig = requestedPipelineConfig(_contract);
+	rawKey += util::FixedHash<1>(uint8_t(m_viaIR ? 1 : 0)).asBytes();
+	rawKey += util::FixedHash<1>(uint8_t(pipelineConfig.needIR(m_viaIR) ? 1 : 0)).asBytes();
+	rawKey += util::FixedHash<1>(uint8_t(pipelineConfig.needIRCodegenOnly(m_viaIR) ? 1 : 0)).asBytes();
+	rawKey += util::FixedHash<1>(uint8_t(pipelineConfig.needBytecode() ? 1 : 0)).asBytes();
+	rawKey += util::FixedHash<1>(uint8_t(m_eofVersion.value_or(0))).asBytes();
+	rawKey += util::FixedHash<1>(uint8_t(m_revertStrings)).asBytes();
+	rawKey += util::FixedHash<1>(uint8_t(m_metadataFormat)).asBytes();
+	rawKey += util::FixedHash<1>(uint8_t(m_metadataHash)).asBytes();
+	rawKey += util::FixedHash<1>(uint8_t(
+		(m_debugInfoSelection.location ? 1 : 0) |
+		(m_debugInfoSelection.snippet ? 2 : 0) |
+		(m_debugInfoSelection.astID ? 4 : 0)
+	)).asBytes();
+
+	return util::keccak256(rawKey);
+}
+
+std::set<ContractDefinition const*> CompilerStack::restoreFromBuildCache(
+	std::vector<std::pair<ContractDefinition const*, h256>> const& _keys
+)
+{
+	solAssert(m_buildCache);
+
+	std::map<ContractDefinition const*, BuildCache::Entry> hits;
+	{
+		std::lock_guard<std::mutex> lock(m_buildCache->m_mutex);
+		for (auto const& [contract, key]: _keys)
+		{
+			auto it = m_buildCache->m_entries.find(contract->fullyQualifiedName());
+			if (it != m_buildCache->m_entries.end() && it->second.key == key)
+				hits.emplace(contract, it->second);
+		}
+	}
+
+	if (!m_viaIR)
+	{
+		// Legacy code generation of a contract compiles all contracts it creates as well, so their
+		// results cannot be reused if any contract depending on them is compiled.
+		std::set<ContractDefinition const*> visited;
+		std::function<void(ContractDefinition const&)> dropDependencies = [&](ContractDefinition const& _contract) {
+			for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+				if (visited.insert(dependency).second)
+				{
+					hits.erase(dependency);
+					dropDependencies(*dependency);
+				}
+		};
+		for (auto const& [contract, key]: _keys)
+			if (!hits.count(contract))
+				dropDependencies(*contract);
+	}
+
+	std::set<ContractDefinition const*> restoredContracts;
+	for (auto const& [contract, key]: _keys)
+	{
+		auto it = hits.find(contract);
+		if (it == hits.end())
+			continue;
+
+		BuildCache::Entry& entry = it->second;
+		Contract& compiledContract = m_contracts.at(contract->fullyQualifiedName());
+		compiledContract.evmAssembly = std::move(entry.evmAssembly);
+		compiledContract.evmRuntimeAssembly = std::move(entry.evmRuntimeAssembly);
+		compiledContract.generatedYulUtilityCode = std::move(entry.generatedYulUtilityCode);
+		compiledContract.runtimeGeneratedYulUtilityCode = std::move(entry.runtimeGeneratedYulUtilityCode);
+		compiledContract.object = std::move(entry.object);
+		compiledContract.runtimeObject = std::move(entry.runtimeObject);
+		compiledContract.yulIR = std::move(entry.yulIR);
+		compiledContract.yulIROptimized = std::move(entry.yulIROptimized);
+
+		PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
+		if (pipelineConfig.needIR(m_viaIR))
+			reportABICoderV1WithIR(*contract, m_errorReporter);
+		if (pipelineConfig.needBytecode())
+			reportBytecodeSizeLimits(*contract, m_errorReporter);
+
+		restoredContracts.insert(contract);
+	}
+	return restoredContracts;
+}
+
+void CompilerStack::storeInBuildCache(
+	std::vector<std::pair<ContractDefinition const*, h256>> const& _keys,
+	std::set<ContractDefinition const*> const& _restoredContracts
+) const
+{
+	solAssert(m_buildCache);
+
+	std::lock_guard<std::mutex> lock(m_buildCache->m_mutex);
+	for (auto const& [contract, key]: _keys)
+		if (!_restoredContracts.count(contract))
+		{
+			Contract const& compiledContract = m_contracts.at(contract->fullyQualifiedName());
+			m_buildCache->m_entries[contract->fullyQualifiedName()] = BuildCache::Entry{
+				key,
+				compiledContract.evmAssembly,
+				compiledContract.evmRuntimeAssembly,
+				compiledContract.generatedYulUtilityCode,
+				compiledContract.runtimeGeneratedYulUtilityCode,
+				compiledContract.object,
+				compiledContract.runtimeObject,
+				compiledContract.yulIR,
+				compiledContract.yulIROptimized,
+			};
+		}
+}
+
+size_t CompilerStack::BuildCache::size() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+void CompilerStack::BuildCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -806,9 +1177,9 @@ void CompilerStack::link()
 	}
 }
 
-YulStack CompilerStack::loadGeneratedIR(std::string const& _ir) const
+std::unique_ptr<YulStack> CompilerStack::loadGeneratedIR(std::string const& _ir) const
 {
-	YulStack stack(
+	auto stack = std::make_unique<YulStack>(
 		m_evmVersion,
 		m_eofVersion,
 		YulStack::Language::StrictAssembly,
@@ -817,12 +1188,12 @@ YulStack CompilerStack::loadGeneratedIR(std::string const& _ir) const
 		this, // _soliditySourceProvider
 		m_objectOptimizer
 	);
-	bool yulAnalysisSuccessful = stack.parseAndAnalyze("", _ir);
+	bool yulAnalysisSuccessful = stack->parseAndAnalyze("", _ir);
 	solAssert(
 		yulAnalysisSuccessful,
 		_ir + "\n\n"
 		"Invalid IR generated:\n" +
-		SourceReferenceFormatter::formatErrorInformation(stack.errors(), stack) + "\n"
+		SourceReferenceFormatter::formatErrorInformation(stack->errors(), *stack) + "\n"
 	);
 
 	return stack;
@@ -987,7 +1358,7 @@ std::optional<Json> CompilerStack::yulIRAst(std::string const& _contractName) co
 	yulAssert(currentContract.yulIR.has_value() == currentContract.contract->canBeDeployed());
 	if (!currentContract.yulIR)
 		return std::nullopt;
-	return loadGeneratedIR(*currentContract.yulIR).astJson();
+	return loadGeneratedIR(*currentContract.yulIR)->astJson();
 }
 
 std::optional<Json> CompilerStack::yulCFGJson(std::string const& _contractName) const
@@ -1002,7 +1373,7 @@ std::optional<Json> CompilerStack::yulCFGJson(std::string const& _contractName)
 	yulAssert(currentContract.yulIROptimized.has_value() == currentContract.contract->canBeDeployed());
 	if (!currentContract.yulIROptimized)
 		return std::nullopt;
-	return loadGeneratedIR(*currentContract.yulIROptimized).cfgJson();
+	return loadGeneratedIR(*currentContract.yulIROptimized)->cfgJson();
 }
 
 std::optional<std::string> const& CompilerStack::yulIROptimized(std::string const& _contractName) const
@@ -1023,7 +1394,7 @@ std::optional<Json> CompilerStack::yulIROptimizedAst(std::string const& _contrac
 	yulAssert(currentContract.yulIROptimized.has_value() == currentContract.contract->canBeDeployed());
 	if (!currentContract.yulIROptimized)
 		return std::nullopt;
-	return loadGeneratedIR(*currentContract.yulIROptimized).astJson();
+	return loadGeneratedIR(*currentContract.yulIROptimized)->astJson();
 }
 
 evmasm::LinkerObject const& CompilerStack::object(std::string const& _contractName) const
@@ -1090,6 +1461,7 @@ Json const& CompilerStack::contractABI(Contract const& _contract) const
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	return _contract.abi.init([&]{ return ABI::generate(*_contract.contract); });
 }
 
@@ -1104,6 +1476,7 @@ Json const& CompilerStack::storageLayout(Contract const& _contract) const
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 
 	return _contract.storageLayout.init([&]{ return StorageLayout().generate(*_contract.contract, DataLocation::Storage); });
 }
@@ -1119,6 +1492,7 @@ Json const& CompilerStack::transientStorageLayout(Contract const& _contract) con
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 
 	return _contract.transientStorageLayout.init([&]{ return StorageLayout().generate(*_contract.contract, DataLocation::Transient); });
 }
@@ -1134,6 +1508,7 @@ Json const& CompilerStack::natspecUser(Contract const& _contract) const
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	return _contract.userDocumentation.init([&]{ return Natspec::userDocumentation(*_contract.contract); });
 }
 
@@ -1148,6 +1523,7 @@ Json const& CompilerStack::natspecDev(Contract const& _contract) const
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	return _contract.devDocumentation.init([&]{ return Natspec::devDocumentation(*_contract.contract); });
 }
 
@@ -1155,6 +1531,7 @@ Json CompilerStack::interfaceSymbols(std::string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 
 	Json interfaceSymbols;
 	// Always have a methods object
@@ -1184,6 +1561,7 @@ Json CompilerStack::interfaceSymbols(std::string const& _contractName) const
 bytes CompilerStack::cborMetadata(std::string const& _contractName, bool _forIR) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	return createCBORMetadata(contract(_contractName), _forIR);
 }
 
@@ -1192,6 +1570,7 @@ std::string const& CompilerStack::metadata(Contract const& _contract) const
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	return _contract.metadata.init([&]{ return createMetadata(_contract, m_viaIR); });
 }
 
@@ -1234,7 +1613,10 @@ size_t CompilerStack::functionEntryPoint(
 h256 const& CompilerStack::Source::keccak256() const
 {
 	if (keccak256HashCached == h256{})
-		keccak256HashCached = util::keccak256(charStream->source());
+	{
+		std::string_view source = charStream->source();
+		keccak256HashCached = util::keccak256(bytesConstRef(reinterpret_cast<uint8_t const*>(source.data()), source.size()));
+	}
 	return keccak256HashCached;
 }
 
@@ -1252,10 +1634,100 @@ std::string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
+CompilerStack::PreparsedSources CompilerStack::parseConcurrently()
+{
+	solAssert(m_stackState == SourcesSet);
+
+	PreparsedSources result;
+	// Protects result and discoveredSources.
+	std::mutex mutex;
+	// The read callback does not have to be thread-safe.
+	std::mutex readMutex;
+	std::set<std::string> discoveredSources;
+	for (auto const& [path, source]: m_sources)
+		discoveredSources.insert(path);
+
+	util::ThreadPool threadPool(m_parallelism);
+	auto post = [&](std::function<void()> _task) {
+		threadPool.post([task = std::move(_task)]() {
+			// Failures are left to the sequential pass, which reports them properly.
+			try { task(); } catch (...) {}
+		});
+	};
+	std::function<void(std::string, std::shared_ptr<CharStream>)> parseSource;
+	std::function<void(std::string)> readSource;
+
+	parseSource = [&](std::string _path, std::shared_ptr<CharStream> _charStream) {
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		Parser parser{errorReporter, m_evmVersion, m_eofVersion};
+		std::vector<ASTPointer<ASTNode>> nodes;
+		ASTPointer<SourceUnit> ast;
+		{
+			util::Profiler::Probe probe("Parsing", "parsing", _path);
+			ast = parser.parse(*_charStream, nodes);
+		}
+		if (!ast || !errors.empty())
+			return;
+
+		std::vector<std::pair<std::string, std::shared_ptr<CharStream>>> stdlibSources;
+		std::vector<std::string> importPaths;
+		for (auto const& import: ASTNode::filteredNodes<ImportDirective>(ast->nodes()))
+		{
+			auto it = stdlib::sources.find(import->path());
+			if (it != stdlib::sources.end())
+			{
+				auto [name, content] = *it;
+				stdlibSources.emplace_back(name, std::make_shared<CharStream>(content, name));
+			}
+			importPaths.push_back(applyRemapping(util::absolutePath(import->path(), _path), _path));
+		}
+
+		std::vector<std::string> sourcesToRead;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			result.sources[_path] = PreparsedSource{_charStream, ast, std::move(nodes)};
+			for (auto& [name, charStream]: stdlibSources)
+				if (discoveredSources.insert(name).second)
+					post([&, name = name, charStream = charStream]() { parseSource(name, charStream); });
+			if (m_stopAfter >= ParsedAndImported)
+				for (std::string const& importPath: importPaths)
+					if (discoveredSources.insert(importPath).second)
+						sourcesToRead.push_back(importPath);
+		}
+		for (std::string& importPath: sourcesToRead)
+			post([&, importPath = std::move(importPath)]() { readSource(importPath); });
+	};
+
+	readSource = [&](std::string _path) {
+		ReadCallback::Result readResult{false, std::string("File not supplied initially.")};
+		if (m_readFile)
+		{
+			std::lock_guard<std::mutex> lock(readMutex);
+			readResult = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), _path);
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			result.readResults[_path] = readResult;
+		}
+		if (readResult.success)
+			parseSource(_path, std::make_shared<CharStream>(readResult.responseOrErrorMessage, _path));
+	};
+
+	for (auto const& [path, source]: m_sources)
+		post([&, path = path, charStream = source.charStream]() { parseSource(path, charStream); });
+	threadPool.wait();
+
+	return result;
+}
+
+std::map<std::string, util::SharedText> CompilerStack::loadMissingSources(
+	SourceUnit const& _ast,
+	std::map<std::string, ReadCallback::Result> const& _readResults
+)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
-	StringMap newSources;
+	std::map<std::string, util::SharedText> newSources;
 	try
 	{
 		for (auto const& node: _ast.nodes())
@@ -1267,7 +1739,9 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 					continue;
 
 				ReadCallback::Result result{false, std::string("File not supplied initially.")};
-				if (m_readFile)
+				if (auto readResult = _readResults.find(importPath); readResult != _readResults.end())
+					result = readResult->second;
+				else if (m_readFile)
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
 
 				if (result.success)
@@ -1277,7 +1751,7 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 					m_errorReporter.parserError(
 						6275_error,
 						import->location(),
-						std::string("Source \"" + importPath + "\" not found: " + result.responseOrErrorMessage)
+						std::string("Source \"" + importPath + "\" not found: " + result.responseOrErrorMessage.str())
 					);
 					continue;
 				}
@@ -1412,8 +1886,9 @@ bool onlySafeExperimentalFeaturesActivated(std::set<ExperimentalFeature> const&
 
 void CompilerStack::assembleYul(
 	ContractDefinition const& _contract,
-	std::shared_ptr<evmasm::Assembly> _assembly,
-	std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+	std::shared_ptr<evmasm::Assembly const> _assembly,
+	std::shared_ptr<evmasm::Assembly const> _runtimeAssembly,
+	ErrorReporter& _errorReporter
 )
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -1445,6 +1920,13 @@ void CompilerStack::assembleYul(
 		solAssert(false, "Assembly exception for deployed bytecode"s + error.what());
 	}
 
+	reportBytecodeSizeLimits(_contract, _errorReporter);
+}
+
+void CompilerStack::reportBytecodeSizeLimits(ContractDefinition const& _contract, ErrorReporter& _errorReporter) const
+{
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (2^14 + 2^13) bytes,
 	//   contract creation fails with an out of gas error.
@@ -1452,7 +1934,7 @@ void CompilerStack::assembleYul(
 		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
 		compiledContract.runtimeObject.bytecode.size() > 0x6000
 	)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			5574_error,
 			_contract.location(),
 			"Contract code size is "s +
@@ -1470,7 +1952,7 @@ void CompilerStack::assembleYul(
 		m_evmVersion >= langutil::EVMVersion::shanghai() &&
 		compiledContract.object.bytecode.size() > 0xC000
 	)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			3860_error,
 			_contract.location(),
 			"Contract initcode size is "s +
@@ -1482,6 +1964,17 @@ void CompilerStack::assembleYul(
 		);
 }
 
+void CompilerStack::reportABICoderV1WithIR(ContractDefinition const& _contract, ErrorReporter& _errorReporter) const
+{
+	if (!*_contract.sourceUnit().annotation().useABICoderV2)
+		_errorReporter.warning(
+			2066_error,
+			_contract.location(),
+			"Contract requests the ABI coder v1, which is incompatible with the IR. "
+			"Using ABI coder v2 instead."
+		);
+}
+
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
@@ -1500,13 +1993,15 @@ void CompilerStack::compileContract(
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::Profiler::Probe probe("Code generation", "codegen", _contract.fullyQualifiedName());
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(
 		m_evmVersion,
 		m_eofVersion,
 		m_revertStrings,
-		m_optimiserSettings
+		m_optimiserSettings,
+		m_parallelism
 	);
 
 	solAssert(!m_viaIR, "");
@@ -1519,7 +2014,7 @@ void CompilerStack::compileContract(
 
 	_otherCompilers[compiledContract.contract] = compiler;
 
-	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr(), m_errorReporter);
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unoptimizedOnly)
@@ -1533,13 +2028,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 		return;
 	}
 
-	if (!*_contract.sourceUnit().annotation().useABICoderV2)
-		m_errorReporter.warning(
-			2066_error,
-			_contract.location(),
-			"Contract requests the ABI coder v1, which is incompatible with the IR. "
-			"Using ABI coder v2 instead."
-		);
+	reportABICoderV1WithIR(_contract, m_errorReporter);
 
 	std::string dependenciesSource;
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
@@ -1548,6 +2037,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::Profiler::Probe probe("IR generation", "ir-generation", _contract.fullyQualifiedName());
 	std::map<ContractDefinition const*, std::string_view const> otherYulSources;
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR ? *pair.second.yulIR : std::string_view{});
@@ -1588,15 +2078,36 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 	}
 
 	yulAssert(compiledContract.yulIR);
-	YulStack stack = loadGeneratedIR(*compiledContract.yulIR);
+	// Parse and analyze the IR to make sure it is valid even if it is not optimized.
+	compiledContract.yulStack = loadGeneratedIR(*compiledContract.yulIR);
 	if (!_unoptimizedOnly)
-	{
-		stack.optimize();
-		compiledContract.yulIROptimized = stack.print();
-	}
+		optimizeIR(_contract);
+}
+
+void CompilerStack::optimizeIR(ContractDefinition const& _contract, size_t _threadCount)
+{
+	solAssert(m_stackState >= AnalysisSuccessful, "");
+
+	if (!_contract.canBeDeployed())
+		return;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(compiledContract.yulIR);
+	if (compiledContract.yulIROptimized)
+		return;
+
+	util::Profiler::Probe probe("IR optimization", "yul-optimizer", _contract.fullyQualifiedName());
+	if (!compiledContract.yulStack)
+		compiledContract.yulStack = loadGeneratedIR(*compiledContract.yulIR);
+	compiledContract.yulStack->optimize(_threadCount);
+	compiledContract.yulIROptimized = compiledContract.yulStack->print();
+	// Without re-parsing, the debug info in the AST can differ from the one in the printed IR,
+	// so EVM code has to be generated from the printed IR instead.
+	if (!compiledContract.yulStack->reparsed())
+		compiledContract.yulStack.reset();
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract, ErrorReporter& _errorReporter, size_t _threadCount)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1609,21 +2120,24 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	YulStack stack = loadGeneratedIR(*compiledContract.yulIROptimized);
+	util::Profiler::Probe probe("EVM code generation", "codegen", _contract.fullyQualifiedName());
+	// The optimized IR is normally still available in memory. Otherwise re-parse it in EVM dialect.
+	std::shared_ptr<YulStack> stack = std::move(compiledContract.yulStack);
+	if (!stack)
+		stack = loadGeneratedIR(*compiledContract.yulIROptimized);
 
 	std::string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
+	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack->assembleEVMWithDeployed(deployedName, _threadCount);
 
-	if (stack.hasErrors())
+	if (stack->hasErrors())
 	{
-		for (std::shared_ptr<Error const> const& error: stack.errors())
-			reportIRPostAnalysisError(error.get(), compiledContract.contract);
+		for (std::shared_ptr<Error const> const& error: stack->errors())
+			reportIRPostAnalysisError(error.get(), compiledContract.contract, _errorReporter);
 		return;
 	}
 
-	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly, _errorReporter);
 }
 
 CompilerStack::Contract const& CompilerStack::contract(std::string const& _contractName) const
@@ -1699,7 +2213,7 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 		if (std::optional<std::string> licenseString = s.second.ast->licenseString())
 			meta["sources"][s.first]["license"] = *licenseString;
 		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.charStream->source();
+			meta["sources"][s.first]["content"] = std::string(s.second.charStream->source());
 		else
 		{
 			meta["sources"][s.first]["urls"] = Json::array();
@@ -1928,6 +2442,7 @@ Json CompilerStack::gasEstimates(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 
 	if (!assemblyItems(_contractName) && !runtimeAssemblyItems(_contractName))
 		return Json();
@@ -2019,12 +2534,21 @@ void CompilerStack::reportUnimplementedFeatureError(
 	UnimplementedFeatureError const& _error,
 	ContractDefinition const* _contractDefinition
 )
+{
+	reportUnimplementedFeatureError(_error, _contractDefinition, m_errorReporter);
+}
+
+void CompilerStack::reportUnimplementedFeatureError(
+	UnimplementedFeatureError const& _error,
+	ContractDefinition const* _contractDefinition,
+	ErrorReporter& _errorReporter
+) const
 {
 	solAssert(_error.comment(), "Errors must include a message for the user.");
 	if (_error.sourceLocation().sourceName)
 		solAssert(m_sources.count(*_error.sourceLocation().sourceName) != 0);
 
-	m_errorReporter.unimplementedFeatureError(
+	_errorReporter.unimplementedFeatureError(
 		1834_error,
 		(_error.sourceLocation().sourceName || !_contractDefinition) ?
 			_error.sourceLocation() :
@@ -2034,6 +2558,15 @@ void CompilerStack::reportUnimplementedFeatureError(
 }
 
 void CompilerStack::reportCodeGenerationError(Error const& _error, ContractDefinition const* _contractDefinition)
+{
+	reportCodeGenerationError(_error, _contractDefinition, m_errorReporter);
+}
+
+void CompilerStack::reportCodeGenerationError(
+	Error const& _error,
+	ContractDefinition const* _contractDefinition,
+	ErrorReporter& _errorReporter
+) const
 {
 	solAssert(_error.type() == Error::Type::CodeGenerationError);
 	solAssert(_error.comment(), "Errors must include a message for the user.");
@@ -2041,7 +2574,7 @@ void CompilerStack::reportCodeGenerationError(Error const& _error, ContractDefin
 		solAssert(m_sources.count(*_error.sourceLocation()->sourceName) != 0);
 	solAssert(_contractDefinition);
 
-	m_errorReporter.codeGenerationError(
+	_errorReporter.codeGenerationError(
 		_error.errorId(),
 		(_error.sourceLocation() && _error.sourceLocation()->sourceName) ?
 			*_error.sourceLocation() :
@@ -2050,7 +2583,11 @@ void CompilerStack::reportCodeGenerationError(Error const& _error, ContractDefin
 	);
 }
 
-void CompilerStack::reportIRPostAnalysisError(Error const* _error, ContractDefinition const* _contractDefinition)
+void CompilerStack::reportIRPostAnalysisError(
+	Error const* _error,
+	ContractDefinition const* _contractDefinition,
+	ErrorReporter& _errorReporter
+) const
 {
 	solAssert(_error);
 	solAssert(_error->comment(), "Errors must include a message for the user.");
@@ -2061,7 +2598,7 @@ void CompilerStack::reportIRPostAnalysisError(Error const* _error, ContractDefin
 	if (!Error::isError(_error->severity()))
 		return;
 
-	m_errorReporter.error(
+	_errorReporter.error(
 		_error->errorId(),
 		_error->type(),
 		// Ignore the original location. It's likely missing, but even if not, it points at Yul source.
@@ -48,11 +48,15 @@
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/SharedText.h>
 
 #include <libyul/ObjectOptimizer.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
@@ -76,6 +80,11 @@ namespace solidity::yul
 class YulStack;
 }
 
+namespace solidity::util
+{
+class Profiler;
+}
+
 namespace solidity::frontend
 {
 
@@ -87,6 +96,7 @@ class SourceUnit;
 class Compiler;
 class GlobalContext;
 class Natspec;
+class TypeProvider;
 class DeclarationContainer;
 namespace experimental
 {
@@ -181,6 +191,37 @@ public:
 
 	using ContractSelection = std::map<std::string, std::map<std::string, CompilerStack::PipelineConfig>>;
 
+	/// Code generation results of earlier compilations, which are reused for contracts whose
+	/// sources and relevant settings did not change. See setBuildCache().
+	/// Holds at most one entry per fully qualified contract name. Can be shared by multiple
+	/// compiler stacks, also ones that are used concurrently.
+	class BuildCache
+	{
+	public:
+		size_t size() const;
+		void clear();
+
+	private:
+		friend class CompilerStack;
+
+		struct Entry
+		{
+			util::h256 key;
+			/// Shared with the compiler stacks that stored or restored the entry, hence immutable.
+			std::shared_ptr<evmasm::Assembly const> evmAssembly;
+			std::shared_ptr<evmasm::Assembly const> evmRuntimeAssembly;
+			std::optional<std::string> generatedYulUtilityCode;
+			std::optional<std::string> runtimeGeneratedYulUtilityCode;
+			evmasm::LinkerObject object; ///< Not linked.
+			evmasm::LinkerObject runtimeObject; ///< Not linked.
+			std::optional<std::string> yulIR;
+			std::optional<std::string> yulIROptimized;
+		};
+
+		std::map<std::string, Entry> m_entries;
+		std::mutex mutable m_mutex;
+	};
+
 	/// Creates a new compiler stack.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
@@ -223,6 +264,35 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used to generate code for independent contracts.
+	/// Only the IR optimization and EVM code generation stages of the IR pipeline run concurrently.
+	/// The output does not depend on this setting. Zero means one thread per hardware thread.
+	/// Must be set before compiling.
+	void setParallelism(size_t _threadCount);
+
+	/// Makes the IR pipeline use @a _objectOptimizer, so that its cache of optimized Yul objects
+	/// is shared with other compilations. Must be set before compiling.
+	void setObjectOptimizer(std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer);
+
+	/// Enables the persistent cache of optimized Yul objects in @a _directory, allowing later
+	/// compiler runs to skip optimizing identical objects. An empty path disables it.
+	/// The setting belongs to the current object optimizer, so it is not affected by reset().
+	/// Only affects the IR pipeline. Must be set before compiling.
+	void setOptimizerCacheDirectory(boost::filesystem::path _directory);
+
+	/// Enables reuse of code generation results stored in @a _cache by earlier compilations.
+	/// A requested contract is not compiled again if its metadata, the indices and AST IDs of the
+	/// sources it depends on and all other settings affecting the output are the same.
+	/// Results for all other compiled contracts are stored in the cache after successful compilation.
+	/// Sources are always parsed and analyzed. Has no effect on imported ASTs and experimental analysis.
+	/// Must be set before compiling.
+	void setBuildCache(std::shared_ptr<BuildCache> _cache);
+
+	/// Records the duration of parsing, the analysis passes and the code generation and
+	/// optimization stages of every contract in @a _profiler. Null disables profiling.
+	/// Must be set before compiling.
+	void setProfiler(std::shared_ptr<util::Profiler> _profiler);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -257,6 +327,9 @@ public:
 
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
+	/// Sets the sources without copying their contents, which are shared with the caller.
+	/// Must be set before parsing.
+	void setSourceTexts(std::map<std::string, util::SharedText> _sources);
 
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
@@ -419,6 +492,11 @@ public:
 
 	yul::ObjectOptimizer const& objectOptimizer() const { return *m_objectOptimizer; }
 
+	/// @returns the provider owning all types of this compilation. Code accessing the types
+	/// of the AST outside of the functions of this class should activate it using a
+	/// @a TypeProvider::Scope.
+	TypeProvider& typeProvider() const { return *m_typeProvider; }
+
 private:
 	/// The state per source unit. Filled gradually during parsing.
 	struct Source
@@ -439,14 +517,18 @@ private:
 	{
 		ContractDefinition const* contract = nullptr;
 
-		std::shared_ptr<evmasm::Assembly> evmAssembly;
-		std::shared_ptr<evmasm::Assembly> evmRuntimeAssembly;
+		std::shared_ptr<evmasm::Assembly const> evmAssembly;
+		std::shared_ptr<evmasm::Assembly const> evmRuntimeAssembly;
 		std::optional<std::string> generatedYulUtilityCode; ///< Extra Yul utility code that was used when compiling the creation assembly
 		std::optional<std::string> runtimeGeneratedYulUtilityCode; ///< Extra Yul utility code that was used when compiling the deployed assembly
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::optional<std::string> yulIR; ///< Yul IR code straight from the code generator.
 		std::optional<std::string> yulIROptimized; ///< Reparsed and possibly optimized Yul IR code.
+		/// Analyzed Yul IR handed from IR generation to optimization and from there to EVM code
+		/// generation, so that the IR does not have to be parsed again. Contains the optimized IR
+		/// once @a yulIROptimized is set. Released at the end of compilation.
+		std::shared_ptr<yul::YulStack> yulStack;
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		util::LazyInit<Json const> abi;
 		util::LazyInit<Json const> storageLayout;
@@ -460,10 +542,35 @@ private:
 	void createAndAssignCallGraphs();
 	void findAndReportCyclicContractDependencies();
 
+	/// A source parsed on a worker thread ahead of the sequential pass of parse().
+	struct PreparsedSource
+	{
+		std::shared_ptr<langutil::CharStream> charStream;
+		/// AST with node IDs from a parser of its own.
+		ASTPointer<SourceUnit> ast;
+		/// All nodes created while parsing @a ast, to be renumbered when adopting it.
+		std::vector<ASTPointer<ASTNode>> nodes;
+	};
+	/// Sources parsed by parseConcurrently() and the results of reading their imports.
+	struct PreparsedSources
+	{
+		std::map<std::string, PreparsedSource> sources;
+		std::map<std::string, ReadCallback::Result> readResults;
+	};
+
+	/// Parses the sources and, transitively, their imports on m_parallelism threads, loading
+	/// imports as soon as they are discovered. Sources that cause any error or warning are left
+	/// out so that parse() reports their diagnostics in the usual order.
+	/// The read callback is never invoked concurrently.
+	PreparsedSources parseConcurrently();
+
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
-	/// @a m_readFile
+	/// @a m_readFile unless @a _readResults already contains the result for a source.
 	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast);
+	std::map<std::string, util::SharedText> loadMissingSources(
+		SourceUnit const& _ast,
+		std::map<std::string, ReadCallback::Result> const& _readResults = {}
+	);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	bool resolveImports();
 
@@ -496,8 +603,9 @@ private:
 	/// This function should only be internally called by compileContract and generateEVMFromIR.
 	void assembleYul(
 		ContractDefinition const& _contract,
-		std::shared_ptr<evmasm::Assembly> _assembly,
-		std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+		std::shared_ptr<evmasm::Assembly const> _assembly,
+		std::shared_ptr<evmasm::Assembly const> _runtimeAssembly,
+		langutil::ErrorReporter& _errorReporter
 	);
 
 	/// Compile a single contract.
@@ -518,9 +626,47 @@ private:
 	///     optimized IR, its AST or compilation via IR must not be requested.
 	void generateIR(ContractDefinition const& _contract, bool _unoptimizedOnly);
 
+	/// Runs the IR generated by generateIR through the Yul optimizer and stores the result
+	/// as optimized IR of the contract. Does nothing if optimized IR is already available.
+	/// Does not access the Solidity AST beyond @a _contract and is safe to run concurrently for
+	/// different contracts. The optimizer itself may use up to @a _threadCount threads.
+	void optimizeIR(ContractDefinition const& _contract, size_t _threadCount = 1);
+
 	/// Generate EVM representation for a single contract.
-	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	/// Depends on output generated by optimizeIR.
+	/// Errors are reported to @a _errorReporter.
+	/// The assembly optimizer may use up to @a _threadCount threads.
+	void generateEVMFromIR(ContractDefinition const& _contract, langutil::ErrorReporter& _errorReporter, size_t _threadCount = 1);
+
+	/// Code generation for the IR pipeline with the optimization and EVM code generation of
+	/// independent contracts distributed over m_parallelism threads.
+	/// Contracts are scheduled after the contracts they depend on so that the optimizer cache
+	/// can be reused. Errors are reported in a deterministic order.
+	/// @returns false on error.
+	bool compileViaIRConcurrently();
+
+	/// @returns the build cache keys of all requested contracts that can be deployed, in source order.
+	std::vector<std::pair<ContractDefinition const*, util::h256>> buildCacheKeys() const;
+	/// @returns the key under which the code generation results for @a _contract are stored in
+	/// the build cache.
+	util::h256 buildCacheKey(ContractDefinition const& _contract) const;
+	/// Copies the cached code generation results of contracts with matching keys and reports the
+	/// warnings that generating them would have reported.
+	/// @returns the contracts whose results were restored.
+	std::set<ContractDefinition const*> restoreFromBuildCache(
+		std::vector<std::pair<ContractDefinition const*, util::h256>> const& _keys
+	);
+	/// Stores the code generation results of all contracts in @a _keys that were not restored.
+	/// Must be called before linking.
+	void storeInBuildCache(
+		std::vector<std::pair<ContractDefinition const*, util::h256>> const& _keys,
+		std::set<ContractDefinition const*> const& _restoredContracts
+	) const;
+
+	/// Reports a warning if @a _contract requests ABI coder v1, which the IR pipeline does not support.
+	void reportABICoderV1WithIR(ContractDefinition const& _contract, langutil::ErrorReporter& _errorReporter) const;
+	/// Reports warnings about the bytecode of @a _contract exceeding the limits of the EVM.
+	void reportBytecodeSizeLimits(ContractDefinition const& _contract, langutil::ErrorReporter& _errorReporter) const;
 
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
@@ -529,7 +675,7 @@ private:
 	/// Parses and analyzes specified Yul source and returns the YulStack that can be used to manipulate it.
 	/// Assumes that the IR was generated from sources loaded currently into CompilerStack, which
 	/// means that it is error-free and uses the same settings.
-	yul::YulStack loadGeneratedIR(std::string const& _ir) const;
+	std::unique_ptr<yul::YulStack> loadGeneratedIR(std::string const& _ir) const;
 
 	/// @returns the contract object for the given @a _contractName.
 	/// Can only be called after state is CompilationSuccessful.
@@ -582,20 +728,37 @@ private:
 		langutil::UnimplementedFeatureError const& _error,
 		ContractDefinition const* _contractDefinition = nullptr
 	);
+	void reportUnimplementedFeatureError(
+		langutil::UnimplementedFeatureError const& _error,
+		ContractDefinition const* _contractDefinition,
+		langutil::ErrorReporter& _errorReporter
+	) const;
 	void reportCodeGenerationError(langutil::Error const& _error, ContractDefinition const* _contractDefinition);
-	void reportIRPostAnalysisError(langutil::Error const* _error, ContractDefinition const* _contractDefinition);
+	void reportCodeGenerationError(
+		langutil::Error const& _error,
+		ContractDefinition const* _contractDefinition,
+		langutil::ErrorReporter& _errorReporter
+	) const;
+	void reportIRPostAnalysisError(
+		langutil::Error const* _error,
+		ContractDefinition const* _contractDefinition,
+		langutil::ErrorReporter& _errorReporter
+	) const;
 
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	size_t m_parallelism = 1;
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
 	ContractSelection m_selectedContracts;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
+	/// Declared before the sources so that the types outlive the AST referring to them.
+	std::unique_ptr<TypeProvider> m_typeProvider;
 	std::map<std::string const, Source> m_sources;
 	std::optional<int64_t> m_maxAstId;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
@@ -604,6 +767,8 @@ private:
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
 	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
+	std::shared_ptr<BuildCache> m_buildCache;
+	std::shared_ptr<util::Profiler> m_profiler;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
@@ -32,6 +32,7 @@
 
 using solidity::frontend::ReadCallback;
 using solidity::util::errinfo_comment;
+using solidity::util::readFileAsSharedText;
 using solidity::util::readFileAsString;
 using solidity::util::joinHumanReadable;
 
@@ -159,10 +160,10 @@ ReadCallback::Result FileReader::readFile(std::string const& _kind, std::string
 			return ReadCallback::Result{false, "Not a valid file."};
 
 		// NOTE: we ignore the FileNotFound exception as we manually check above
-		auto contents = readFileAsString(candidates[0]);
+		SourceCode contents = m_mapLargeFiles ? readFileAsSharedText(candidates[0]) : readFileAsString(candidates[0]);
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
 		m_sourceCodes[_sourceUnitName] = contents;
-		return ReadCallback::Result{true, contents};
+		return ReadCallback::Result{true, std::move(contents)};
 	}
 	catch (...)
 	{
@@ -61,6 +61,11 @@ public:
 	void allowDirectory(boost::filesystem::path _path);
 	FileSystemPathSet const& allowedDirectories() const noexcept { return m_allowedDirectories; }
 
+	/// Controls whether @a readFile() maps large files into memory. A mapped file must not be
+	/// truncated while it is in use, so long-running processes should copy files instead.
+	void setMapLargeFiles(bool _mapLargeFiles) noexcept { m_mapLargeFiles = _mapLargeFiles; }
+	bool mapLargeFiles() const noexcept { return m_mapLargeFiles; }
+
 	/// @returns all sources by their internal source unit names.
 	StringMap const& sourceUnits() const noexcept { return m_sourceCodes; }
 
@@ -81,9 +86,11 @@ public:
 	/// and attempts to interpret it as a path and read the corresponding file from disk.
 	/// The read will only succeed if the canonical path of the file is within one of the @a allowedDirectories().
 	/// @param _kind must be equal to "source". Other values are not supported.
-	/// @return Content of the loaded file or an error message. If the operation succeeds, a copy of
-	/// the content is retained in @a sourceUnits() under the key of @a _sourceUnitName. If the key
-	/// already exists, previous content is discarded.
+	/// Large files are mapped into memory instead of being read (see @a util::readFileAsSharedText())
+	/// unless disabled with @a setMapLargeFiles().
+	/// @return Content of the loaded file or an error message. If the operation succeeds, the
+	/// content is also retained in @a sourceUnits() under the key of @a _sourceUnitName, sharing
+	/// its storage with the result. If the key already exists, previous content is discarded.
 	frontend::ReadCallback::Result readFile(std::string const& _kind, std::string const& _sourceUnitName);
 
 	frontend::ReadCallback::Callback reader()
@@ -166,6 +173,9 @@ private:
 
 	/// map of input files to source code strings
 	StringMap m_sourceCodes;
+
+	/// Whether large files are mapped into memory instead of being copied.
+	bool m_mapLargeFiles = true;
 };
 
 }
@@ -17,6 +17,8 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <libsolutil/SharedText.h>
+
 #include <optional>
 #include <string>
 #include <vector>
@@ -26,7 +28,7 @@ namespace solidity::frontend
 
 // Some helper typedefs to make reading the signatures more self explaining.
 using SourceUnitName = std::string;
-using SourceCode = std::string;
+using SourceCode = util::SharedText;
 using ImportPath = std::string;
 
 /// The ImportRemapper is being used on imported file paths for being remapped to source unit IDs before being loaded.
@@ -20,6 +20,8 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/SharedText.h>
+
 #include <functional>
 #include <string>
 
@@ -34,10 +36,11 @@ public:
 	ReadCallback& operator=(ReadCallback const&) = delete;
 
 	/// File reading or generic query result.
+	/// Callbacks that map files into memory can pass them on without copying them.
 	struct Result
 	{
 		bool success;
-		std::string responseOrErrorMessage;
+		util::SharedText responseOrErrorMessage;
 	};
 
 	enum class Kind
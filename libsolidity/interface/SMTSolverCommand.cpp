@@ -19,6 +19,8 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Common.h>
+
 #include <boost/algorithm/string/join.hpp>
 #include <boost/process.hpp>
 
@@ -86,6 +88,18 @@ void SMTSolverCommand::setZ3(std::optional<unsigned int> timeoutInMilliseconds,
 	m_arguments.emplace_back("fp.xform.inline_eager=" + preprocessingArg);
 }
 
+void SMTSolverCommand::setInterrupted(bool _interrupted)
+{
+	std::lock_guard lock(m_processMutex);
+	m_interrupted = _interrupted;
+	if (m_interrupted && m_process)
+	{
+		// Closes the output of the process, which ends the loop reading it.
+		std::error_code error;
+		m_process->terminate(error);
+	}
+}
+
 ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::string const& _query) const
 {
 	try
@@ -103,6 +117,12 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 
 		auto args = m_arguments;
 
+		{
+			std::lock_guard lock(m_processMutex);
+			if (m_interrupted)
+				return ReadCallback::Result{false, "Solver interrupted."};
+		}
+
 		boost::process::opstream in;  // input to subprocess written to by the main process
 		boost::process::ipstream out; // output from subprocess read by the main process
 		boost::process::child solverProcess(
@@ -117,13 +137,34 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 		in.pipe().close();
 		in.close();
 
+		// The process may only be terminated while its output is read. Before, writing to it
+		// would fail and afterwards, it might be reaped here and in setInterrupted() at the same time.
+		{
+			std::lock_guard lock(m_processMutex);
+			if (m_interrupted)
+				return ReadCallback::Result{false, "Solver interrupted."};
+			m_process = &solverProcess;
+		}
+		ScopeGuard resetProcess([&]() {
+			std::lock_guard lock(m_processMutex);
+			m_process = nullptr;
+		});
+
 		std::vector<std::string> data;
 		std::string line;
 		while (!(out.fail() || out.eof()) && std::getline(out, line))
 			if (!line.empty())
 				data.push_back(line);
 
+		bool interrupted = false;
+		{
+			std::lock_guard lock(m_processMutex);
+			m_process = nullptr;
+			interrupted = m_interrupted;
+		}
 		solverProcess.wait();
+		if (interrupted)
+			return ReadCallback::Result{false, "Solver interrupted."};
 
 		return ReadCallback::Result{true, boost::join(data, "\n")};
 	}
@@ -20,6 +20,9 @@
 #include <libsolidity/interface/ReadFile.h>
 
 #include <boost/filesystem.hpp>
+#include <boost/process/child.hpp>
+
+#include <mutex>
 
 namespace solidity::frontend
 {
@@ -40,10 +43,20 @@ public:
 	void setCvc5(std::optional<unsigned int> timeoutInMilliseconds);
 	void setZ3(std::optional<unsigned int> timeoutInMilliseconds, bool _preprocessing, bool _computeInvariants);
 
+	/// Terminates the solver process of a call to @a solve() on another thread and makes
+	/// calls to @a solve() fail while @a _interrupted is true.
+	void setInterrupted(bool _interrupted);
+
 private:
 	/// The name of the solver's binary.
 	std::string m_solverCmd;
 	std::vector<std::string> m_arguments;
+
+	/// Guards the members below, which let another thread interrupt @a solve().
+	mutable std::mutex m_processMutex;
+	/// The solver process while its output is read.
+	mutable boost::process::child* m_process = nullptr;
+	bool m_interrupted = false;
 };
 
 }
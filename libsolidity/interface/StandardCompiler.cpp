@@ -25,6 +25,7 @@
 #include <libsolidity/interface/ImportRemapper.h>
 
 #include <libsolidity/ast/ASTJsonExporter.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libyul/YulStack.h>
 #include <libyul/Exceptions.h>
 #include <libyul/optimiser/Suite.h>
@@ -39,11 +40,13 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace solidity;
 using namespace solidity::yul;
@@ -151,11 +154,11 @@ Json formatErrorWithException(
 }
 
 /// Returns true iff @a _hash (hex with 0x prefix) is the Keccak256 hash of the binary data in @a _content.
-bool hashMatchesContent(std::string const& _hash, std::string const& _content)
+bool hashMatchesContent(std::string const& _hash, std::string_view _content)
 {
 	try
 	{
-		return util::h256(_hash) == util::keccak256(_content);
+		return util::h256(_hash) == util::keccak256(bytesConstRef(reinterpret_cast<uint8_t const*>(_content.data()), _content.size()));
 	}
 	catch (util::BadHexCharacter const&)
 	{
@@ -406,13 +409,13 @@ std::optional<Json> checkAuxiliaryInputKeys(Json const& _input)
 
 std::optional<Json> checkSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"debug", "evmVersion", "eofVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static std::set<std::string> keys{"debug", "evmVersion", "eofVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "profile", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json> checkModelCheckerSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
+	static std::set<std::string> keys{"bmcLoopIterations", "chcThreads", "contracts", "crossCheckSolvers", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -658,7 +661,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 						"Mismatch between content and supplied hash for \"" + sourceName + "\""
 					));
 				else
-					ret.sources[sourceName] = content;
+					ret.sources[sourceName] = std::move(content);
 			}
 			else if (sourceValue["urls"].is_array())
 			{
@@ -685,14 +688,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 							));
 						else
 						{
-							ret.sources[sourceName] = result.responseOrErrorMessage;
+							ret.sources[sourceName] = result.responseOrErrorMessage.str();
 							found = true;
 							break;
 						}
 					}
 					else
 						failures.push_back(
-							"Cannot import url (\"" + url.get<std::string>() + "\"): " + result.responseOrErrorMessage
+							"Cannot import url (\"" + url.get<std::string>() + "\"): " + result.responseOrErrorMessage.str()
 						);
 				}
 
@@ -797,6 +800,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.viaIR = settings["viaIR"].get<bool>();
 	}
 
+	if (settings.contains("parallelism"))
+	{
+		if (!settings["parallelism"].is_number_unsigned())
+			return formatFatalError(Error::Type::JSONError, "\"settings.parallelism\" must be an unsigned integer.");
+		ret.parallelism = settings["parallelism"].get<size_t>();
+	}
+
+	if (settings.contains("profile"))
+	{
+		if (!settings["profile"].is_boolean())
+			return formatFatalError(Error::Type::JSONError, "\"settings.profile\" must be a Boolean.");
+		ret.profile = settings["profile"].get<bool>();
+	}
+
 	if (settings.contains("evmVersion"))
 	{
 		if (!settings["evmVersion"].is_string())
@@ -1011,6 +1028,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.contracts = {std::move(sourceContracts)};
 	}
 
+	if (modelCheckerSettings.contains("crossCheckSolvers"))
+	{
+		auto const& crossCheckSolvers = modelCheckerSettings["crossCheckSolvers"];
+		if (!crossCheckSolvers.is_boolean())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.crossCheckSolvers must be a Boolean value.");
+		ret.modelCheckerSettings.crossCheckSolvers = crossCheckSolvers.get<bool>();
+	}
+
 	if (modelCheckerSettings.contains("divModNoSlacks"))
 	{
 		auto const& divModNoSlacks = modelCheckerSettings["divModNoSlacks"];
@@ -1039,6 +1064,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.bmcLoopIterations must be an unsigned integer.");
 	}
 
+	if (modelCheckerSettings.contains("chcThreads"))
+	{
+		auto const& chcThreads = modelCheckerSettings["chcThreads"];
+		if (!chcThreads.is_number_unsigned() || chcThreads.get<unsigned>() == 0)
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.chcThreads must be a positive integer.");
+		ret.modelCheckerSettings.chcThreads = chcThreads.get<unsigned>();
+	}
+
 	if (modelCheckerSettings.contains("extCalls"))
 	{
 		if (!modelCheckerSettings["extCalls"].is_string())
@@ -1277,11 +1310,15 @@ Json StandardCompiler::importEVMAssembly(StandardCompiler::InputsAndSettings _in
 	return util::removeNullMembers(output);
 }
 
-Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, DeferredASTs* _deferredASTs)
 {
 	solAssert(_inputsAndSettings.jsonSources.empty());
 
-	CompilerStack compilerStack(m_readFile);
+	// Allocated separately so that it can outlive this function if the conversion of the ASTs is deferred.
+	auto ownedCompilerStack = std::make_unique<CompilerStack>(m_readFile);
+	CompilerStack& compilerStack = *ownedCompilerStack;
+	// The outputs below are partly generated directly from the AST, which may create types.
+	TypeProvider::Scope typeProviderScope(compilerStack.typeProvider());
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	if (_inputsAndSettings.language == "Solidity")
@@ -1289,6 +1326,15 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	if (m_objectOptimizer)
+		compilerStack.setObjectOptimizer(m_objectOptimizer);
+	compilerStack.setOptimizerCacheDirectory(m_optimizerCacheDirectory);
+	compilerStack.setBuildCache(m_buildCache);
+	std::shared_ptr<util::Profiler> profiler;
+	if (_inputsAndSettings.profile)
+		profiler = std::make_shared<util::Profiler>();
+	compilerStack.setProfiler(profiler);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setEOFVersion(_inputsAndSettings.eofVersion);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
@@ -1428,7 +1474,15 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			Json sourceResult;
 			sourceResult["id"] = sourceIndex++;
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			{
+				if (_deferredASTs)
+				{
+					sourceResult["ast"] = util::JsonStreamWriter::deferredValue(_deferredASTs->sourceUnits.size());
+					_deferredASTs->sourceUnits.push_back(&compilerStack.ast(sourceName));
+				}
+				else
+					sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			}
 			output["sources"][sourceName] = sourceResult;
 		}
 
@@ -1549,6 +1603,15 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (profiler)
+		output["profile"] = profiler->chromeTrace();
+
+	if (_deferredASTs && !_deferredASTs->sourceUnits.empty())
+	{
+		_deferredASTs->compilerStack = std::move(ownedCompilerStack);
+		_deferredASTs->yulStringUsage = std::make_unique<YulStringRepository::Usage>();
+	}
+
 	return output;
 }
 
@@ -1597,6 +1660,11 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		return output;
 	}
 
+	std::unique_ptr<util::Profiler> profiler;
+	if (_inputsAndSettings.profile)
+		profiler = std::make_unique<util::Profiler>();
+	util::Profiler::Scope profilerScope(profiler.get());
+
 	YulStack stack(
 		_inputsAndSettings.evmVersion,
 		_inputsAndSettings.eofVersion,
@@ -1604,7 +1672,9 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		_inputsAndSettings.optimiserSettings,
 		_inputsAndSettings.debugInfoSelection.has_value() ?
 			_inputsAndSettings.debugInfoSelection.value() :
-			DebugInfoSelection::Default()
+			DebugInfoSelection::Default(),
+		nullptr, // _soliditySourceProvider
+		m_objectOptimizer
 	);
 	std::string const& sourceName = _inputsAndSettings.sources.begin()->first;
 	std::string const& sourceContents = _inputsAndSettings.sources.begin()->second;
@@ -1700,12 +1770,43 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "yulCFGJson", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["yulCFGJson"] = stack.cfgJson();
 
+	if (profiler)
+		output["profile"] = profiler->chromeTrace();
+
 	return output;
 }
 
+void StandardCompiler::setObjectOptimizer(
+	std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer,
+	size_t _maxCachedObjects
+)
+{
+	m_objectOptimizer = std::move(_objectOptimizer);
+	m_maxCachedObjects = _maxCachedObjects;
+	if (!m_objectOptimizer)
+		m_objectOptimizerYulStringUsage.reset();
+	else if (!m_objectOptimizerYulStringUsage)
+		m_objectOptimizerYulStringUsage = std::make_unique<YulStringRepository::Usage>();
+}
+
 Json StandardCompiler::compile(Json const& _input) noexcept
 {
-	YulStringRepository::reset();
+	return compile(_input, nullptr);
+}
+
+Json StandardCompiler::compile(Json const& _input, DeferredASTs* _deferredASTs) noexcept
+{
+	if (m_objectOptimizer && m_objectOptimizer->size() > m_maxCachedObjects)
+	{
+		// Releasing the cached objects is the only way to free the YulStrings they refer to.
+		m_objectOptimizer->clear();
+		m_objectOptimizerYulStringUsage.reset();
+	}
+	// Other threads might be compiling at the same time, so only reset if nobody else uses YulStrings.
+	YulStringRepository::resetIfUnused();
+	YulStringRepository::Usage yulStringUsage;
+	if (m_objectOptimizer && !m_objectOptimizerYulStringUsage)
+		m_objectOptimizerYulStringUsage = std::make_unique<YulStringRepository::Usage>();
 
 	try
 	{
@@ -1714,11 +1815,11 @@ Json StandardCompiler::compile(Json const& _input) noexcept
 			return std::get<Json>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _deferredASTs);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else if (settings.language == "SolidityAST")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _deferredASTs);
 		else if (settings.language == "EVMAssembly")
 			return importEVMAssembly(std::move(settings));
 		else
@@ -1753,12 +1854,15 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 	}
 
 //	std::cout << "Input: " << solidity::util::jsonPrettyPrint(input) << std::endl;
-	Json output = compile(input);
+	DeferredASTs deferredASTs;
+	Json output = compile(input, &deferredASTs);
 //	std::cout << "Output: " << solidity::util::jsonPrettyPrint(output) << std::endl;
 
 	try
 	{
-		return util::jsonPrint(output, m_jsonPrintingFormat);
+		std::ostringstream serializedOutput;
+		writeOutput(serializedOutput, output, deferredASTs);
+		return serializedOutput.str();
 	}
 	catch (...)
 	{
@@ -1766,6 +1870,26 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 	}
 }
 
+void StandardCompiler::writeOutput(std::ostream& _stream, Json const& _output, DeferredASTs const& _deferredASTs) const
+{
+	if (!_deferredASTs.compilerStack)
+	{
+		_stream << util::jsonPrint(_output, m_jsonPrintingFormat);
+		return;
+	}
+
+	util::JsonStreamWriter writer(_stream, m_jsonPrintingFormat);
+	CompilerStack const& compilerStack = *_deferredASTs.compilerStack;
+	// Writing the ASTs may create types, just like converting them during the compilation.
+	TypeProvider::Scope typeProviderScope(compilerStack.typeProvider());
+	writer.value(_output, [&](util::JsonStreamWriter& _writer, uint64_t _index) {
+		ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).print(
+			_writer,
+			*_deferredASTs.sourceUnits.at(_index)
+		);
+	});
+}
+
 Json StandardCompiler::formatFunctionDebugData(
 	std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
@@ -28,9 +28,13 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <libyul/YulString.h>
+
+#include <memory>
 #include <optional>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -61,8 +65,29 @@ public:
 	Json compile(Json const& _input) noexcept;
 	/// Parses input as JSON and performs the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
+	/// The requested ASTs are written directly to the output instead of being converted to JSON first.
 	std::string compile(std::string const& _input) noexcept;
 
+	/// Default bound on the number of optimized Yul objects kept by a shared object optimizer.
+	static size_t constexpr defaultMaxCachedObjects = 1000;
+
+	/// Makes all subsequent compilations share @a _objectOptimizer and with it the optimized Yul objects it caches.
+	/// Keeps the YulString repository from being reset for as long as the optimizer caches objects.
+	/// Once it caches more than @a _maxCachedObjects, its cache is cleared at the start of the next
+	/// compilation and the repository is reset, so that memory use stays bounded.
+	void setObjectOptimizer(
+		std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer,
+		size_t _maxCachedObjects = defaultMaxCachedObjects
+	);
+
+	/// Enables the persistent cache of optimized Yul objects for all subsequent compilations.
+	/// See CompilerStack::setOptimizerCacheDirectory().
+	void setOptimizerCacheDirectory(boost::filesystem::path _directory) { m_optimizerCacheDirectory = std::move(_directory); }
+
+	/// Reuses code generation results of earlier compilations stored in @a _cache and stores new ones there.
+	/// See CompilerStack::setBuildCache().
+	void setBuildCache(std::shared_ptr<CompilerStack::BuildCache> _cache) { m_buildCache = std::move(_cache); }
+
 	static Json formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 	);
@@ -89,19 +114,46 @@ private:
 		Json outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		bool profile = false;
 	};
 
+	/// ASTs left out of the output of @a compileSolidity() as placeholders, which are only converted
+	/// while the output is written. Keeps the compiler stack owning the ASTs and the YulStrings
+	/// referenced by their inline assembly blocks alive until then.
+	struct DeferredASTs
+	{
+		std::unique_ptr<CompilerStack> compilerStack;
+		std::unique_ptr<yul::YulStringRepository::Usage> yulStringUsage;
+		std::vector<SourceUnit const*> sourceUnits;
+	};
+
+	/// Performs the processing steps of the public overload, deferring the conversion of the ASTs
+	/// to @a _deferredASTs if it is given.
+	Json compile(Json const& _input, DeferredASTs* _deferredASTs) noexcept;
+	/// Writes @a _output to @a _stream, converting the deferred ASTs on the way.
+	void writeOutput(std::ostream& _stream, Json const& _output, DeferredASTs const& _deferredASTs) const;
+
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json> parseInput(Json const& _input);
 
 	std::map<std::string, Json> parseAstFromInput(StringMap const& _sources);
 	Json importEVMAssembly(InputsAndSettings _inputsAndSettings);
-	Json compileSolidity(InputsAndSettings _inputsAndSettings);
+	Json compileSolidity(InputsAndSettings _inputsAndSettings, DeferredASTs* _deferredASTs = nullptr);
 	Json compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
 
+	/// The ASTs cached by @a m_objectOptimizer refer to YulStrings and dialects, which are
+	/// invalidated when the YulString repository is reset between compilations.
+	/// Declared first so that it is released only after the cache is gone.
+	std::unique_ptr<yul::YulStringRepository::Usage> m_objectOptimizerYulStringUsage;
+	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
+	size_t m_maxCachedObjects = defaultMaxCachedObjects;
+	boost::filesystem::path m_optimizerCacheDirectory;
+	std::shared_ptr<CompilerStack::BuildCache> m_buildCache;
+
 	util::JsonFormat m_jsonPrintingFormat;
 };
 
@@ -163,7 +163,10 @@ frontend::ReadCallback::Result FileRepository::readFile(std::string const& _kind
 		std::string const strippedSourceUnitName = stripFileUriSchemePrefix(_sourceUnitName);
 		Result<boost::filesystem::path> const resolvedPath = tryResolvePath(strippedSourceUnitName);
 		if (!resolvedPath.message().empty())
+		{
+			m_missingSourceUnits.insert(_sourceUnitName);
 			return ReadCallback::Result{false, resolvedPath.message()};
+		}
 
 		auto contents = readFileAsString(resolvedPath.get());
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <map>
+#include <set>
 
 namespace solidity::lsp
 {
@@ -57,6 +58,9 @@ public:
 
 	util::Result<boost::filesystem::path> tryResolvePath(std::string const& _sourceUnitName) const;
 
+	/// @returns the source unit names that the read callback could not find.
+	std::set<std::string> const& missingSourceUnits() const noexcept { return m_missingSourceUnits; }
+
 private:
 	/// Base path without URI scheme.
 	boost::filesystem::path m_basePath;
@@ -69,6 +73,9 @@ private:
 
 	/// Mapping of source unit names to their file content.
 	StringMap m_sourceCodes;
+
+	/// Source unit names that could not be resolved to a file by the read callback.
+	std::set<std::string> m_missingSourceUnits;
 };
 
 }
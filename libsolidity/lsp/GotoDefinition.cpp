@@ -54,7 +54,7 @@ void GotoDefinition::operator()(MessageID _id, Json const& _args)
 	else if (auto const* importDirective = dynamic_cast<ImportDirective const*>(sourceNode))
 	{
 		auto const& path = *importDirective->annotation().absolutePath;
-		if (fileRepository().sourceUnits().count(path))
+		if (m_server.compiledSources().count(path))
 			locations.emplace_back(SourceLocation{0, 0, std::make_shared<std::string const>(path)});
 	}
 
@@ -56,7 +56,7 @@ std::pair<std::string, LineColumn> HandlerBase::extractSourceUnitNameAndLineColu
 {
 	std::string const uri = _args["textDocument"]["uri"].get<std::string>();
 	std::string const sourceUnitName = fileRepository().uriToSourceUnitName(uri);
-	if (!fileRepository().sourceUnits().count(sourceUnitName))
+	if (!m_server.compiledSources().count(sourceUnitName))
 		BOOST_THROW_EXCEPTION(
 			RequestError(ErrorCode::RequestFailed) <<
 			errinfo_comment("Unknown file: " + uri)
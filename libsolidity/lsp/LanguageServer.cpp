@@ -18,6 +18,8 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/ASTUtils.h>
 #include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/interface/FileReader.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/lsp/LanguageServer.h>
@@ -34,6 +36,7 @@
 #include <liblangutil/CharStream.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/StringUtils.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/JSON.h>
 
@@ -59,6 +62,9 @@ namespace fs = boost::filesystem;
 namespace
 {
 
+/// ID of the registration of the file watcher and of the request for it.
+std::string const c_watchedFilesRegistrationID = "solc-watched-files";
+
 bool resolvesToRegularFile(boost::filesystem::path _path, int maxRecursionDepth = 10)
 {
 	fs::file_status fileStatus = fs::status(_path);
@@ -141,29 +147,55 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"initialized", std::bind(&LanguageServer::handleInitialized, this, _1, _2)},
 		{"$/setTrace", [this](auto, Json const& args) { setTrace(args["value"]); }},
 		{"shutdown", [this](auto, auto) { m_state = State::ShutdownRequested; }},
-		{"textDocument/definition", GotoDefinition(*this) },
+		{"textDocument/definition", withSnapshotTypes(GotoDefinition(*this)) },
 		{"textDocument/didOpen", std::bind(&LanguageServer::handleTextDocumentDidOpen, this, _2)},
 		{"textDocument/didChange", std::bind(&LanguageServer::handleTextDocumentDidChange, this, _2)},
 		{"textDocument/didClose", std::bind(&LanguageServer::handleTextDocumentDidClose, this, _2)},
-		{"textDocument/hover", DocumentHoverHandler(*this) },
-		{"textDocument/rename", RenameSymbol(*this) },
-		{"textDocument/implementation", GotoDefinition(*this) },
-		{"textDocument/semanticTokens/full", std::bind(&LanguageServer::semanticTokensFull, this, _1, _2)},
+		{"textDocument/hover", withSnapshotTypes(DocumentHoverHandler(*this)) },
+		{"textDocument/rename", withSnapshotTypes(RenameSymbol(*this)) },
+		{"textDocument/implementation", withSnapshotTypes(GotoDefinition(*this)) },
+		{"textDocument/semanticTokens/full", withSnapshotTypes(std::bind(&LanguageServer::semanticTokensFull, this, _1, _2))},
 		{"workspace/didChangeConfiguration", std::bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
+		{"workspace/didChangeWatchedFiles", std::bind(&LanguageServer::handleWorkspaceDidChangeWatchedFiles, this, _2)},
 	},
 	m_fileRepository("/" /* basePath */, {} /* no search paths */),
-	m_compilerStack{m_fileRepository.reader()}
+	m_snapshot(std::make_shared<Snapshot const>(m_fileRepository.basePath(), m_fileRepository.includePaths())),
+	m_latestSnapshot(m_snapshot),
+	m_compilationThread([this]() { compilationLoop(); })
 {
 }
 
-Json LanguageServer::toRange(SourceLocation const& _location)
+LanguageServer::~LanguageServer()
 {
-	return HandlerBase(*this).toRange(_location);
+	{
+		std::lock_guard lock(m_compilationMutex);
+		m_stopCompiling = true;
+		m_compilationCancelled = true;
+	}
+	m_compilationRequested.notify_all();
+	m_compilationThread.join();
+}
+
+Json LanguageServer::toRange(Snapshot const& _snapshot, SourceLocation const& _location)
+{
+	if (!_location.hasText())
+		return toJsonRange({}, {});
+
+	solAssert(_location.sourceName);
+	CharStream const& stream = _snapshot.compilerStack.charStream(*_location.sourceName);
+	return toJsonRange(
+		stream.translatePositionToLineColumn(_location.start),
+		stream.translatePositionToLineColumn(_location.end)
+	);
 }
 
-Json LanguageServer::toJson(SourceLocation const& _location)
+Json LanguageServer::toJson(Snapshot const& _snapshot, SourceLocation const& _location)
 {
-	return HandlerBase(*this).toJson(_location);
+	solAssert(_location.sourceName);
+	Json item;
+	item["uri"] = _snapshot.fileRepository.sourceUnitNameToUri(*_location.sourceName);
+	item["range"] = toRange(_snapshot, _location);
+	return item;
 }
 
 void LanguageServer::changeConfiguration(Json const& _settings)
@@ -189,6 +221,10 @@ void LanguageServer::changeConfiguration(Json const& _settings)
 	}
 
 	m_settingsObject = _settings;
+	// The settings can change the set of project files and how imports are resolved.
+	m_projectFilesStale = true;
+	m_compilationOutdated = true;
+
 	Json jsonIncludePaths = _settings.contains("include-paths") ? _settings["include-paths"] : Json::object();
 
 	if (!jsonIncludePaths.empty())
@@ -214,7 +250,7 @@ void LanguageServer::changeConfiguration(Json const& _settings)
 	}
 }
 
-std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject() const
+std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject(fs::path const& _basePath) const
 {
 	std::vector<fs::path> collectedPaths{};
 
@@ -222,9 +258,9 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	// open for a future PR to enable such a feature to be optionally enabled (default disabled).
 	// Note: Newer versions of boost have deprecated symlink_option::recurse
 #if (BOOST_VERSION < 107200)
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::symlink_option::recurse);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::symlink_option::recurse);
 #else
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::directory_options::follow_directory_symlink);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::directory_options::follow_directory_symlink);
 #endif
 	for (fs::directory_entry const& dirEntry: directoryIterator)
 		if (
@@ -236,52 +272,263 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	return collectedPaths;
 }
 
-void LanguageServer::compile()
+void LanguageServer::loadProjectFiles(CompilationRequest& _request, FileRepository const& _fileRepository)
+{
+	std::map<std::string, std::string> projectFiles;
+	for (auto const& projectFile: allSolidityFilesFromProject(_request.basePath))
+		projectFiles[_fileRepository.sourceUnitNameToUri(projectFile.generic_string())] =
+			util::readFileAsString(projectFile);
+
+	// Open files are compiled with the contents provided by the client, not with those on disk.
+	auto const changedAndNotOpen = [&](auto const& _files, auto const& _otherFiles) {
+		for (auto const& [uri, contents]: _files)
+			if (!_request.openFiles.count(uri))
+				if (std::string const* otherContents = util::valueOrNullptr(_otherFiles, uri); !otherContents || *otherContents != contents)
+					return true;
+		return false;
+	};
+	if (changedAndNotOpen(projectFiles, m_projectFiles) || changedAndNotOpen(m_projectFiles, projectFiles))
+		_request.outdated = true;
+
+	m_projectFiles = std::move(projectFiles);
+}
+
+bool LanguageServer::importedFilesChangedOnDisk(CompilationRequest const& _request, Snapshot const& _snapshot) const
+{
+	FileRepository const& fileRepository = _snapshot.fileRepository;
+	std::set<std::string> sourceUnitsNotReadFromDisk;
+	for (std::string const& uri: _request.openFiles | ranges::views::keys)
+		sourceUnitsNotReadFromDisk.insert(fileRepository.uriToSourceUnitName(uri));
+	if (_request.fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
+		for (std::string const& uri: m_projectFiles | ranges::views::keys)
+			sourceUnitsNotReadFromDisk.insert(fileRepository.uriToSourceUnitName(uri));
+
+	auto const watched = [&](boost::filesystem::path const& _path) {
+		return
+			!_request.watchedDirectory.empty() &&
+			FileReader::isPathPrefix(
+				FileReader::normalizeCLIPathForVFS(_request.watchedDirectory),
+				FileReader::normalizeCLIPathForVFS(_path)
+			);
+	};
+
+	for (auto const& [sourceUnitName, contents]: fileRepository.sourceUnits())
+		if (!sourceUnitsNotReadFromDisk.count(sourceUnitName))
+		{
+			auto const resolvedPath = fileRepository.tryResolvePath(stripFileUriSchemePrefix(sourceUnitName));
+			if (!resolvedPath.message().empty())
+				return true;
+			if (watched(resolvedPath.get()))
+				continue;
+			try
+			{
+				if (util::readFileAsString(resolvedPath.get()) != contents)
+					return true;
+			}
+			catch (...)
+			{
+				// Let the compilation report the error.
+				return true;
+			}
+		}
+
+	for (std::string const& sourceUnitName: fileRepository.missingSourceUnits())
+		if (
+			auto const resolvedPath = fileRepository.tryResolvePath(stripFileUriSchemePrefix(sourceUnitName));
+			resolvedPath.message().empty() && !watched(resolvedPath.get())
+		)
+			return true;
+
+	return false;
+}
+
+void LanguageServer::CompilationRequest::includeOlder(CompilationRequest const& _older)
+{
+	dirtySourceUnits += _older.dirtySourceUnits;
+	outdated = outdated || _older.outdated;
+	reloadProjectFiles = reloadProjectFiles || _older.reloadProjectFiles;
+	// Changes outside of the watched directory might have been missed by the older request.
+	if (_older.watchedDirectory != watchedDirectory)
+		watchedDirectory.clear();
+}
+
+std::shared_ptr<LanguageServer::Snapshot const> LanguageServer::compile(
+	CompilationRequest& _request,
+	std::shared_ptr<Snapshot const> const& _previous
+)
 {
-	// For files that are not open, we have to take changes on disk into account,
-	// so we just remove all non-open files.
+	auto snapshot = std::make_shared<Snapshot>(_request.basePath, _request.includePaths);
+	FileRepository& fileRepository = snapshot->fileRepository;
 
-	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
-	std::swap(oldRepository, m_fileRepository);
+	// Without notifications from the client, we have to check the files that are not open for changes
+	// on disk before every compilation.
+	if (_request.fileLoadStrategy == FileLoadStrategy::ProjectDirectory && (_request.reloadProjectFiles || m_projectFiles.empty()))
+		loadProjectFiles(_request, fileRepository);
+	if (!_request.outdated && importedFilesChangedOnDisk(_request, *_previous))
+		_request.outdated = true;
 
 	// Load all solidity files from project.
-	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		for (auto const& projectFile: allSolidityFilesFromProject())
+	if (_request.fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
+		for (auto const& [uri, contents]: m_projectFiles)
 		{
-			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
-			m_fileRepository.setSourceByUri(
-				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
-				util::readFileAsString(projectFile)
-			);
+			lspDebug(fmt::format("adding project file: {}", uri));
+			fileRepository.setSourceByUri(uri, contents);
 		}
 
 	// Overwrite all files as opened by the client, including the ones which might potentially have changes.
-	for (std::string const& fileName: m_openFiles)
-		m_fileRepository.setSourceByUri(
-			fileName,
-			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
-		);
+	for (auto const& [uri, contents]: _request.openFiles)
+		fileRepository.setSourceByUri(uri, contents);
+
+	if (!_request.outdated)
+	{
+		// Opening or closing a file does not necessarily change its contents.
+		StringMap const& previousSources = _previous->fileRepository.sourceUnits();
+		for (auto it = _request.dirtySourceUnits.begin(); it != _request.dirtySourceUnits.end();)
+		{
+			std::string const* contents = util::valueOrNullptr(fileRepository.sourceUnits(), *it);
+			std::string const* previousContents = util::valueOrNullptr(previousSources, *it);
+			if (contents && previousContents && *contents == *previousContents)
+				it = _request.dirtySourceUnits.erase(it);
+			else
+				++it;
+		}
+		if (_request.dirtySourceUnits.empty())
+		{
+			lspDebug("Reusing the last compilation since no source changed.");
+			return _previous;
+		}
+	}
+	lspDebug(fmt::format(
+		"Recompiling due to changes in: {}",
+		_request.outdated ? "files on disk or settings"s : util::joinHumanReadable(_request.dirtySourceUnits)
+	));
+
+	// Parsing and analysis cannot be interrupted, but a compilation that became stale while
+	// parsing is dropped before the analysis.
+	CompilerStack& compilerStack = snapshot->compilerStack;
+	compilerStack.setSources(fileRepository.sourceUnits());
+	bool const parsed = compilerStack.parse();
+	if (m_compilationCancelled)
+		return nullptr;
+	if (parsed)
+		compilerStack.analyze();
+
+	return snapshot;
+}
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+void LanguageServer::compilationLoop()
+{
+	// Changes arriving within this time of each other are compiled together.
+	auto constexpr compilationDelay = std::chrono::milliseconds(100);
 
-	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+	// The changes of a compilation that failed are compiled again together with the next ones.
+	std::optional<CompilationRequest> failedRequest;
+
+	std::unique_lock lock(m_compilationMutex);
+	while (true)
+	{
+		m_compilationRequested.wait(lock, [&]() { return m_stopCompiling || m_pendingCompilation; });
+		while (!m_stopCompiling && std::chrono::steady_clock::now() < m_lastCompilationRequest + compilationDelay)
+			m_compilationRequested.wait_until(lock, m_lastCompilationRequest + compilationDelay);
+		if (m_stopCompiling)
+			return;
+
+		CompilationRequest request = std::move(*m_pendingCompilation);
+		m_pendingCompilation.reset();
+		if (failedRequest)
+		{
+			request.includeOlder(*failedRequest);
+			failedRequest.reset();
+		}
+		m_compilationCancelled = false;
+		std::shared_ptr<Snapshot const> snapshot = m_latestSnapshot;
+		lock.unlock();
+
+		bool failed = false;
+		try
+		{
+			snapshot = compile(request, snapshot);
+		}
+		catch (...)
+		{
+			m_client.trace("Compilation failed: "s + boost::current_exception_diagnostic_information());
+			failed = true;
+		}
+
+		lock.lock();
+		if (failed)
+		{
+			// Retrying right away would most likely fail again, so wait for the next change.
+			failedRequest = std::move(request);
+			continue;
+		}
+		if (!snapshot)
+		{
+			// The changes of the cancelled compilation are compiled together with the more recent ones.
+			if (m_pendingCompilation)
+				m_pendingCompilation->includeOlder(request);
+			else
+				m_pendingCompilation = std::move(request);
+			continue;
+		}
+		// Requests handled after this point are answered from the new snapshot, so it has to be
+		// available before the client learns about it through the diagnostics.
+		m_latestSnapshot = snapshot;
+		lock.unlock();
+
+		try
+		{
+			publishDiagnostics(*snapshot);
+		}
+		catch (...)
+		{
+			m_client.trace("Publishing diagnostics failed: "s + boost::current_exception_diagnostic_information());
+		}
+
+		lock.lock();
+	}
 }
 
 void LanguageServer::compileAndUpdateDiagnostics()
 {
-	compile();
+	CompilationRequest request;
+	request.basePath = m_fileRepository.basePath();
+	request.includePaths = m_fileRepository.includePaths();
+	request.fileLoadStrategy = m_fileLoadStrategy;
+	for (std::string const& uri: m_openFiles)
+		request.openFiles[uri] = m_fileRepository.sourceUnits().at(m_fileRepository.uriToSourceUnitName(uri));
+	request.dirtySourceUnits = std::move(m_dirtySourceUnits);
+	request.outdated = m_compilationOutdated;
+	request.reloadProjectFiles = m_projectFilesStale || !m_watchingFiles;
+	if (m_watchingFiles)
+		// The watcher pattern is relative to the workspace root, which is the base path.
+		request.watchedDirectory = m_fileRepository.basePath();
+	m_dirtySourceUnits.clear();
+	m_compilationOutdated = false;
+	m_projectFilesStale = false;
 
+	{
+		std::lock_guard lock(m_compilationMutex);
+		if (m_pendingCompilation)
+			request.includeOlder(*m_pendingCompilation);
+		m_pendingCompilation = std::move(request);
+		m_lastCompilationRequest = std::chrono::steady_clock::now();
+		m_compilationCancelled = true;
+	}
+	m_compilationRequested.notify_all();
+}
+
+void LanguageServer::publishDiagnostics(Snapshot const& _snapshot)
+{
 	// These are the source units we will sent diagnostics to the client for sure,
 	// even if it is just to clear previous diagnostics.
 	std::map<std::string, Json> diagnosticsBySourceUnit;
-	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
+	for (std::string const& sourceUnitName: _snapshot.fileRepository.sourceUnits() | ranges::views::keys)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
 	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
 
-	for (std::shared_ptr<Error const> const& error: m_compilerStack.errors())
+	for (std::shared_ptr<Error const> const& error: _snapshot.compilerStack.errors())
 	{
 		SourceLocation const* location = error->sourceLocation();
 		if (!location || !location->sourceName)
@@ -296,14 +543,14 @@ void LanguageServer::compileAndUpdateDiagnostics()
 		if (std::string const* comment = error->comment())
 			message += " " + *comment;
 		jsonDiag["message"] = std::move(message);
-		jsonDiag["range"] = toRange(*location);
+		jsonDiag["range"] = toRange(_snapshot, *location);
 
 		if (auto const* secondary = error->secondarySourceLocation())
 			for (auto&& [secondaryMessage, secondaryLocation]: secondary->infos)
 			{
 				Json jsonRelated;
 				jsonRelated["message"] = secondaryMessage;
-				jsonRelated["location"] = toJson(secondaryLocation);
+				jsonRelated["location"] = toJson(_snapshot, secondaryLocation);
 				jsonDiag["relatedInformation"].emplace_back(jsonRelated);
 			}
 
@@ -321,12 +568,20 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
 	{
 		Json params;
-		params["uri"] = m_fileRepository.sourceUnitNameToUri(sourceUnitName);
+		params["uri"] = _snapshot.fileRepository.sourceUnitNameToUri(sourceUnitName);
 		if (!diagnostics.empty())
 			m_nonemptyDiagnostics.insert(sourceUnitName);
 		params["diagnostics"] = std::move(diagnostics);
 		m_client.notify("textDocument/publishDiagnostics", std::move(params));
 	}
+
+	// The semantic tokens the client requested before might be based on an older compilation.
+	if (m_clientCanRefreshSemanticTokens)
+		m_client.request(
+			"solc-semantic-tokens-refresh-" + std::to_string(++m_semanticTokensRefreshCount),
+			"workspace/semanticTokens/refresh",
+			Json()
+		);
 }
 
 bool LanguageServer::run()
@@ -347,11 +602,18 @@ bool LanguageServer::run()
 					id = (*jsonMessage)["id"];
 				lspDebug(fmt::format("received method call: {}", methodName));
 
+				// The request is answered from the most recent compilation that finished.
+				{
+					std::lock_guard lock(m_compilationMutex);
+					m_snapshot = m_latestSnapshot;
+				}
 				if (auto handler = util::valueOrDefault(m_handlers, methodName))
 					handler(id, (*jsonMessage)["params"]);
 				else
 					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
 			}
+			else if ((*jsonMessage).contains("id") && ((*jsonMessage).contains("result") || (*jsonMessage).contains("error")))
+				handleResponse((*jsonMessage)["id"], *jsonMessage);
 			else
 				m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
 		}
@@ -409,6 +671,11 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 	if (_args.contains("trace"))
 		setTrace(_args["trace"]);
 
+	std::optional<Json> const canWatchFiles = util::jsonValueByPath(_args, "capabilities.workspace.didChangeWatchedFiles.dynamicRegistration");
+	m_clientCanWatchFiles = canWatchFiles && canWatchFiles->is_boolean() && canWatchFiles->get<bool>();
+	std::optional<Json> const canRefreshSemanticTokens = util::jsonValueByPath(_args, "capabilities.workspace.semanticTokens.refreshSupport");
+	m_clientCanRefreshSemanticTokens = canRefreshSemanticTokens && canRefreshSemanticTokens->is_boolean() && canRefreshSemanticTokens->get<bool>();
+
 	m_fileRepository = FileRepository(rootPath, {});
 	if (_args.contains("initializationOptions") && _args["initializationOptions"].is_object())
 		changeConfiguration(_args["initializationOptions"]);
@@ -431,22 +698,46 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 
 void LanguageServer::handleInitialized(MessageID, Json const&)
 {
+	if (m_clientCanWatchFiles)
+	{
+		Json watcher;
+		watcher["globPattern"] = "**/*.sol";
+		Json registration;
+		registration["id"] = c_watchedFilesRegistrationID;
+		registration["method"] = "workspace/didChangeWatchedFiles";
+		registration["registerOptions"]["watchers"] = Json::array({watcher});
+		Json params;
+		params["registrations"] = Json::array({registration});
+		// Until the client confirms the registration, the files are read before every compilation.
+		m_client.request(c_watchedFilesRegistrationID, "client/registerCapability", std::move(params));
+	}
+
 	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
 		compileAndUpdateDiagnostics();
 }
 
+LanguageServer::MessageHandler LanguageServer::withSnapshotTypes(MessageHandler _handler)
+{
+	return [this, handler = std::move(_handler)](MessageID _id, Json const& _args) {
+		TypeProvider::Scope typeProviderScope(m_snapshot->compilerStack.typeProvider());
+		handler(_id, _args);
+	};
+}
+
 void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
 {
 	if (_args.contains("textDocument") && _args["textDocument"].contains("uri"))
 	{
 		auto uri = _args["textDocument"]["uri"];
 
-		compile();
-
-		auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.get<std::string>());
-		SourceUnit const& ast = m_compilerStack.ast(sourceName);
-		m_compilerStack.charStream(sourceName);
-		Json data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+		auto const sourceName = m_snapshot->fileRepository.uriToSourceUnitName(uri.get<std::string>());
+		lspRequire(
+			compiledSources().count(sourceName) && compilerStack().state() >= CompilerStack::Parsed,
+			ErrorCode::RequestFailed,
+			"Unknown file: " + uri.get<std::string>()
+		);
+		SourceUnit const& ast = compilerStack().ast(sourceName);
+		Json data = SemanticTokensBuilder().build(ast, compilerStack().charStream(sourceName));
 
 		Json reply;
 		reply["data"] = data;
@@ -457,6 +748,37 @@ void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
 		m_client.error(_id, ErrorCode::InvalidParams, "Invalid parameter: textDocument.uri expected.");
 }
 
+void LanguageServer::handleResponse(MessageID _id, Json const& _message)
+{
+	if (_id != c_watchedFilesRegistrationID)
+		return;
+	if (_message.contains("error"))
+		m_client.trace("Watching files failed, reading them before every compilation instead.");
+	else
+		// From now on the files in the workspace are only read again when they change.
+		m_watchingFiles = true;
+}
+
+void LanguageServer::handleWorkspaceDidChangeWatchedFiles(Json const& _args)
+{
+	requireServerInitialized();
+
+	// Changes to open files do not matter until they are closed, but the project files have to be
+	// read again anyway to know their contents by then.
+	m_projectFilesStale = true;
+	if (_args.contains("changes") && _args["changes"].is_array())
+		for (Json const& change: _args["changes"])
+			if (
+				change.contains("uri") &&
+				change["uri"].is_string() &&
+				!m_openFiles.count(change["uri"].get<std::string>())
+			)
+				m_compilationOutdated = true;
+
+	if (m_compilationOutdated)
+		compileAndUpdateDiagnostics();
+}
+
 void LanguageServer::handleWorkspaceDidChangeConfiguration(Json const& _args)
 {
 	requireServerInitialized();
@@ -495,6 +817,10 @@ void LanguageServer::handleTextDocumentDidOpen(Json const& _args)
 		std::string text = _args["textDocument"]["text"].get<std::string>();
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.insert(uri);
+		// Opening a file that is already compiled with the same contents does not change anything.
+		std::string const sourceUnitName = m_fileRepository.uriToSourceUnitName(uri);
+		if (std::string const* contents = util::valueOrNullptr(m_fileRepository.sourceUnits(), sourceUnitName); !contents || *contents != text)
+			m_dirtySourceUnits.insert(sourceUnitName);
 		m_fileRepository.setSourceByUri(uri, std::move(text));
 		compileAndUpdateDiagnostics();
 	}
@@ -540,6 +866,7 @@ void LanguageServer::handleTextDocumentDidChange(Json const& _args)
 						text = std::move(buffer);
 					}
 					m_fileRepository.setSourceByUri(uri, std::move(text));
+					m_dirtySourceUnits.insert(sourceUnitName);
 				}
 			}
 
@@ -561,6 +888,16 @@ void LanguageServer::handleTextDocumentDidClose(Json const& _args)
 	{
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.erase(uri);
+		// The file is either read from disk again or not compiled at all anymore.
+		m_dirtySourceUnits.insert(m_fileRepository.uriToSourceUnitName(uri));
+
+		FileRepository fileRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
+		for (std::string const& openFile: m_openFiles)
+			fileRepository.setSourceByUri(
+				openFile,
+				m_fileRepository.sourceUnits().at(m_fileRepository.uriToSourceUnitName(openFile))
+			);
+		m_fileRepository = std::move(fileRepository);
 
 		compileAndUpdateDiagnostics();
 	}
@@ -573,14 +910,14 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 std::tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
 {
-	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
+	if (compilerStack().state() < CompilerStack::AnalysisSuccessful)
 		return {nullptr, -1};
-	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
+	if (!compiledSources().count(_sourceUnitName))
 		return {nullptr, -1};
 
-	std::optional<int> sourcePos = m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
+	std::optional<int> sourcePos = compilerStack().charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
 	if (!sourcePos)
 		return {nullptr, -1};
 
-	return {locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName)), *sourcePos};
+	return {locateInnermostASTNode(*sourcePos, compilerStack().ast(_sourceUnitName)), *sourcePos};
 }
@@ -24,10 +24,17 @@
 
 #include <libsolutil/JSON.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace solidity::lsp
@@ -63,8 +70,11 @@ class LanguageServer
 public:
 	/// @param _transport Customizable transport layer.
 	explicit LanguageServer(Transport& _transport);
+	/// Stops the background compilation, waiting for a running one to be cancelled.
+	~LanguageServer();
 
-	/// Re-compiles the project and updates the diagnostics pushed to the client.
+	/// Schedules a re-compilation of the project on the background thread, which updates the
+	/// diagnostics pushed to the client once it is done.
 	void compileAndUpdateDiagnostics();
 
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
@@ -75,13 +85,56 @@ public:
 	/// @return boolean indicating normal or abnormal termination.
 	bool run();
 
+	/// @returns the repository holding the contents of the files open in the client.
 	FileRepository& fileRepository() noexcept { return m_fileRepository; }
 	Transport& client() noexcept { return m_client; }
 	std::tuple<frontend::ASTNode const*, int> astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
-	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
+	/// @returns the compiler stack of the last completed compilation. Requests are answered from
+	/// it while more recent changes are still being compiled.
+	frontend::CompilerStack const& compilerStack() const noexcept { return m_snapshot->compilerStack; }
+	/// @returns the sources of the last completed compilation by their source unit name.
+	StringMap const& compiledSources() const noexcept { return m_snapshot->fileRepository.sourceUnits(); }
 
 private:
+	/// The sources and the analysis results of one compilation. Not modified anymore once the
+	/// compilation is completed, so that it can be used while the next one is running.
+	struct Snapshot
+	{
+		Snapshot(boost::filesystem::path _basePath, std::vector<boost::filesystem::path> _includePaths):
+			fileRepository(std::move(_basePath), std::move(_includePaths)),
+			compilerStack(fileRepository.reader())
+		{}
+
+		/// The compiled sources, including the ones read through the import callback.
+		FileRepository fileRepository;
+		frontend::CompilerStack compilerStack;
+	};
+
+	/// Everything the background thread needs to know to perform the compilation requested
+	/// by the changes since the last one.
+	struct CompilationRequest
+	{
+		boost::filesystem::path basePath;
+		std::vector<boost::filesystem::path> includePaths;
+		FileLoadStrategy fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
+		/// Contents of the files open in the client by their URI.
+		std::map<std::string, std::string> openFiles;
+		/// Source unit names of the sources whose contents might have changed since the last compilation.
+		std::set<std::string> dirtySourceUnits;
+		/// Whether the last compilation is outdated even if no source is dirty, e.g. because files
+		/// changed on disk or the settings changed.
+		bool outdated = false;
+		/// Whether the Solidity files in the project directory have to be read again.
+		bool reloadProjectFiles = false;
+		/// Directory in which the client notifies the server about changed files, empty if it does not.
+		/// The files read through the import callback from outside of it are checked for changes on disk.
+		boost::filesystem::path watchedDirectory;
+
+		/// Adds the changes of the older request @a _older, which was not completed, to this one.
+		void includeOlder(CompilationRequest const& _older);
+	};
+
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
 	/// Reports an error and returns false if not.
 	void requireServerInitialized();
@@ -92,6 +145,9 @@ private:
 	void handleTextDocumentDidOpen(Json const& _args);
 	void handleTextDocumentDidChange(Json const& _args);
 	void handleTextDocumentDidClose(Json const& _args);
+	void handleWorkspaceDidChangeWatchedFiles(Json const& _args);
+	/// Handles the responses of the client to requests sent by the server.
+	void handleResponse(MessageID _id, Json const& _message);
 	void handleRename(Json const& _args);
 	void handleGotoDefinition(MessageID _id, Json const& _args);
 	void semanticTokensFull(MessageID _id, Json const& _args);
@@ -99,15 +155,37 @@ private:
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json const&);
 
-	/// Compile everything until after analysis phase.
-	void compile();
+	/// Runs on the background thread: waits for compilation requests, compiles and publishes
+	/// the diagnostics until the server stops.
+	void compilationLoop();
 
-	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
+	/// Compile everything until after analysis phase.
+	/// @returns @a _previous if no source changed since the compilation it resulted from
+	/// and nullptr if the compilation was cancelled by a more recent request.
+	std::shared_ptr<Snapshot const> compile(
+		CompilationRequest& _request,
+		std::shared_ptr<Snapshot const> const& _previous
+	);
+
+	/// Sends the diagnostics of the compilation in @a _snapshot to the client.
+	void publishDiagnostics(Snapshot const& _snapshot);
+
+	std::vector<boost::filesystem::path> allSolidityFilesFromProject(boost::filesystem::path const& _basePath) const;
+	/// Reads all Solidity files in the project directory into @a m_projectFiles and marks
+	/// @a _request outdated if any of them that is not open changed.
+	void loadProjectFiles(CompilationRequest& _request, FileRepository const& _fileRepository);
+	/// @returns true if a file that was read by the compilation in @a _snapshot through the import
+	/// callback changed on disk or if an import that could not be found exists now.
+	bool importedFilesChangedOnDisk(CompilationRequest const& _request, Snapshot const& _snapshot) const;
 
 	using MessageHandler = std::function<void(MessageID, Json const&)>;
+	/// @returns a handler that runs @a _handler with the type provider of the snapshot the request
+	/// is answered from, so that types created for its AST are neither mixed with nor kept by
+	/// the provider private to the thread.
+	MessageHandler withSnapshotTypes(MessageHandler _handler);
 
-	Json toRange(langutil::SourceLocation const& _location);
-	Json toJson(langutil::SourceLocation const& _location);
+	static Json toRange(Snapshot const& _snapshot, langutil::SourceLocation const& _location);
+	static Json toJson(Snapshot const& _snapshot, langutil::SourceLocation const& _location);
 
 	// LSP related member fields
 
@@ -119,15 +197,55 @@ private:
 
 	/// Set of files (names in URI form) known to be open by the client.
 	std::set<std::string> m_openFiles;
-	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
-	std::set<std::string> m_nonemptyDiagnostics;
+	/// Source unit names of the sources whose contents changed since the last compilation request.
+	std::set<std::string> m_dirtySourceUnits;
+	/// Whether the last compilation is outdated even if no source is dirty, e.g. because files
+	/// changed on disk or the settings changed.
+	bool m_compilationOutdated = true;
+	/// Whether the files on disk might have changed since the project files were last loaded.
+	bool m_projectFilesStale = true;
+	/// Whether the client supports registering a file watcher for the Solidity files.
+	bool m_clientCanWatchFiles = false;
+	/// Whether the client notifies us of changes to the Solidity files on disk. Otherwise all
+	/// files that are not open have to be read again before every compilation.
+	bool m_watchingFiles = false;
+	/// Whether the client can be asked to request the semantic tokens again after a compilation.
+	bool m_clientCanRefreshSemanticTokens = false;
+	/// Contents of the files open in the client.
 	FileRepository m_fileRepository;
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
-
-	frontend::CompilerStack m_compilerStack;
+	/// The completed compilation the current message is handled with.
+	std::shared_ptr<Snapshot const> m_snapshot;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json m_settingsObject;
+
+	// Members only used by the background thread.
+
+	/// Contents of all Solidity files in the project directory by their URI, as last read from disk.
+	/// Only used with FileLoadStrategy::ProjectDirectory.
+	std::map<std::string, std::string> m_projectFiles;
+	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
+	std::set<std::string> m_nonemptyDiagnostics;
+	/// Number of requests sent to the client to refresh the semantic tokens, used for their IDs.
+	size_t m_semanticTokensRefreshCount = 0;
+
+	// Members shared with the background thread, guarded by m_compilationMutex.
+
+	std::mutex m_compilationMutex;
+	std::condition_variable m_compilationRequested;
+	/// The compilation requested by the changes that the background thread did not start compiling yet.
+	std::optional<CompilationRequest> m_pendingCompilation;
+	/// Time of the most recent change, used to wait for further changes before compiling.
+	std::chrono::steady_clock::time_point m_lastCompilationRequest;
+	/// The most recent completed compilation.
+	std::shared_ptr<Snapshot const> m_latestSnapshot;
+	bool m_stopCompiling = false;
+	/// Set when a compilation is requested while another one is running, whose result is then dropped.
+	std::atomic<bool> m_compilationCancelled = false;
+
+	/// Started last, once all members it uses are initialized.
+	std::thread m_compilationThread;
 };
 
 }
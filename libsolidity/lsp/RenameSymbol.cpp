@@ -68,7 +68,7 @@ void RenameSymbol::operator()(MessageID _id, Json const& _args)
 	extractNameAndDeclaration(*sourceNode, *cursorBytePosition);
 
 	// Find all source units using this symbol
-	for (auto const& [name, content]: fileRepository().sourceUnits())
+	for (auto const& [name, content]: m_server.compiledSources())
 	{
 		auto const& sourceUnit = m_server.compilerStack().ast(name);
 		for (auto const* referencedSourceUnit: sourceUnit.referencedSourceUnits(true, util::convertContainer<std::set<SourceUnit const*>>(m_sourceUnits)))
@@ -99,11 +99,14 @@ void RenameSymbol::operator()(MessageID _id, Json const& _args)
 	{
 		solAssert(i->isValid());
 
-		// Replace in our file repository
+		// Replace in our file repository, which only holds the files open in the client.
 		std::string const uri = fileRepository().sourceUnitNameToUri(*i->sourceName);
-		std::string buffer = fileRepository().sourceUnits().at(*i->sourceName);
-		buffer.replace((size_t)i->start, (size_t)(i->end - i->start), newName);
-		fileRepository().setSourceByUri(uri, std::move(buffer));
+		if (std::string const* contents = util::valueOrNullptr(fileRepository().sourceUnits(), *i->sourceName))
+		{
+			std::string buffer = *contents;
+			buffer.replace((size_t)i->start, (size_t)(i->end - i->start), newName);
+			fileRepository().setSourceByUri(uri, std::move(buffer));
+		}
 
 		Json edit;
 		edit["range"] = toRange(*i);
@@ -112,6 +112,14 @@ void Transport::notify(std::string _method, Json _message)
 	send(std::move(json));
 }
 
+void Transport::request(MessageID _id, std::string _method, Json _params)
+{
+	Json json;
+	json["method"] = std::move(_method);
+	json["params"] = std::move(_params);
+	send(std::move(json), _id);
+}
+
 void Transport::reply(MessageID _id, Json _message)
 {
 	Json json;
@@ -137,6 +145,7 @@ void Transport::send(Json _json, MessageID _id)
 	// Trailing CRLF only for easier readability.
 	std::string const jsonString = solidity::util::jsonCompactPrint(_json);
 
+	std::lock_guard lock(m_sendMutex);
 	writeBytes(fmt::format("Content-Length: {}\r\n\r\n", jsonString.size()));
 	writeBytes(jsonString);
 	flushOutput();
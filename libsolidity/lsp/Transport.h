@@ -20,9 +20,11 @@
 #include <libsolutil/Exceptions.h>
 #include <libsolutil/JSON.h>
 
+#include <atomic>
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -99,6 +101,8 @@ public:
 
 	std::optional<Json> receive();
 	void notify(std::string _method, Json _params);
+	/// Sends a request to the client. Its response is received like any other message.
+	void request(MessageID _id, std::string _method, Json _params);
 	void reply(MessageID _id, Json _result);
 	void error(MessageID _id, ErrorCode _code, std::string _message);
 
@@ -110,7 +114,9 @@ public:
 	void setTrace(TraceValue _value) noexcept { m_logTrace = _value; }
 
 private:
-	TraceValue m_logTrace = TraceValue::Off;
+	std::atomic<TraceValue> m_logTrace = TraceValue::Off;
+	/// Serializes the messages sent by the language server and its background compilation.
+	std::mutex m_sendMutex;
 
 protected:
 	/// Reads from the transport and parses the headers until the beginning
@@ -76,7 +76,7 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return std::make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.createNode<NodeType>(m_location, std::forward<Args>(_args)...);
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -93,6 +93,7 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	{
 		m_recursionDepth = 0;
 		m_scanner = std::make_shared<Scanner>(_charStream);
+		m_arena = std::make_shared<ASTArena>();
 		ASTNodeFactory nodeFactory(*this);
 		m_experimentalSolidityEnabledInCurrentSourceUnit = false;
 
@@ -183,6 +184,27 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	}
 }
 
+ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream, std::vector<ASTPointer<ASTNode>>& _createdNodes)
+{
+	solAssert(m_currentNodeID == 0);
+	solAssert(!m_createdNodes);
+	m_createdNodes = &_createdNodes;
+	ScopeGuard resetCreatedNodes([&]() { m_createdNodes = nullptr; });
+	return parse(_charStream);
+}
+
+void Parser::adopt(std::vector<ASTPointer<ASTNode>> const& _createdNodes)
+{
+	size_t const offset = static_cast<size_t>(m_currentNodeID);
+	size_t localID = 0;
+	for (ASTPointer<ASTNode> const& node: _createdNodes)
+	{
+		solAssert(node->m_id == ++localID);
+		node->m_id += offset;
+	}
+	m_currentNodeID += static_cast<int64_t>(_createdNodes.size());
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, std::vector<Token> const& _tokens, std::vector<std::string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -217,7 +239,7 @@ ASTPointer<StructuredDocumentation> Parser::parseStructuredDocumentation()
 		ASTNodeFactory nodeFactory{*this};
 		nodeFactory.setLocation(m_scanner->currentCommentLocation());
 		return nodeFactory.createNode<StructuredDocumentation>(
-			std::make_shared<ASTString>(m_scanner->currentCommentLiteral())
+			makeString(m_scanner->currentCommentLiteral())
 		);
 	}
 	return nullptr;
@@ -283,7 +305,7 @@ ASTPointer<ImportDirective> Parser::parseImportDirective()
 	ASTNodeFactory nodeFactory(*this);
 	expectToken(Token::Import);
 	ASTPointer<ASTString> path;
-	ASTPointer<ASTString> unitAlias = std::make_shared<std::string>();
+	ASTPointer<ASTString> unitAlias = makeString();
 	SourceLocation unitAliasLocation{};
 	ImportDirective::SymbolAliasList symbolAliases;
 
@@ -674,7 +696,7 @@ ASTPointer<FunctionDefinition> Parser::parseFunctionDefinition(bool _freeFunctio
 				{Token::Receive, "receive function"},
 			}.at(m_scanner->currentToken());
 			nameLocation = currentLocation();
-			name = std::make_shared<ASTString>(TokenTraits::toString(m_scanner->currentToken()));
+			name = makeString(TokenTraits::toString(m_scanner->currentToken()));
 			std::string message{
 				"This function is named \"" + *name + "\" but is not the " + expected + " of the contract. "
 				"If you intend this to be a " + expected + ", use \"" + *name + "(...) { ... }\" without "
@@ -693,7 +715,7 @@ ASTPointer<FunctionDefinition> Parser::parseFunctionDefinition(bool _freeFunctio
 	{
 		solAssert(kind == Token::Constructor || kind == Token::Fallback || kind == Token::Receive, "");
 		advance();
-		name = std::make_shared<ASTString>();
+		name = makeString();
 	}
 
 	FunctionHeaderParserResult header = parseFunctionHeader(false);
@@ -906,7 +928,7 @@ ASTPointer<VariableDeclaration> Parser::parseVariableDeclaration(
 	}
 
 	if (_options.allowEmptyName && m_scanner->currentToken() != Token::Identifier)
-		identifier = std::make_shared<ASTString>("");
+		identifier = makeString("");
 	else
 	{
 		nodeFactory.markEndPosition();
@@ -1295,13 +1317,13 @@ ASTPointer<Mapping> Parser::parseMapping()
 	}
 	else
 		fatalParserError(1005_error, "Expected elementary type name or identifier for mapping key type");
-	ASTPointer<ASTString> keyName = std::make_shared<ASTString>("");
+	ASTPointer<ASTString> keyName = makeString("");
 	SourceLocation keyNameLocation{};
 	if (m_scanner->currentToken() == Token::Identifier)
 		tie(keyName, keyNameLocation) = expectIdentifierWithLocation();
 	expectToken(Token::DoubleArrow);
 	ASTPointer<TypeName> valueType = parseTypeName();
-	ASTPointer<ASTString> valueName = std::make_shared<ASTString>("");
+	ASTPointer<ASTString> valueName = makeString("");
 	SourceLocation valueNameLocation{};
 	if (m_scanner->currentToken() == Token::Identifier)
 		tie(valueName, valueNameLocation) = expectIdentifierWithLocation();
@@ -1376,7 +1398,7 @@ ASTPointer<Statement> Parser::parseStatement(bool _allowUnchecked)
 	ASTPointer<ASTString> docString;
 	ASTPointer<Statement> statement;
 	if (m_scanner->currentCommentLiteral() != "")
-		docString = std::make_shared<ASTString>(m_scanner->currentCommentLiteral());
+		docString = makeString(m_scanner->currentCommentLiteral());
 	switch (m_scanner->currentToken())
 	{
 	case Token::If:
@@ -1460,12 +1482,12 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 	ASTPointer<std::vector<ASTPointer<ASTString>>> flags;
 	if (m_scanner->currentToken() == Token::LParen)
 	{
-		flags = std::make_shared<std::vector<ASTPointer<ASTString>>>();
+		flags = ASTArena::make<std::vector<ASTPointer<ASTString>>>(m_arena);
 		do
 		{
 			advance();
 			expectToken(Token::StringLiteral, false);
-			flags->emplace_back(std::make_shared<ASTString>(m_scanner->currentLiteral()));
+			flags->emplace_back(makeString(m_scanner->currentLiteral()));
 			advance();
 		}
 		while (m_scanner->currentToken() == Token::Comma);
@@ -1478,7 +1500,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(ast->root()).end;
-	return std::make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), ast);
+	return createNode<InlineAssembly>(location, _docString, dialect, std::move(flags), ast);
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -1523,7 +1545,7 @@ ASTPointer<TryStatement> Parser::parseTryStatement(ASTPointer<ASTString> const&
 	ASTPointer<Block> successBlock = parseBlock();
 	successClauseFactory.setEndPositionFromNode(successBlock);
 	clauses.emplace_back(successClauseFactory.createNode<TryCatchClause>(
-		std::make_shared<ASTString>(), returnsParameters, successBlock
+		makeString(), returnsParameters, successBlock
 	));
 
 	do
@@ -1542,7 +1564,7 @@ ASTPointer<TryCatchClause> Parser::parseCatchClause()
 	RecursionGuard recursionGuard(*this);
 	ASTNodeFactory nodeFactory(*this);
 	expectToken(Token::Catch);
-	ASTPointer<ASTString> errorName = std::make_shared<std::string>();
+	ASTPointer<ASTString> errorName = makeString();
 	ASTPointer<ParameterList> errorParameters;
 	if (m_scanner->currentToken() != Token::LBrace)
 	{
@@ -1879,7 +1901,7 @@ ASTPointer<TypeDefinition> Parser::parseTypeDefinition()
 			expectToken(Token::LParen);
 
 			expression = nodeFactory.createNode<Builtin>(
-				std::make_shared<std::string>(m_scanner->currentLiteral()),
+				makeString(m_scanner->currentLiteral()),
 				m_scanner->currentLocation()
 			);
 
@@ -2289,7 +2311,7 @@ ASTPointer<Expression> Parser::parseLiteral()
 	RecursionGuard recursionGuard(*this);
 	ASTNodeFactory nodeFactory(*this);
 	Token initialToken = m_scanner->currentToken();
-	ASTPointer<ASTString> value = std::make_shared<std::string>(m_scanner->currentLiteral());
+	ASTPointer<ASTString> value = makeString(m_scanner->currentLiteral());
 
 	switch (initialToken)
 	{
@@ -2359,7 +2381,7 @@ ASTPointer<Expression> Parser::parsePrimaryExpression()
 		// Inside expressions "type" is the name of a special, globally-available function.
 		nodeFactory.markEndPosition();
 		advance();
-		expression = nodeFactory.createNode<Identifier>(std::make_shared<ASTString>("type"));
+		expression = nodeFactory.createNode<Identifier>(makeString("type"));
 		break;
 	case Token::LParen:
 	case Token::LBrack:
@@ -2502,9 +2524,9 @@ std::optional<std::string> Parser::findLicenseString(std::vector<ASTPointer<ASTN
 
 	// Search inside all parts of the source not covered by parsed nodes.
 	// This will leave e.g. "global comments".
-	using iter = std::string::const_iterator;
+	using iter = std::string_view::const_iterator;
 	std::vector<std::pair<iter, iter>> sequencesToSearch;
-	std::string const& source = m_scanner->charStream().source();
+	std::string_view source = m_scanner->charStream().source();
 	sequencesToSearch.emplace_back(source.begin(), source.end());
 	for (ASTPointer<ASTNode> const& node: _nodes)
 		if (node->location().hasText())
@@ -2516,10 +2538,10 @@ std::optional<std::string> Parser::findLicenseString(std::vector<ASTPointer<ASTN
 	std::vector<std::string> licenseNames;
 	for (auto const& [start, end]: sequencesToSearch)
 	{
-		auto declarationsBegin = std::sregex_iterator(start, end, licenseDeclarationRegex);
-		auto declarationsEnd = std::sregex_iterator();
+		auto declarationsBegin = std::regex_iterator<iter>(start, end, licenseDeclarationRegex);
+		auto declarationsEnd = std::regex_iterator<iter>();
 
-		for (std::sregex_iterator declIt = declarationsBegin; declIt != declarationsEnd; ++declIt)
+		for (std::regex_iterator<iter> declIt = declarationsBegin; declIt != declarationsEnd; ++declIt)
 			if (!declIt->empty())
 			{
 				std::string license = boost::trim_copy(std::string((*declIt)[1]));
@@ -2709,7 +2731,7 @@ ASTPointer<Expression> Parser::expressionFromIndexAccessStructure(
 		Identifier const& identifier = dynamic_cast<Identifier const&>(*_iap.path[i]);
 		expression = nodeFactory.createNode<MemberAccess>(
 			expression,
-			std::make_shared<ASTString>(identifier.name()),
+			makeString(identifier.name()),
 			identifier.location()
 		);
 	}
@@ -2743,7 +2765,7 @@ ASTPointer<ASTString> Parser::expectIdentifierTokenOrAddress()
 	ASTPointer<ASTString> result;
 	if (m_scanner->currentToken() == Token::Address)
 	{
-		result = std::make_shared<ASTString>("address");
+		result = makeString("address");
 		advance();
 	}
 	else
@@ -2756,7 +2778,7 @@ ASTPointer<ASTString> Parser::expectIdentifierTokenOrAddress()
 
 ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = std::make_shared<ASTString>(m_scanner->currentLiteral());
+	ASTPointer<ASTString> identifier = makeString(m_scanner->currentLiteral());
 	advance();
 	return identifier;
 }
@@ -2779,7 +2801,7 @@ ASTPointer<ASTString> Parser::getStdlibImportPathAndAdvance()
 	if (m_scanner->currentToken() == Token::Period)
 		advance();
 	ASTPointer<ASTString> library = expectIdentifierToken();
-	return std::make_shared<ASTString>(*std + "." + *library);
+	return makeString(*std + "." + *library);
 }
 
 }
@@ -49,6 +49,14 @@ public:
 	{}
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
+	/// Parses @a _charStream like the above and stores all nodes created on the way in
+	/// @a _createdNodes, in the order of their IDs, so that a different parser can adopt them.
+	/// Has to be the first source parsed by this parser.
+	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream, std::vector<ASTPointer<ASTNode>>& _createdNodes);
+
+	/// Takes over the nodes a different parser created via the above for a source unit and
+	/// renumbers them as if this parser had parsed the source unit just now.
+	void adopt(std::vector<ASTPointer<ASTNode>> const& _createdNodes);
 
 	/// Returns the maximal AST node ID assigned so far
 	int64_t maxID() const { return m_currentNodeID; }
@@ -215,6 +223,18 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// @returns a new node with the next ID in the arena of the current source unit.
+	template <class NodeType, typename... Args>
+	ASTPointer<NodeType> createNode(langutil::SourceLocation const& _location, Args&&... _args)
+	{
+		auto node = ASTArena::make<NodeType>(m_arena, nextID(), _location, std::forward<Args>(_args)...);
+		if (m_createdNodes)
+			m_createdNodes->push_back(node);
+		return node;
+	}
+	/// @returns a new string in the arena of the current source unit.
+	template <class... Args>
+	ASTPointer<ASTString> makeString(Args&&... _args) { return ASTArena::make<ASTString>(m_arena, std::forward<Args>(_args)...); }
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -252,6 +272,10 @@ private:
 	std::optional<uint8_t> m_eofVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Arena for the nodes of the source unit currently being parsed.
+	std::shared_ptr<ASTArena> m_arena;
+	/// If set, all created nodes are stored here.
+	std::vector<ASTPointer<ASTNode>>* m_createdNodes = nullptr;
 	/// Flag that indicates whether experimental mode is enabled in the current source unit
 	bool m_experimentalSolidityEnabledInCurrentSourceUnit = false;
 };
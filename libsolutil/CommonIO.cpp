@@ -30,6 +30,11 @@
 #include <unistd.h>
 #include <termios.h>
 #endif
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 using namespace solidity::util;
 
@@ -71,6 +76,46 @@ std::string solidity::util::readFileAsString(boost::filesystem::path const& _fil
 	return readFile<std::string>(_file);
 }
 
+SharedText solidity::util::readFileAsSharedText(boost::filesystem::path const& _file)
+{
+	assertThrow(boost::filesystem::exists(_file), FileNotFound, _file.string());
+	assertThrow(boost::filesystem::is_regular_file(_file), NotAFile, _file.string());
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+	int fileDescriptor = ::open(_file.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fileDescriptor != -1)
+	{
+		void* address = MAP_FAILED;
+		size_t size = 0;
+		struct stat status;
+		// The rest of the last page of a mapping is filled with zeros and provides the
+		// terminating zero of the text. If the file ends at a page boundary, it is read instead.
+		if (
+			::fstat(fileDescriptor, &status) == 0 &&
+			status.st_size >= static_cast<off_t>(c_fileMappingThreshold) &&
+			status.st_size % ::sysconf(_SC_PAGESIZE) != 0
+		)
+		{
+			size = static_cast<size_t>(status.st_size);
+			address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		}
+		// The mapping stays valid after the descriptor is closed.
+		::close(fileDescriptor);
+
+		if (address != MAP_FAILED)
+			return SharedText(
+				std::shared_ptr<void const>(address, [size](void const* _address) {
+					::munmap(const_cast<void*>(_address), size);
+				}),
+				std::string_view(static_cast<char const*>(address), size)
+			);
+	}
+#endif
+
+	// Also used if the file cannot be mapped, which reports any error the usual way.
+	return readFileAsString(_file);
+}
+
 std::string solidity::util::readUntilEnd(std::istream& _stdin)
 {
 	std::ostringstream ss;
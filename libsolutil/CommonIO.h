@@ -27,6 +27,7 @@
 #include <boost/filesystem.hpp>
 
 #include <libsolutil/Common.h>
+#include <libsolutil/SharedText.h>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -54,6 +55,18 @@ namespace util
 /// If the file is empty, returns an empty string.
 std::string readFileAsString(boost::filesystem::path const& _file);
 
+/// Retrieves and returns the contents of the given file like @a readFileAsString().
+/// Files of at least @a c_fileMappingThreshold bytes are mapped into memory instead of being
+/// read where the platform supports it. A mapped file must not be changed while it is in use:
+/// changes may become visible in the text and accessing a truncated part raises SIGBUS.
+/// Callers that cannot rule this out, e.g. long-running servers, should use @a readFileAsString().
+/// The character after the end of the text is readable and zero (see @a SharedText).
+SharedText readFileAsSharedText(boost::filesystem::path const& _file);
+
+/// Size from which @a readFileAsSharedText() maps files. Mapping smaller files costs more
+/// than copying them.
+size_t constexpr c_fileMappingThreshold = 0x4000;
+
 /// Retrieves and returns the whole content of the specified input stream (until EOF).
 std::string readUntilEnd(std::istream& _stdin);
 
@@ -152,7 +152,7 @@ bytes groupChunksBottomUp(Chunks _currentLevel)
 }
 }
 
-bytes solidity::util::ipfsHash(std::string _data)
+bytes solidity::util::ipfsHash(std::string_view _data)
 {
 	size_t const maxChunkSize = 1024 * 256;
 	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
@@ -162,9 +162,11 @@ bytes solidity::util::ipfsHash(std::string _data)
 
 	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, std::min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
+		std::string_view chunk = _data.substr(
+			chunkIndex * maxChunkSize,
+			std::min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize)
 		);
+		bytes chunkBytes(chunk.begin(), chunk.end());
 
 		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
 
@@ -196,7 +198,7 @@ bytes solidity::util::ipfsHash(std::string _data)
 	return groupChunksBottomUp(std::move(allChunks));
 }
 
-std::string solidity::util::ipfsHashBase58(std::string _data)
+std::string solidity::util::ipfsHashBase58(std::string_view _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
@@ -138,6 +138,100 @@ std::string jsonPrint(Json const& _input, JsonFormat const& _format)
 	return dumped;
 }
 
+void JsonStreamWriter::beginObject()
+{
+	beginElement();
+	m_stream << '{';
+	m_emptyContainers.push_back(true);
+}
+
+void JsonStreamWriter::endObject()
+{
+	endContainer('}');
+}
+
+void JsonStreamWriter::beginArray()
+{
+	beginElement();
+	m_stream << '[';
+	m_emptyContainers.push_back(true);
+}
+
+void JsonStreamWriter::endArray()
+{
+	endContainer(']');
+}
+
+void JsonStreamWriter::key(std::string const& _key)
+{
+	assertThrow(!m_afterKey, Exception, "Expected the value of the previous key.");
+	beginElement();
+	m_stream << Json(_key).dump(-1, ' ', true) << (m_format.format == JsonFormat::Pretty ? ": " : ":");
+	m_afterKey = true;
+}
+
+void JsonStreamWriter::value(Json const& _value, DeferredValueWriter const& _deferredValueWriter)
+{
+	if (_value.is_object() && !_value.empty())
+	{
+		beginObject();
+		for (auto const& [memberKey, memberValue]: _value.items())
+		{
+			key(memberKey);
+			value(memberValue, _deferredValueWriter);
+		}
+		endObject();
+	}
+	else if (_value.is_array() && !_value.empty())
+	{
+		beginArray();
+		for (Json const& element: _value)
+			value(element, _deferredValueWriter);
+		endArray();
+	}
+	else if (_value.is_binary() && _deferredValueWriter)
+	{
+		assertThrow(_value.get_binary().has_subtype(), Exception, "Placeholder without identifier.");
+		_deferredValueWriter(*this, _value.get_binary().subtype());
+	}
+	else
+	{
+		beginElement();
+		m_stream << jsonPrint(_value, m_format);
+	}
+}
+
+void JsonStreamWriter::beginElement()
+{
+	if (m_afterKey)
+	{
+		m_afterKey = false;
+		return;
+	}
+	if (m_emptyContainers.empty())
+		return;
+	if (!m_emptyContainers.back())
+		m_stream << ',';
+	m_emptyContainers.back() = false;
+	newLine(m_emptyContainers.size());
+}
+
+void JsonStreamWriter::endContainer(char _closingBracket)
+{
+	assertThrow(!m_emptyContainers.empty() && !m_afterKey, Exception, "No open container to end.");
+	bool const empty = m_emptyContainers.back();
+	m_emptyContainers.pop_back();
+	if (!empty)
+		newLine(m_emptyContainers.size());
+	m_stream << _closingBracket;
+}
+
+void JsonStreamWriter::newLine(size_t _depth)
+{
+	if (m_format.format == JsonFormat::Pretty)
+		m_stream << '\n' << std::string(_depth * m_format.indent, ' ');
+}
+
 bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs /* = nullptr */)
 {
 	try
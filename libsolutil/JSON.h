@@ -26,10 +26,13 @@
 #include <libsolutil/Assertions.h>
 #include <nlohmann/json.hpp>
 
+#include <functional>
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <optional>
 #include <limits>
+#include <vector>
 
 namespace solidity
 {
@@ -71,6 +74,49 @@ std::string jsonCompactPrint(Json const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json const& _input, JsonFormat const& _format);
 
+/**
+ * Serialises JSON piece by piece to a stream in the same format as @a jsonPrint(), so that large
+ * documents never have to be held in memory as a whole.
+ *
+ * Values can be written in full or be left as placeholders (see @a deferredValue()) that are
+ * replaced by the output of a callback while writing. Object members have to be written in
+ * ascending order of their keys to match the output of @a jsonPrint().
+ */
+class JsonStreamWriter
+{
+public:
+	/// Called for each placeholder with its identifier. Has to write exactly one value.
+	using DeferredValueWriter = std::function<void(JsonStreamWriter&, uint64_t)>;
+
+	JsonStreamWriter(std::ostream& _stream, JsonFormat const& _format):
+		m_stream(_stream), m_format(_format) {}
+
+	/// @returns a placeholder for a value to be written by a callback of @a value().
+	static Json deferredValue(uint64_t _id) { return Json::binary({}, _id); }
+
+	void beginObject();
+	void endObject();
+	void beginArray();
+	void endArray();
+	/// Writes the key of the next member of the current object.
+	void key(std::string const& _key);
+	/// Writes @a _value, calling @a _deferredValueWriter for each placeholder inside it.
+	void value(Json const& _value, DeferredValueWriter const& _deferredValueWriter = {});
+
+private:
+	/// Writes the separator and the indentation preceding the next array element or object member.
+	void beginElement();
+	void endContainer(char _closingBracket);
+	void newLine(size_t _depth);
+
+	std::ostream& m_stream;
+	JsonFormat m_format;
+	/// For every open array or object, whether it has no elements yet.
+	std::vector<bool> m_emptyContainers;
+	/// Whether a key was written and its value is still missing.
+	bool m_afterKey = false;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
@@ -18,81 +18,119 @@
 
 #include <libsolutil/Profiler.h>
 
-#include <fmt/format.h>
-
-#include <algorithm>
-#include <iostream>
-#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 using namespace std::chrono;
 using namespace solidity;
+using namespace solidity::util;
 
-#ifdef PROFILE_OPTIMIZER_STEPS
+thread_local Profiler* Profiler::s_current = nullptr;
 
-util::Profiler::Probe::Probe(std::string _scopeName):
-	m_scopeName(std::move(_scopeName)),
-	m_startTime(steady_clock::now())
+std::optional<size_t> Profiler::peakMemoryUsageKiB()
 {
+#if defined(__unix__) || defined(__APPLE__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return std::nullopt;
+#if defined(__APPLE__)
+	// Reported in bytes on macOS and in KiB everywhere else.
+	return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+	return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#else
+	return std::nullopt;
+#endif
 }
 
-util::Profiler::Probe::~Probe()
+Profiler::Scope::Scope(Profiler* _profiler):
+	m_previous(s_current)
 {
-	steady_clock::time_point endTime = steady_clock::now();
+	s_current = _profiler;
+}
 
-	auto [metricsIt, inserted] = Profiler::singleton().m_metrics.try_emplace(m_scopeName, Metrics{0us, 0});
-	metricsIt->second.durationInMicroseconds += duration_cast<microseconds>(endTime - m_startTime);
-	++metricsIt->second.callCount;
+Profiler::Scope::~Scope()
+{
+	s_current = m_previous;
 }
 
-util::Profiler::~Profiler()
+Profiler::Probe::Probe(std::string_view _name, std::string_view _category, std::string_view _detail):
+	m_profiler(s_current)
 {
-	outputPerformanceMetrics();
+	if (!m_profiler)
+		return;
+	m_name = _name;
+	m_category = _category;
+	m_detail = _detail;
+	m_startTime = steady_clock::now();
 }
 
-util::Profiler& util::Profiler::singleton()
+Profiler::Probe::~Probe()
 {
-	static Profiler profiler;
-	return profiler;
+	if (m_profiler)
+		m_profiler->record(*this, steady_clock::now());
 }
 
-void util::Profiler::outputPerformanceMetrics()
+Profiler::Profiler():
+	m_startTime(steady_clock::now()),
+	m_threadIndices{{std::this_thread::get_id(), 0}}
 {
-	std::vector<std::pair<std::string, Metrics>> sortedMetrics(m_metrics.begin(), m_metrics.end());
-	std::sort(
-		sortedMetrics.begin(),
-		sortedMetrics.end(),
-		[](std::pair<std::string, Metrics> const& _lhs, std::pair<std::string, Metrics> const& _rhs) -> bool
-		{
-			return _lhs.second.durationInMicroseconds < _rhs.second.durationInMicroseconds;
-		}
-	);
-
-	std::chrono::microseconds totalDurationInMicroseconds = 0us;
-	size_t totalCallCount = 0;
-	for (auto&& [scopeName, scopeMetrics]: sortedMetrics)
-	{
-		totalDurationInMicroseconds += scopeMetrics.durationInMicroseconds;
-		totalCallCount += scopeMetrics.callCount;
-	}
+}
 
-	std::cerr << "PERFORMANCE METRICS FOR PROFILED SCOPES\n\n";
-	std::cerr << "| Time % | Time       | Calls   | Scope                          |\n";
-	std::cerr << "|-------:|-----------:|--------:|--------------------------------|\n";
+void Profiler::record(Probe const& _probe, steady_clock::time_point _endTime)
+{
+	std::optional<size_t> peakMemory = peakMemoryUsageKiB();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto [threadIt, inserted] = m_threadIndices.try_emplace(std::this_thread::get_id(), m_threadIndices.size());
+	m_events.push_back(Event{
+		_probe.m_name,
+		_probe.m_category,
+		_probe.m_detail,
+		threadIt->second,
+		duration_cast<microseconds>(_probe.m_startTime - m_startTime),
+		duration_cast<microseconds>(_endTime - _probe.m_startTime),
+		peakMemory
+	});
+}
 
-	double totalDurationInSeconds = duration_cast<duration<double>>(totalDurationInMicroseconds).count();
-	for (auto&& [scopeName, scopeMetrics]: sortedMetrics)
+Json Profiler::chromeTrace() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	Json events = Json::array();
+	for (size_t threadIndex = 0; threadIndex < m_threadIndices.size(); ++threadIndex)
+		events.emplace_back(Json{
+			{"name", "thread_name"},
+			{"ph", "M"},
+			{"pid", 0},
+			{"tid", threadIndex},
+			{"args", {{"name", threadIndex == 0 ? "main" : "worker " + std::to_string(threadIndex)}}}
+		});
+
+	for (Event const& event: m_events)
 	{
-		double durationInSeconds = duration_cast<duration<double>>(scopeMetrics.durationInMicroseconds).count();
-		double percentage = 100.0 * durationInSeconds / totalDurationInSeconds;
-		std::cerr << fmt::format(
-			"| {:5.1f}% | {:8.3f} s | {:7} | {:30} |\n",
-			percentage,
-			durationInSeconds,
-			scopeMetrics.callCount,
-			scopeName
-		);
+		Json args = Json::object();
+		if (!event.detail.empty())
+			args["detail"] = event.detail;
+		if (event.peakMemoryKiB)
+			args["peakMemoryKiB"] = *event.peakMemoryKiB;
+		events.emplace_back(Json{
+			{"name", event.name},
+			{"cat", event.category},
+			{"ph", "X"},
+			{"pid", 0},
+			{"tid", event.threadIndex},
+			{"ts", event.start.count()},
+			{"dur", event.duration.count()},
+			{"args", std::move(args)}
+		});
 	}
-	std::cerr << fmt::format("| {:5.1f}% | {:8.3f} s | {:7} | {:30} |\n", 100.0, totalDurationInSeconds, totalCallCount, "**TOTAL**");
-}
 
-#endif
+	return Json{
+		{"traceEvents", std::move(events)},
+		{"displayTimeUnit", "ms"}
+	};
+}
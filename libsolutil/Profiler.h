@@ -18,64 +18,105 @@
 
 #pragma once
 
+#include <libsolutil/JSON.h>
+
 #include <chrono>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
-
-#ifdef PROFILE_OPTIMIZER_STEPS
-#define PROFILER_PROBE(_scopeName, _variable) solidity::util::Profiler::Probe _variable(_scopeName);
-#else
-#define PROFILER_PROBE(_scopeName, _variable) void(0);
-#endif
+#include <string_view>
+#include <thread>
+#include <vector>
 
 namespace solidity::util
 {
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-
-/// Simpler profiler class that gathers metrics during program execution and prints them out on exit.
+/// Profiler recording the duration of compilation phases as a trace in the Chrome trace event
+/// format, which can be viewed in chrome://tracing or https://ui.perfetto.dev.
 ///
 /// To gather metrics, create a Probe instance and let it live until the end of the scope.
-/// The probe will register its creation and destruction time and store the results in the profiler
-/// singleton.
+/// The probe records its creation and destruction time in the profiler made current for the
+/// calling thread by a Profiler::Scope. If there is none, probes do nothing, so they can be left
+/// in the code unconditionally. Tasks run by a ThreadPool use the profiler that was current on
+/// the thread queueing them.
 ///
-/// Use the PROFILER_PROBE macro to create probes conditionally, in a way that will not affect performance
-/// unless profiling is enabled at compilation time via PROFILE_OPTIMIZER_STEPS CMake option.
-///
-/// Scopes are identified by the name supplied to the probe. Using the same name multiple times
-/// will result in metrics for those scopes being aggregated together as if they were the same scope.
+/// Along with the duration, every probe records the peak memory usage of the process at its end.
+/// Nested probes show up as nested slices of the same thread in the trace.
 class Profiler
 {
 public:
+	/// Makes @a _profiler the profiler used by the calling thread for the lifetime of the scope.
+	/// @a _profiler can be null to disable profiling within the scope.
+	/// Scopes can be nested; the previous profiler is restored when the scope ends.
+	class Scope
+	{
+	public:
+		explicit Scope(Profiler* _profiler);
+		~Scope();
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		Profiler* m_previous = nullptr;
+	};
+
 	class Probe
 	{
 	public:
-		Probe(std::string _scopeName);
+		/// @param _name name of the phase, e.g. the name of an optimiser step.
+		/// @param _category group of phases the phase belongs to, e.g. "analysis".
+		/// @param _detail optional subject of the phase, usually the name of a source or contract.
+		Probe(std::string_view _name, std::string_view _category, std::string_view _detail = {});
 		~Probe();
+		Probe(Probe const&) = delete;
+		Probe& operator=(Probe const&) = delete;
 
 	private:
-		std::string m_scopeName;
+		friend class Profiler;
+
+		Profiler* m_profiler = nullptr;
+		std::string m_name;
+		std::string m_category;
+		std::string m_detail;
 		std::chrono::steady_clock::time_point m_startTime;
 	};
 
-	static Profiler& singleton();
+	Profiler();
+	Profiler(Profiler const&) = delete;
+	Profiler& operator=(Profiler const&) = delete;
 
-private:
-	~Profiler();
+	/// @returns the profiler of the current scope or null if profiling is not enabled on the calling thread.
+	static Profiler* current() { return s_current; }
+
+	/// @returns the peak resident set size of the process in KiB, if the platform provides it.
+	static std::optional<size_t> peakMemoryUsageKiB();
 
-	struct Metrics
+	/// @returns the recorded probes as a JSON object in the Chrome trace event format.
+	Json chromeTrace() const;
+
+private:
+	struct Event
 	{
-		std::chrono::microseconds durationInMicroseconds;
-		size_t callCount;
+		std::string name;
+		std::string category;
+		std::string detail;
+		size_t threadIndex;
+		std::chrono::microseconds start;
+		std::chrono::microseconds duration;
+		std::optional<size_t> peakMemoryKiB;
 	};
 
-	/// Summarizes gathered metric and prints a report to standard error output.
-	void outputPerformanceMetrics();
+	void record(Probe const& _probe, std::chrono::steady_clock::time_point _endTime);
 
-	std::map<std::string, Metrics> m_metrics;
-};
+	std::chrono::steady_clock::time_point const m_startTime;
+	mutable std::mutex m_mutex;
+	std::vector<Event> m_events;
+	/// Small consecutive numbers used as thread IDs in the trace. The thread that created the
+	/// profiler is 0, the others are numbered in order of first appearance.
+	std::map<std::thread::id, size_t> m_threadIndices;
 
-#endif
+	thread_local static Profiler* s_current;
+};
 
 }
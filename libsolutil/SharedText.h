@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Immutable text whose storage is shared by all its copies.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/**
+ * Read-only text that can be copied without copying its characters.
+ *
+ * The characters are either held in a string owned by the text or in storage kept alive by
+ * an arbitrary owner, e.g. a memory mapping of a file (see @a readFileAsSharedText()).
+ * The storage is released together with the last copy.
+ *
+ * The character after the end of the text is always readable and zero, like the terminator
+ * of a string, so that scanners can look ahead without checking for the end of the text.
+ */
+class SharedText
+{
+public:
+	SharedText() = default;
+	SharedText(std::string _text)
+	{
+		if (_text.empty())
+			return;
+		auto owner = std::make_shared<std::string const>(std::move(_text));
+		m_view = *owner;
+		m_owner = std::move(owner);
+	}
+	SharedText(char const* _text): SharedText(std::string(_text)) {}
+	/// Views @a _text, which has to stay valid as long as @a _owner is alive.
+	/// The character after the end of @a _text has to be readable and zero.
+	SharedText(std::shared_ptr<void const> _owner, std::string_view _text):
+		m_owner(std::move(_owner)), m_view(_text) {}
+
+	std::string_view view() const noexcept { return m_view; }
+	operator std::string_view() const noexcept { return m_view; }
+	/// @returns a copy of the text as a string.
+	std::string str() const { return std::string(m_view); }
+
+	char const* data() const noexcept { return m_view.data(); }
+	size_t size() const noexcept { return m_view.size(); }
+	bool empty() const noexcept { return m_view.empty(); }
+
+	bool operator==(SharedText const& _other) const noexcept { return m_view == _other.m_view; }
+	bool operator<(SharedText const& _other) const noexcept { return m_view < _other.m_view; }
+
+private:
+	std::shared_ptr<void const> m_owner;
+	/// Views an empty string literal by default so that the character at @a size() is zero.
+	std::string_view m_view = "";
+};
+
+inline std::ostream& operator<<(std::ostream& _out, SharedText const& _text)
+{
+	return _out << _text.view();
+}
+
+}
@@ -23,6 +23,7 @@
 #include <libsolutil/FixedHash.h>
 
 #include <string>
+#include <string_view>
 
 namespace solidity::util
 {
@@ -33,9 +34,9 @@ h256 bzzr0Hash(std::string const& _input);
 /// Compute the "bzz hash" of @a _input (the NEW binary / BMT version)
 h256 bzzr1Hash(bytes const& _input);
 
-inline h256 bzzr1Hash(std::string const& _input)
+inline h256 bzzr1Hash(std::string_view _input)
 {
-	return bzzr1Hash(asBytes(_input));
+	return bzzr1Hash(bytes(_input.begin(), _input.end()));
 }
 
 }
@@ -0,0 +1,196 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/Profiler.h>
+
+#include <algorithm>
+#include <map>
+
+using namespace solidity;
+using namespace solidity::util;
+
+ThreadPool::ThreadPool(size_t _threadCount)
+{
+	size_t const threadCount = std::max<size_t>(_threadCount, 1);
+	m_workers.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_taskAvailable.notify_all();
+	for (std::thread& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::post(std::function<void()> _task)
+{
+	// Phases run by the workers are attributed to the profiler of the thread queueing them.
+	if (Profiler* profiler = Profiler::current())
+		_task = [profiler, task = std::move(_task)]() {
+			Profiler::Scope profilerScope(profiler);
+			task();
+		};
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queue.emplace_back(std::move(_task));
+	}
+	m_taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.wait(lock, [this]() { return m_queue.empty() && m_busyWorkers == 0; });
+}
+
+size_t ThreadPool::hardwareConcurrency()
+{
+	return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_taskAvailable.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+			// Drain the queue before stopping so that the destructor does not drop tasks.
+			if (m_queue.empty())
+				return;
+			task = std::move(m_queue.front());
+			m_queue.pop_front();
+			++m_busyWorkers;
+		}
+
+		task();
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			--m_busyWorkers;
+			if (m_queue.empty() && m_busyWorkers == 0)
+				m_idle.notify_all();
+		}
+	}
+}
+
+void util::runTaskGraph(
+	std::vector<std::set<size_t>> const& _dependencies,
+	size_t _threadCount,
+	std::function<void(size_t)> const& _task
+)
+{
+	size_t const taskCount = _dependencies.size();
+	std::vector<size_t> pendingDependencies(taskCount, 0);
+	std::vector<std::vector<size_t>> dependents(taskCount);
+	std::set<size_t> ready;
+	for (size_t task = 0; task < taskCount; ++task)
+	{
+		for (size_t dependency: _dependencies[task])
+		{
+			assertThrow(dependency < taskCount && dependency != task, InvalidTaskGraph, "");
+			dependents[dependency].push_back(task);
+		}
+		pendingDependencies[task] = _dependencies[task].size();
+		if (pendingDependencies[task] == 0)
+			ready.insert(task);
+	}
+
+	std::map<size_t, std::exception_ptr> failures;
+	size_t finishedCount = 0;
+
+	if (_threadCount <= 1 || taskCount <= 1)
+	{
+		while (!ready.empty() && failures.empty())
+		{
+			size_t const task = *ready.begin();
+			ready.erase(ready.begin());
+			try
+			{
+				_task(task);
+			}
+			catch (...)
+			{
+				failures[task] = std::current_exception();
+				break;
+			}
+			++finishedCount;
+			for (size_t dependent: dependents[task])
+				if (--pendingDependencies[dependent] == 0)
+					ready.insert(dependent);
+		}
+	}
+	else
+	{
+		ThreadPool pool(std::min(_threadCount, taskCount));
+		std::mutex mutex;
+
+		// Tasks schedule their dependents themselves, so the pool only becomes idle once no more
+		// work can be started.
+		std::function<void(size_t)> schedule = [&](size_t _index) {
+			pool.post([&, _index]() {
+				std::exception_ptr failure;
+				try
+				{
+					_task(_index);
+				}
+				catch (...)
+				{
+					failure = std::current_exception();
+				}
+
+				std::vector<size_t> nowReady;
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (failure)
+						failures[_index] = failure;
+					else
+					{
+						++finishedCount;
+						for (size_t dependent: dependents[_index])
+							if (--pendingDependencies[dependent] == 0)
+								nowReady.push_back(dependent);
+					}
+					if (!failures.empty())
+						nowReady.clear();
+				}
+				for (size_t dependent: nowReady)
+					schedule(dependent);
+			});
+		};
+
+		for (size_t task: ready)
+			schedule(task);
+		pool.wait();
+	}
+
+	if (!failures.empty())
+		std::rethrow_exception(failures.begin()->second);
+	assertThrow(finishedCount == taskCount, InvalidTaskGraph, "Cyclic task dependencies.");
+}
@@ -0,0 +1,107 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Minimal thread pool and helpers for running independent compilation tasks concurrently.
+ */
+
+#pragma once
+
+#include <libsolutil/Exceptions.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace solidity::util
+{
+
+DEV_SIMPLE_EXCEPTION(InvalidTaskGraph);
+
+/**
+ * A fixed set of worker threads executing queued tasks in FIFO order.
+ *
+ * The destructor waits for all queued tasks to finish before joining the workers.
+ * Exceptions thrown by tasks passed to @a submit() are stored in the returned future.
+ * Tasks passed to @a post() must not throw.
+ * Tasks are profiled by the Profiler that was current on the thread queueing them.
+ */
+class ThreadPool
+{
+public:
+	explicit ThreadPool(size_t _threadCount);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// Queues @a _task for execution on one of the workers.
+	void post(std::function<void()> _task);
+
+	/// Queues @a _function for execution and @returns a future for its result.
+	template<typename Function>
+	std::future<std::invoke_result_t<Function>> submit(Function&& _function)
+	{
+		using Result = std::invoke_result_t<Function>;
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(_function));
+		std::future<Result> result = task->get_future();
+		post([task]() { (*task)(); });
+		return result;
+	}
+
+	/// Blocks until the queue is empty and no worker is executing a task.
+	void wait();
+
+	size_t size() const { return m_workers.size(); }
+
+	/// @returns the number of concurrent threads supported by the hardware, at least 1.
+	static size_t hardwareConcurrency();
+
+private:
+	void work();
+
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_queue;
+	std::mutex m_mutex;
+	std::condition_variable m_taskAvailable;
+	std::condition_variable m_idle;
+	size_t m_busyWorkers = 0;
+	bool m_stopping = false;
+};
+
+/// Executes @a _task once for every index in [0, _dependencies.size()), running task @a i only
+/// after all tasks listed in @a _dependencies[i] have finished.
+/// Uses at most @a _threadCount threads. With a single thread, tasks run on the calling thread in
+/// the order of their indices whenever the dependencies allow it.
+/// If any task throws, no further tasks are started and, once running tasks have finished,
+/// the exception of the failed task with the lowest index is rethrown.
+/// @throws InvalidTaskGraph if the dependency relation refers to unknown tasks or is cyclic.
+void runTaskGraph(
+	std::vector<std::set<size_t>> const& _dependencies,
+	size_t _threadCount,
+	std::function<void(size_t)> const& _task
+);
+
+}
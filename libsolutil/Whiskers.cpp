@@ -25,15 +25,111 @@
 #include <libsolutil/Whiskers.h>
 
 #include <libsolutil/Assertions.h>
+#include <libsolutil/CommonData.h>
 
-#include <regex>
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
 
 using namespace solidity::util;
 
+/// A part of a template: literal text, a regular parameter, a list or a condition.
+struct Whiskers::Section
+{
+	enum class Kind { Text, Parameter, List, Condition, NonEmptyCondition };
+
+	Kind kind = Kind::Text;
+	/// The literal text or, for a regular parameter, the enclosing (sub-)template for error messages.
+	std::string_view text;
+	/// Name of the parameter, list or condition, without the "+" of non-empty conditions.
+	std::string name;
+	/// The part repeated for every list element or used if the condition is true.
+	std::vector<Section> body;
+	/// The part used if the condition is false.
+	std::vector<Section> elseBody;
+};
+
+struct Whiskers::ParsedTemplate
+{
+	std::string text;
+	std::vector<Section> sections;
+	/// All strings of the form "<name>", "<?name>", "</name>" and "<#name>" in the text.
+	std::set<std::string> tags;
+};
+
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' ||
+		_c == '$' ||
+		_c == '-';
+}
+
+/// @returns the position after the parameter name starting at @a _position, which is
+/// @a _position itself if there is none.
+size_t parameterEnd(std::string_view _text, size_t _position)
+{
+	while (_position < _text.size() && isParameterCharacter(_text[_position]))
+		++_position;
+	return _position;
+}
+
+bool isSpecialTagPrefix(char _c)
+{
+	return _c == '#' || _c == '?' || _c == '!' || _c == '/';
+}
+
+void checkTemplateValid(std::string_view _template)
+{
+	for (size_t position = _template.find('<'); position != std::string_view::npos; position = _template.find('<', position + 1))
+	{
+		size_t nameStart = position + 1;
+		if (nameStart == _template.size() || !isSpecialTagPrefix(_template[nameStart]))
+			continue;
+		++nameStart;
+		if (nameStart < _template.size() && _template[nameStart] == '+')
+			++nameStart;
+		size_t const nameEnd = parameterEnd(_template, nameStart);
+		assertThrow(
+			nameEnd == nameStart || (nameEnd < _template.size() && _template[nameEnd] == '>'),
+			WhiskersError,
+			"Template contains an invalid/unclosed tag " +
+			std::string(_template.substr(position, std::min(nameEnd + 1, _template.size()) - position))
+		);
+	}
+}
+
+std::set<std::string> collectTags(std::string_view _template)
+{
+	std::set<std::string> tags;
+	for (size_t position = _template.find('<'); position != std::string_view::npos; position = _template.find('<', position + 1))
+	{
+		size_t nameStart = position + 1;
+		if (nameStart < _template.size() && (_template[nameStart] == '?' || _template[nameStart] == '/' || _template[nameStart] == '#'))
+			++nameStart;
+		size_t const nameEnd = parameterEnd(_template, nameStart);
+		if (nameEnd > nameStart && nameEnd < _template.size() && _template[nameEnd] == '>')
+			tags.emplace(_template.substr(position, nameEnd + 1 - position));
+	}
+	return tags;
+}
+
+/// Templates are part of the compiler, so the cache only grows this large if they are generated.
+size_t constexpr maxCachedTemplates = 4096;
+
+}
+
 Whiskers::Whiskers(std::string _template):
-	m_template(std::move(_template))
+	m_template(parse(std::move(_template)))
 {
-	checkTemplateValid();
 }
 
 Whiskers& Whiskers::operator()(std::string _parameter, std::string _value)
@@ -71,25 +167,16 @@ Whiskers& Whiskers::operator()(
 
 std::string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
-}
-
-void Whiskers::checkTemplateValid() const
-{
-	std::regex validTemplate("<[#?!\\/]\\+{0,1}[a-zA-Z0-9_$-]+(?:[^a-zA-Z0-9_$>-]|$)");
-	std::smatch match;
-	assertThrow(
-		!regex_search(m_template, match, validTemplate),
-		WhiskersError,
-		"Template contains an invalid/unclosed tag " + match.str()
-	);
+	std::string result;
+	result.reserve(m_template->text.size());
+	render(result, m_template->sections, nullptr);
+	return result;
 }
 
 void Whiskers::checkParameterValid(std::string const& _parameter) const
 {
-	static std::regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && std::all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -120,124 +207,183 @@ void Whiskers::checkTemplateContainsTags(std::string const& _parameter, std::vec
 	{
 		std::string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != std::string::npos,
+			m_template->tags.count(tag),
 			WhiskersError,
-			"Tag '" + tag + "' not found in template:\n" + m_template
+			"Tag '" + tag + "' not found in template:\n" + m_template->text
 		);
 	}
 }
 
-namespace
-{
-template<class ReplaceCallback>
-std::string regex_replace(
-	std::string const& _source,
-	std::regex const& _pattern,
-	ReplaceCallback _replace,
-	std::regex_constants::match_flag_type _flags = std::regex_constants::match_default
-)
+std::shared_ptr<Whiskers::ParsedTemplate const> Whiskers::parse(std::string _template)
 {
-	std::sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	std::sregex_iterator matchEnd;
-	std::string::const_iterator lastMatchedPos(_source.cbegin());
-	std::string result;
-	while (curMatch != matchEnd)
+	static struct
+	{
+		std::shared_mutex mutex;
+		/// The keys are views of the texts of the parsed templates.
+		std::unordered_map<std::string_view, std::shared_ptr<ParsedTemplate const>> templates;
+	} cache;
+
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		std::shared_lock<std::shared_mutex> lock(cache.mutex);
+		if (auto const* parsed = valueOrNullptr(cache.templates, std::string_view(_template)))
+			return *parsed;
 	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
+
+	checkTemplateValid(_template);
+	// The sections refer to the text, so it must not be moved anymore after parsing.
+	auto parsed = std::make_shared<ParsedTemplate>();
+	parsed->text = std::move(_template);
+	parsed->sections = parseSections(parsed->text);
+	parsed->tags = collectTags(parsed->text);
+
+	std::unique_lock<std::shared_mutex> lock(cache.mutex);
+	if (cache.templates.size() >= maxCachedTemplates)
+		cache.templates.clear();
+	// If another thread parsed the same template in the meantime, keep its result.
+	std::string_view const text = parsed->text;
+	return cache.templates.try_emplace(text, std::move(parsed)).first->second;
 }
 
-std::string Whiskers::replace(
-	std::string const& _template,
-	StringMap const& _parameters,
-	std::map<std::string, bool> const& _conditions,
-	std::map<std::string, std::vector<StringMap>> const& _listParameters
-)
+std::vector<Whiskers::Section> Whiskers::parseSections(std::string_view _template)
 {
-	static std::regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](std::match_results<std::string::const_iterator> _match) -> std::string
+	// The first matching alternative at the earliest position is used, where the body of a list
+	// or condition extends to the first matching closing tag. Tags that are not matched remain text.
+	std::vector<Section> sections;
+	size_t textStart = 0;
+	auto const addSection = [&](size_t _start, size_t _end, Section _section) {
+		if (_start > textStart)
+			sections.push_back({Section::Kind::Text, _template.substr(textStart, _start - textStart), {}, {}, {}});
+		sections.emplace_back(std::move(_section));
+		textStart = _end;
+	};
+
+	size_t position = _template.find('<');
+	while (position != std::string_view::npos)
 	{
-		std::string tagName(_match[1]);
-		std::string listName(_match[2]);
-		std::string conditionName(_match[4]);
-		if (!tagName.empty())
+		size_t end = std::string_view::npos;
+		char const kind = position + 1 < _template.size() ? _template[position + 1] : '\0';
+		if (size_t const parameterNameEnd = parameterEnd(_template, position + 1); parameterNameEnd > position + 1)
+		{
+			if (parameterNameEnd < _template.size() && _template[parameterNameEnd] == '>')
+			{
+				end = parameterNameEnd + 1;
+				addSection(position, end, {
+					Section::Kind::Parameter,
+					_template,
+					std::string(_template.substr(position + 1, parameterNameEnd - position - 1)),
+					{},
+					{}
+				});
+			}
+		}
+		else if (kind == '#' || kind == '?')
+		{
+			size_t const nameStart = position + 2;
+			bool const nonEmptyCondition = kind == '?' && nameStart < _template.size() && _template[nameStart] == '+';
+			size_t const nameEnd = parameterEnd(_template, nameStart + (nonEmptyCondition ? 1 : 0));
+			// Includes the "+" of non-empty conditions, which is repeated in the other tags.
+			std::string_view const tagName = _template.substr(nameStart, nameEnd - nameStart);
+			if (nameEnd > nameStart + (nonEmptyCondition ? 1 : 0) && nameEnd < _template.size() && _template[nameEnd] == '>')
+			{
+				size_t const bodyStart = nameEnd + 1;
+				std::string const closingTag = "</" + std::string(tagName) + ">";
+				size_t const closingPosition = _template.find(closingTag, bodyStart);
+				if (closingPosition != std::string_view::npos)
+				{
+					end = closingPosition + closingTag.size();
+					Section section{
+						kind == '#' ? Section::Kind::List : nonEmptyCondition ? Section::Kind::NonEmptyCondition : Section::Kind::Condition,
+						{},
+						std::string(nonEmptyCondition ? tagName.substr(1) : tagName),
+						{},
+						{}
+					};
+					size_t bodyEnd = closingPosition;
+					if (kind == '?')
+					{
+						std::string const elseTag = "<!" + std::string(tagName) + ">";
+						size_t const elsePosition = _template.find(elseTag, bodyStart);
+						if (elsePosition < closingPosition)
+						{
+							bodyEnd = elsePosition;
+							size_t const elseStart = elsePosition + elseTag.size();
+							section.elseBody = parseSections(_template.substr(elseStart, closingPosition - elseStart));
+						}
+					}
+					section.body = parseSections(_template.substr(bodyStart, bodyEnd - bodyStart));
+					addSection(position, end, std::move(section));
+				}
+			}
+		}
+		position = _template.find('<', end == std::string_view::npos ? position + 1 : end);
+	}
+	if (textStart < _template.size())
+		sections.push_back({Section::Kind::Text, _template.substr(textStart), {}, {}, {}});
+	return sections;
+}
+
+void Whiskers::render(std::string& _output, std::vector<Section> const& _sections, StringMap const* _listElement) const
+{
+	// Inside a list, the parameters of the element extend the regular ones, but lists are not available.
+	auto const findParameter = [&](std::string const& _name) -> std::string const* {
+		if (_listElement)
+			if (std::string const* value = valueOrNullptr(*_listElement, _name))
+				return value;
+		return valueOrNullptr(m_parameters, _name);
+	};
+	auto const findList = [&](std::string const& _name) -> std::vector<StringMap> const* {
+		return _listElement ? nullptr : valueOrNullptr(m_listParameters, _name);
+	};
+
+	for (Section const& section: _sections)
+		switch (section.kind)
+		{
+		case Section::Kind::Text:
+			_output += section.text;
+			break;
+		case Section::Kind::Parameter:
 		{
+			std::string const* value = findParameter(section.name);
 			assertThrow(
-				_parameters.count(tagName),
+				value,
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + section.name + " not provided.\n" +
 				"Template:\n" +
-				_template
+				std::string(section.text)
 			);
-			return _parameters.at(tagName);
+			_output += *value;
+			break;
 		}
-		else if (!listName.empty())
+		case Section::Kind::List:
 		{
-			std::string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			std::string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			std::vector<StringMap> const* list = findList(section.name);
+			assertThrow(list, WhiskersError, "List parameter " + section.name + " not set.");
+			for (StringMap const& element: *list)
+			{
+				for (auto const& parameter: element)
+					assertThrow(!m_parameters.count(parameter.first), WhiskersError, "Parameter collision");
+				render(_output, section.body, &element);
+			}
+			break;
 		}
-		else
+		case Section::Kind::Condition:
+		{
+			bool const* condition = valueOrNullptr(m_conditions, section.name);
+			assertThrow(condition, WhiskersError, "Condition parameter " + section.name + " not set.");
+			render(_output, *condition ? section.body : section.elseBody, _listElement);
+			break;
+		}
+		case Section::Kind::NonEmptyCondition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				std::string tag = conditionName.substr(1);
-
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
-				else
-					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
-			}
+			if (std::string const* value = findParameter(section.name))
+				conditionValue = !value->empty();
+			else if (std::vector<StringMap> const* list = findList(section.name))
+				conditionValue = !list->empty();
 			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
+				assertThrow(false, WhiskersError, "Tag " + section.name + " used as condition but was not set.");
+			render(_output, conditionValue ? section.body : section.elseBody, _listElement);
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
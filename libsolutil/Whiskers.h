@@ -28,6 +28,8 @@
 
 #include <string>
 #include <map>
+#include <memory>
+#include <string_view>
 #include <vector>
 
 namespace solidity::util
@@ -67,6 +69,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *    Works similar to a conditional parameter where the checked condition is
  *    that the string or list parameter called "name" is non-empty or contains
  *    no elements respectively.
+ *
+ * Templates are parsed once and the result is shared by all instances using the same
+ * template text, so that rendering only has to copy the text and the values.
  */
 class Whiskers
 {
@@ -90,31 +95,30 @@ public:
 	std::string render() const;
 
 private:
+	struct Section;
+	struct ParsedTemplate;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
-	void checkTemplateValid() const;
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	/// Checks whether the string stored in `m_template` contains all the tags specified.
+	/// Checks whether the template contains all the tags specified.
 	/// @param _parameter name of the parameter. This name is used to construct the tag(s).
 	/// @param _prefixes a vector of strings, where each element is used to compose the tag
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
+	/// @returns the parsed template with the text @a _template, parsing it only if it is not cached.
+	static std::shared_ptr<ParsedTemplate const> parse(std::string _template);
+	/// Splits @a _template into sections, recursing into the bodies of lists and conditions.
+	static std::vector<Section> parseSections(std::string_view _template);
 
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	/// Appends the expansion of @a _sections to @a _output. Inside the body of a list, @a _listElement
+	/// is the parameter mapping of the current element, which extends the regular parameters.
+	void render(std::string& _output, std::vector<Section> const& _sections, StringMap const* _listElement) const;
 
-	std::string m_template;
+	std::shared_ptr<ParsedTemplate const> m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
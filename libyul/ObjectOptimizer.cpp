@@ -20,6 +20,7 @@
 
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmAnalysis.h>
+#include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
@@ -28,14 +29,25 @@
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Suite.h>
 
+#include <liblangutil/CharStream.h>
 #include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Exceptions.h>
 
+#include <libsolutil/CommonIO.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem/operations.hpp>
 
+#include <fstream>
+#include <functional>
 #include <limits>
 #include <numeric>
+#include <set>
+#include <vector>
 
 using namespace solidity;
 using namespace solidity::langutil;
@@ -54,28 +66,45 @@ Dialect const& yul::languageToDialect(Language _language, EVMVersion _version, s
 	util::unreachable();
 }
 
-void ObjectOptimizer::optimize(Object& _object, Settings const& _settings)
+void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, size_t _threadCount)
 {
 	yulAssert(_object.subId == std::numeric_limits<size_t>::max(), "Not a top-level object.");
 
-	optimize(_object, _settings, true /* _isCreation */);
+	// An object only has to wait for its subobjects. Listing the objects in post-order makes
+	// the single-threaded order the same as that of a recursive traversal.
+	std::vector<std::pair<Object*, bool>> objects;
+	std::vector<std::set<size_t>> dependencies;
+	std::function<size_t(Object&, bool)> collectObjects = [&](Object& _current, bool _isCreation) {
+		std::set<size_t> subObjectIndices;
+		for (auto& subNode: _current.subObjects)
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+			{
+				bool isCreation = !boost::ends_with(subObject->name, "_deployed");
+				subObjectIndices.insert(collectObjects(*subObject, isCreation));
+			}
+		objects.emplace_back(&_current, _isCreation);
+		dependencies.emplace_back(std::move(subObjectIndices));
+		return objects.size() - 1;
+	};
+	collectObjects(_object, true /* _isCreation */);
+
+	runTaskGraph(dependencies, _threadCount, [&](size_t _index) {
+		auto const& [object, isCreation] = objects[_index];
+		optimizeCode(*object, _settings, isCreation);
+	});
+}
+
+void ObjectOptimizer::setPersistentCacheDirectory(boost::filesystem::path _directory, std::string _compilerVersion)
+{
+	m_persistentCacheDirectory = std::move(_directory);
+	m_compilerVersion = std::move(_compilerVersion);
 }
 
-void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool _isCreation)
+void ObjectOptimizer::optimizeCode(Object& _object, Settings const& _settings, bool _isCreation)
 {
 	yulAssert(_object.code());
 	yulAssert(_object.debugData);
-
-	for (auto& subNode: _object.subObjects)
-		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-		{
-			bool isCreation = !boost::ends_with(subObject->name, "_deployed");
-			optimize(
-				*subObject,
-				_settings,
-				isCreation
-			);
-		}
+	util::Profiler::Probe probe("Yul object optimization", "yul-optimizer", _object.name);
 
 	Dialect const& dialect = languageToDialect(_settings.language, _settings.evmVersion, _settings.eofVersion);
 	std::unique_ptr<GasMeter> meter;
@@ -83,10 +112,15 @@ void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool
 		meter = std::make_unique<GasMeter>(*evmDialect, _isCreation, _settings.expectedExecutionsPerDeployment);
 
 	std::optional<h256> cacheKey = calculateCacheKey(_object.code()->root(), *_object.debugData, _settings, _isCreation);
-	if (cacheKey.has_value() && m_cachedObjects.count(*cacheKey) != 0)
+	if (cacheKey.has_value())
 	{
-		overwriteWithOptimizedObject(*cacheKey, _object);
-		return;
+		if (overwriteWithOptimizedObject(*cacheKey, _object))
+			return;
+		if (
+			loadPersistedObject(*cacheKey, *_object.debugData, dialect) &&
+			overwriteWithOptimizedObject(*cacheKey, _object)
+		)
+			return;
 	}
 
 	OptimiserSuite::run(
@@ -100,21 +134,35 @@ void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool
 	);
 
 	if (cacheKey.has_value())
+	{
 		storeOptimizedObject(*cacheKey, _object, dialect);
+		persistOptimizedObject(*cacheKey, _object, dialect);
+	}
 }
 
 void ObjectOptimizer::storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect)
 {
-	m_cachedObjects[_cacheKey] = CachedObject{
+	CachedObject cachedObject{
 		std::make_shared<Block>(ASTCopier{}.translate(_optimizedObject.code()->root())),
 		&_dialect,
 	};
+
+	std::lock_guard<std::mutex> lock(m_cacheMutex);
+	// Another thread may have stored the same object in the meantime. The results are identical.
+	m_cachedObjects.emplace(_cacheKey, std::move(cachedObject));
 }
 
-void ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const
+bool ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const
 {
-	yulAssert(m_cachedObjects.count(_cacheKey) != 0);
-	CachedObject const& cachedObject = m_cachedObjects.at(_cacheKey);
+	CachedObject cachedObject;
+	{
+		std::lock_guard<std::mutex> lock(m_cacheMutex);
+		auto it = m_cachedObjects.find(_cacheKey);
+		if (it == m_cachedObjects.end())
+			return false;
+		// Cached ASTs are immutable, so they can be copied outside of the lock.
+		cachedObject = it->second;
+	}
 
 	yulAssert(cachedObject.optimizedAST);
 	yulAssert(cachedObject.dialect);
@@ -131,6 +179,90 @@ void ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object&
 	);
 
 	// NOTE: Source name index is included in the key so it must be identical. No need to store and restore it.
+	return true;
+}
+
+bool ObjectOptimizer::loadPersistedObject(h256 _cacheKey, ObjectDebugData const& _debugData, Dialect const& _dialect)
+{
+	if (m_persistentCacheDirectory.empty())
+		return false;
+
+	std::ifstream file(persistedObjectPath(_cacheKey).string(), std::ios::binary);
+	if (!file)
+		return false;
+	std::string header;
+	if (!std::getline(file, header))
+		return false;
+	std::string source = readUntilEnd(file);
+	// The header guards against truncated or otherwise corrupted files.
+	if (header != "// " + keccak256(source).hex())
+		return false;
+
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(std::move(source), "");
+	std::unique_ptr<AST> ast;
+	try
+	{
+		ast = Parser(errorReporter, _dialect, _debugData.sourceNames).parse(charStream);
+	}
+	catch (FatalError const&)
+	{
+		return false;
+	}
+	if (!ast || errorReporter.hasErrors())
+		return false;
+
+	CachedObject cachedObject{
+		std::make_shared<Block>(ASTCopier{}.translate(ast->root())),
+		&_dialect,
+	};
+
+	std::lock_guard<std::mutex> lock(m_cacheMutex);
+	m_cachedObjects.emplace(_cacheKey, std::move(cachedObject));
+	return true;
+}
+
+void ObjectOptimizer::persistOptimizedObject(h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect) const
+{
+	if (m_persistentCacheDirectory.empty())
+		return;
+
+	yulAssert(_optimizedObject.debugData);
+	std::string source = AsmPrinter(
+		_dialect,
+		_optimizedObject.debugData->sourceNames,
+		DebugInfoSelection::All()
+	)(_optimizedObject.code()->root());
+
+	boost::system::error_code error;
+	boost::filesystem::create_directories(m_persistentCacheDirectory, error);
+	if (error)
+		return;
+
+	// Write to a temporary file first and rename it so that concurrent compiler processes
+	// sharing the directory never observe partially written entries.
+	boost::filesystem::path temporaryPath = m_persistentCacheDirectory / boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+	{
+		std::ofstream file(temporaryPath.string(), std::ios::binary | std::ios::trunc);
+		file << "// " << keccak256(source).hex() << "\n" << source;
+		if (!file)
+		{
+			file.close();
+			boost::filesystem::remove(temporaryPath, error);
+			return;
+		}
+	}
+	boost::filesystem::rename(temporaryPath, persistedObjectPath(_cacheKey), error);
+	if (error)
+		boost::filesystem::remove(temporaryPath, error);
+}
+
+boost::filesystem::path ObjectOptimizer::persistedObjectPath(h256 _cacheKey) const
+{
+	bytes rawKey = _cacheKey.asBytes();
+	rawKey += keccak256(m_compilerVersion).asBytes();
+	return m_persistentCacheDirectory / (keccak256(rawKey).hex() + ".yul");
 }
 
 std::optional<h256> ObjectOptimizer::calculateCacheKey(
@@ -25,8 +25,11 @@
 
 #include <libsolutil/FixedHash.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 
 namespace solidity::yul
@@ -48,6 +51,12 @@ Dialect const& languageToDialect(Language _language, langutil::EVMVersion _versi
 /// Caching is performed at the granularity of individual ASTs rather than whole object trees,
 /// which means that reuse is possible even within a single hierarchy, e.g. when creation and
 /// deployed objects have common dependencies.
+///
+/// Optionally, optimized ASTs can also be persisted in a directory on disk so that they can be
+/// reused by later compiler invocations. Entries on disk are additionally keyed by the compiler
+/// version and are ignored if they cannot be read back or fail to parse.
+///
+/// A single instance can be used to optimize different objects from multiple threads at once.
 class ObjectOptimizer
 {
 public:
@@ -68,10 +77,28 @@ public:
 	/// Recursively optimizes a Yul object with given settings, reusing cached ASTs where possible
 	/// or caching the result otherwise. The object is modified in-place.
 	/// Automatically accounts for the difference between creation and deployed objects.
+	/// Objects that do not contain each other are optimized concurrently on up to @a _threadCount
+	/// threads. The result does not depend on the number of threads.
 	/// @warning Does not ensure that nativeLocations in the resulting AST match the optimized code.
-	void optimize(Object& _object, Settings const& _settings);
+	void optimize(Object& _object, Settings const& _settings, size_t _threadCount = 1);
+
+	/// Enables the persistent cache in @a _directory, which is created when needed.
+	/// An empty path disables it. Entries written by a compiler with a different
+	/// @a _compilerVersion are never reused.
+	/// Must not be called while an optimization is in progress.
+	void setPersistentCacheDirectory(boost::filesystem::path _directory, std::string _compilerVersion);
 
-	size_t size() const { return m_cachedObjects.size(); }
+	size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(m_cacheMutex);
+		return m_cachedObjects.size();
+	}
+	/// Removes all objects cached in memory. The persistent cache is not affected.
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(m_cacheMutex);
+		m_cachedObjects.clear();
+	}
 
 private:
 	struct CachedObject
@@ -80,10 +107,20 @@ private:
 		Dialect const* dialect;
 	};
 
-	void optimize(Object& _object, Settings const& _settings, bool _isCreation);
+	/// Optimizes the code of @a _object, assuming that its subobjects have already been optimized.
+	void optimizeCode(Object& _object, Settings const& _settings, bool _isCreation);
 
 	void storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect);
-	void overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const;
+	/// Replaces the code of @a _object with the cached optimized AST.
+	/// @returns false if there is no cache entry for @a _cacheKey.
+	bool overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const;
+
+	/// Looks up @a _cacheKey in the persistent cache and, if found, stores the entry in memory.
+	/// @returns false if the persistent cache is disabled or has no valid entry.
+	bool loadPersistedObject(util::h256 _cacheKey, ObjectDebugData const& _debugData, Dialect const& _dialect);
+	/// Writes the optimized code of @a _object to the persistent cache. I/O errors are ignored.
+	void persistOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect) const;
+	boost::filesystem::path persistedObjectPath(util::h256 _cacheKey) const;
 
 	static std::optional<util::h256> calculateCacheKey(
 		Block const& _ast,
@@ -93,6 +130,11 @@ private:
 	);
 
 	std::map<util::h256, CachedObject> m_cachedObjects;
+	/// Guards m_cachedObjects. Never held while the optimizer is running.
+	std::mutex mutable m_cacheMutex;
+
+	boost::filesystem::path m_persistentCacheDirectory;
+	std::string m_compilerVersion;
 };
 
 }
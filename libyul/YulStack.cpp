@@ -32,6 +32,7 @@
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -53,6 +54,7 @@ CharStream const& YulStack::charStream(std::string const& _sourceName) const
 bool YulStack::parse(std::string const& _sourceName, std::string const& _source)
 {
 	yulAssert(m_stackState == Empty);
+	util::Profiler::Probe probe("Yul parsing", "parsing", _sourceName);
 	try
 	{
 		m_charStream = std::make_unique<CharStream>(_source, _sourceName);
@@ -86,7 +88,7 @@ bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const
 	return analyzeParsed();
 }
 
-void YulStack::optimize()
+void YulStack::optimize(size_t _threadCount)
 {
 	yulAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	yulAssert(m_parserResult);
@@ -136,7 +138,8 @@ void YulStack::optimize()
 				yulOptimiserSteps,
 				yulOptimiserCleanupSteps,
 				m_optimiserSettings.expectedExecutionsPerDeployment
-			}
+			},
+			_threadCount
 		);
 
 		// Optimizer does not maintain correct native source locations in the AST.
@@ -193,6 +196,7 @@ bool YulStack::analyzeParsed(Object& _object)
 
 void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 {
+	util::Profiler::Probe probe("Yul code transform", "codegen", m_parserResult->name);
 	EVMObjectCompiler::compile(*m_parserResult, _assembly, _optimize);
 }
 
@@ -225,6 +229,7 @@ void YulStack::reparse()
 
 	m_stackState = AnalysisSuccessful;
 	m_parserResult = std::move(cleanStack.m_parserResult);
+	m_printedSource = std::move(source);
 
 	// NOTE: We keep the char stream, and errors, even though they no longer match the object,
 	// because it's the original source that matters to the user. Optimized code may have different
@@ -302,7 +307,7 @@ YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName)
 }
 
 std::pair<std::shared_ptr<evmasm::Assembly>, std::shared_ptr<evmasm::Assembly>>
-YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName)
+YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName, size_t _threadCount)
 {
 	yulAssert(m_stackState >= AnalysisSuccessful);
 	yulAssert(m_parserResult, "");
@@ -323,7 +328,10 @@ YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName)
 	{
 		compileEVM(adapter, optimize);
 
-		assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+		assembly.optimise(
+			evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion),
+			_threadCount
+		);
 
 		std::optional<size_t> subIndex;
 
@@ -368,6 +376,8 @@ std::string YulStack::print() const
 	yulAssert(m_stackState >= Parsed);
 	yulAssert(m_parserResult, "");
 	yulAssert(m_parserResult->hasCode(), "");
+	if (m_printedSource)
+		return *m_printedSource;
 	return m_parserResult->toString(
 		m_debugInfoSelection,
 		m_soliditySourceProvider
@@ -38,6 +38,7 @@
 #include <libevmasm/LinkerObject.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace solidity::evmasm
@@ -114,7 +115,8 @@ public:
 
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
-	void optimize();
+	/// Independent objects are optimized concurrently on up to @a _threadCount threads.
+	void optimize(size_t _threadCount = 1);
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	MachineAssemblyObject assemble(Machine _machine);
@@ -130,10 +132,12 @@ public:
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	/// Similar to @a assemblyWithDeployed, but returns EVM assembly objects.
+	/// Sub-assemblies are optimised concurrently on up to @a _threadCount threads.
 	/// Only available for EVM.
 	std::pair<std::shared_ptr<evmasm::Assembly>, std::shared_ptr<evmasm::Assembly>>
 	assembleEVMWithDeployed(
-		std::optional<std::string_view> _deployName = {}
+		std::optional<std::string_view> _deployName = {},
+		size_t _threadCount = 1
 	);
 
 	/// @returns the errors generated during parsing, analysis (and potentially assembly).
@@ -142,6 +146,7 @@ public:
 	bool hasErrorsWarningsOrInfos() const { return m_errorReporter.hasErrorsWarningsOrInfos(); }
 
 	/// Pretty-print the input after having parsed it.
+	/// After optimization, returns the source already printed for reparsing.
 	std::string print() const;
 	Json astJson() const;
 
@@ -155,6 +160,10 @@ public:
 
 	langutil::DebugInfoSelection debugInfoSelection() const { return m_debugInfoSelection; }
 
+	/// @returns true if @a optimize() printed and re-parsed the object, which means that the debug info
+	/// in the AST is exactly the one that parsing the output of @a print() would produce.
+	bool reparsed() const { return m_printedSource.has_value(); }
+
 private:
 	bool parse(std::string const& _sourceName, std::string const& _source);
 	bool analyzeParsed();
@@ -186,6 +195,8 @@ private:
 
 	State m_stackState = Empty;
 	std::shared_ptr<yul::Object> m_parserResult;
+	/// Source printed by @a reparse(). The reparsed object prints to exactly the same source.
+	std::optional<std::string> m_printedSource;
 	langutil::ErrorList m_errors;
 	langutil::ErrorReporter m_errorReporter;
 
@@ -25,6 +25,9 @@
 
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -37,6 +40,7 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+/// The repository can be used from multiple threads concurrently, with the exception of @a reset().
 class YulStringRepository
 {
 public:
@@ -57,17 +61,28 @@ public:
 		if (_string.empty())
 			return { 0, emptyHash() };
 		std::uint64_t h = hash(_string);
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			if (std::optional<Handle> handle = findHandle(_string, h))
+				return *handle;
+		}
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		// Another thread might have inserted the string in the meantime.
+		if (std::optional<Handle> handle = findHandle(_string, h))
+			return *handle;
 		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
 		m_strings.emplace_back(std::make_shared<std::string>(_string));
 		size_t id = m_strings.size() - 1;
 		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
 
 		return Handle{id, h};
 	}
-	std::string const& idToString(size_t _id) const { return *m_strings.at(_id); }
+	std::string const& idToString(size_t _id) const
+	{
+		// The strings themselves are never moved, only the pointers to them.
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		return *m_strings.at(_id);
+	}
 
 	static std::uint64_t hash(std::string_view const v)
 	{
@@ -88,35 +103,99 @@ public:
 	/// resetCallback.
 	static void reset()
 	{
-		for (auto const& cb: resetCallbacks())
+		std::vector<std::function<void()>> callbacks;
+		{
+			ResetCallbacks& registered = resetCallbacks();
+			std::lock_guard<std::mutex> lock(registered.mutex);
+			callbacks = registered.callbacks;
+		}
+		for (auto const& cb: callbacks)
 			cb();
-		instance() = YulStringRepository{};
+		YulStringRepository& repository = instance();
+		std::unique_lock<std::shared_mutex> lock(repository.m_mutex);
+		repository.m_strings = {std::make_shared<std::string>()};
+		repository.m_hashToID = {{emptyHash(), 0}};
+	}
+	/// Clears the repository via @a reset() unless it is currently in use by a @a Usage object.
+	static void resetIfUnused()
+	{
+		UsageCounter& counter = usageCounter();
+		std::lock_guard<std::mutex> lock(counter.mutex);
+		if (counter.count == 0)
+			reset();
 	}
+	/// Marks the repository as being in use, e.g. by a compilation, for the lifetime of the object.
+	/// Prevents @a resetIfUnused() called from other threads from invalidating existing YulStrings.
+	struct Usage
+	{
+		Usage()
+		{
+			UsageCounter& counter = usageCounter();
+			std::lock_guard<std::mutex> lock(counter.mutex);
+			++counter.count;
+		}
+		~Usage()
+		{
+			UsageCounter& counter = usageCounter();
+			std::lock_guard<std::mutex> lock(counter.mutex);
+			--counter.count;
+		}
+		Usage(Usage const&) = delete;
+		Usage& operator=(Usage const&) = delete;
+	};
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
+			ResetCallbacks& registered = YulStringRepository::resetCallbacks();
+			std::lock_guard<std::mutex> lock(registered.mutex);
+			registered.callbacks.emplace_back(std::move(_fun));
 		}
 	};
 
 private:
 	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
+	/// Must be called with m_mutex held.
+	std::optional<Handle> findHandle(std::string_view const _string, std::uint64_t _hash) const
+	{
+		auto range = m_hashToID.equal_range(_hash);
+		for (auto it = range.first; it != range.second; ++it)
+			if (*m_strings[it->second] == _string)
+				return Handle{it->second, _hash};
+		return std::nullopt;
+	}
+
+	/// Registered from function-local statics, whose first use can happen on several threads at once.
+	struct ResetCallbacks
 	{
-		static std::vector<std::function<void()>> callbacks;
+		std::mutex mutex;
+		std::vector<std::function<void()>> callbacks;
+	};
+	static ResetCallbacks& resetCallbacks()
+	{
+		static ResetCallbacks callbacks;
 		return callbacks;
 	}
 
+	struct UsageCounter
+	{
+		std::mutex mutex;
+		size_t count = 0;
+	};
+	static UsageCounter& usageCounter()
+	{
+		static UsageCounter counter;
+		return counter;
+	}
+
 	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
 	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::shared_mutex mutable m_mutex;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -157,6 +236,9 @@ public:
 	}
 
 	uint64_t hash() const { return m_handle.hash; }
+	/// @returns the ID of the string in the repository. IDs are assigned consecutively, starting
+	/// with zero for the empty string, and stay valid until the repository is reset.
+	size_t id() const { return m_handle.id; }
 
 private:
 	/// Handle of the string. Assumes that the empty string has ID zero.
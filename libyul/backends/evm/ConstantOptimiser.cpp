@@ -26,8 +26,11 @@
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 
+#include <libevmasm/ConstantRepresentationCache.h>
+
 #include <libsolutil/CommonData.h>
 
+#include <functional>
 #include <variant>
 
 using namespace solidity;
@@ -87,6 +90,74 @@ struct MiniEVMInterpreter
 
 	EVMDialect const& m_dialect;
 };
+
+evmasm::ConstantRepresentationCache::Key cacheKey(EVMDialect const& _dialect, GasMeter const& _meter, u256 const& _value)
+{
+	return {
+		evmasm::ConstantRepresentationCache::CostModel::Yul,
+		_value,
+		_dialect.evmVersion(),
+		_meter.isCreation(),
+		_meter.runs()
+	};
+}
+
+/// @returns true if argument @a _index of a call to @a _instruction built by the search is the
+/// representation of another constant rather than an expression built specifically for it.
+bool isSearchedArgument(evmasm::Instruction _instruction, size_t _index)
+{
+	switch (_instruction)
+	{
+	case evmasm::Instruction::NOT:
+	case evmasm::Instruction::MUL:
+		return _index == 0;
+	case evmasm::Instruction::SHL:
+	case evmasm::Instruction::ADD:
+	case evmasm::Instruction::SUB:
+		return _index == 1;
+	default:
+		return false;
+	}
+}
+
+BuiltinHandle builtinHandle(EVMDialect const& _dialect, evmasm::Instruction _instruction)
+{
+	auto const& auxHandles = _dialect.auxiliaryBuiltinHandles();
+	std::optional<BuiltinHandle> handle;
+	switch (_instruction)
+	{
+	case evmasm::Instruction::ADD: handle = auxHandles.add; break;
+	case evmasm::Instruction::EXP: handle = auxHandles.exp; break;
+	case evmasm::Instruction::MUL: handle = auxHandles.mul; break;
+	case evmasm::Instruction::NOT: handle = auxHandles.not_; break;
+	case evmasm::Instruction::SHL: handle = auxHandles.shl; break;
+	case evmasm::Instruction::SUB: handle = auxHandles.sub; break;
+	default: break;
+	}
+	yulAssert(handle, "Invalid operation in memoised constant representation.");
+	return *handle;
+}
+
+/// @returns the items evaluating @a _expression, where representations of other constants
+/// are replaced by pushing the constant (see isSearchedArgument()).
+evmasm::AssemblyItems toRoutine(EVMDialect const& _dialect, Expression const& _expression)
+{
+	if (Literal const* literal = std::get_if<Literal>(&_expression))
+		return {evmasm::AssemblyItem(literal->value.value())};
+
+	FunctionCall const& call = std::get<FunctionCall>(_expression);
+	BuiltinFunctionForEVM const* builtin = resolveBuiltinFunctionForEVM(call.functionName, _dialect);
+	yulAssert(builtin && builtin->instruction, "Expected EVM instruction.");
+	evmasm::AssemblyItems routine;
+	// The first argument ends up on top of the stack.
+	for (size_t i = call.arguments.size(); i-- > 0;)
+		if (isSearchedArgument(*builtin->instruction, i))
+			routine.emplace_back(MiniEVMInterpreter{_dialect}.eval(call.arguments[i]));
+		else
+			routine += toRoutine(_dialect, call.arguments[i]);
+	routine.emplace_back(*builtin->instruction);
+	return routine;
+}
 }
 
 void ConstantOptimiser::visit(Expression& _e)
@@ -97,10 +168,14 @@ void ConstantOptimiser::visit(Expression& _e)
 		if (literal.kind != LiteralKind::Number)
 			return;
 
+		u256 const value = literal.value.value();
+		if (value >= 0x10000 && !m_cache.count(value))
+			restoreRepresentation(value, debugDataOf(_e));
+
 		if (
 			Expression const* repr =
 				RepresentationFinder(m_dialect, m_meter, debugDataOf(_e), m_cache)
-				.tryFindRepresentation(literal.value.value())
+				.tryFindRepresentation(value)
 		)
 			_e = ASTCopier{}.translate(*repr);
 	}
@@ -108,6 +183,87 @@ void ConstantOptimiser::visit(Expression& _e)
 		ASTModifier::visit(_e);
 }
 
+bool ConstantOptimiser::restoreRepresentation(u256 const& _value, langutil::DebugData::ConstPtr const& _debugData)
+{
+	using evmasm::ConstantRepresentationCache;
+
+	// The memoised representations are the ones a search from scratch finds. A search in the
+	// current cache finds the same as long as the cached representations it reuses are exact and
+	// it does not run out of steps, which takes fewer steps than a search from scratch.
+	std::map<u256, ConstantRepresentationCache::Entry> entries;
+	std::function<bool(u256 const&)> collectEntries = [&](u256 const& _constant) {
+		if (auto it = m_cache.find(_constant); it != m_cache.end())
+			return it->second.exact;
+		if (entries.count(_constant))
+			return true;
+		std::optional<ConstantRepresentationCache::Entry> entry =
+			ConstantRepresentationCache::find(cacheKey(m_dialect, m_meter, _constant));
+		if (!entry)
+			return false;
+		ConstantRepresentationCache::Entry const& collected = entries[_constant] = std::move(*entry);
+		for (u256 const& searchedConstant: collected.searchedConstants)
+			if (!collectEntries(searchedConstant))
+				return false;
+		return true;
+	};
+	if (!collectEntries(_value) || entries.at(_value).searchSteps >= RepresentationFinder::maxSteps)
+		return false;
+
+	// Build the representations in the same order as the search would.
+	std::function<void(u256 const&)> restore = [&](u256 const& _constant) {
+		if (m_cache.count(_constant))
+			return;
+		ConstantRepresentationCache::Entry const& entry = entries.at(_constant);
+		for (u256 const& searchedConstant: entry.searchedConstants)
+			restore(searchedConstant);
+
+		Representation repr;
+		if (entry.method == ConstantRepresentationCache::Method::Compute)
+			repr.expression = std::make_unique<Expression>(fromRoutine(entry.routine, _debugData));
+		else
+			repr.expression = std::make_unique<Expression>(
+				Literal{_debugData, LiteralKind::Number, LiteralValue{_constant, formatNumber(_constant)}}
+			);
+		yulAssert(MiniEVMInterpreter{m_dialect}.eval(*repr.expression) == _constant, "Invalid memoised representation.");
+		repr.cost = entry.cost;
+		repr.searchSteps = entry.searchSteps;
+		m_cache.emplace(_constant, std::move(repr));
+	};
+	restore(_value);
+	return true;
+}
+
+Expression ConstantOptimiser::fromRoutine(
+	evmasm::AssemblyItems const& _routine,
+	langutil::DebugData::ConstPtr const& _debugData
+) const
+{
+	std::vector<Expression> stack;
+	for (evmasm::AssemblyItem const& item: _routine)
+		if (item.type() == evmasm::Push)
+			stack.emplace_back(Literal{_debugData, LiteralKind::Number, LiteralValue{item.data(), formatNumber(item.data())}});
+		else
+		{
+			yulAssert(item.type() == evmasm::Operation);
+			FunctionCall call{_debugData, BuiltinName{_debugData, builtinHandle(m_dialect, item.instruction())}, {}};
+			yulAssert(stack.size() >= item.arguments());
+			for (size_t i = 0; i < item.arguments(); ++i)
+			{
+				if (isSearchedArgument(item.instruction(), i))
+				{
+					u256 const& constant = std::get<Literal>(stack.back()).value.value();
+					call.arguments.emplace_back(ASTCopier{}.translate(*m_cache.at(constant).expression));
+				}
+				else
+					call.arguments.emplace_back(std::move(stack.back()));
+				stack.pop_back();
+			}
+			stack.emplace_back(std::move(call));
+		}
+	yulAssert(stack.size() == 1);
+	return std::move(stack.back());
+}
+
 Expression const* RepresentationFinder::tryFindRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
@@ -133,14 +289,23 @@ Representation const& RepresentationFinder::findRepresentation(u256 const& _valu
 
 	auto const& auxHandles = m_dialect.auxiliaryBuiltinHandles();
 
+	// Recorded to memoise the result, see ConstantOptimiser::restoreRepresentation().
+	std::vector<u256> searchedConstants;
+	size_t searchSteps = 0;
+	auto search = [&](u256 const& _constant) -> Representation const& {
+		searchedConstants.emplace_back(_constant);
+		return findRepresentation(_constant);
+	};
+
 	Representation routine = represent(_value);
 
 	if (numberEncodingSize(~_value) < numberEncodingSize(_value))
 		// Negated is shorter to represent
-		routine = min(std::move(routine), represent(*auxHandles.not_, findRepresentation(~_value)));
+		routine = min(std::move(routine), represent(*auxHandles.not_, search(~_value)));
 
 	// Decompose value into a * 2**k + b where abs(b) << 2**k
-	for (unsigned bits = 255; bits > 8 && m_maxSteps > 0; --bits)
+	unsigned bits = 255;
+	for (; bits > 8 && m_maxSteps > 0; --bits)
 	{
 		unsigned gapDetector = unsigned((_value >> (bits - 8)) & 0x1ff);
 		if (gapDetector != 0xff && gapDetector != 0x100)
@@ -160,27 +325,51 @@ Representation const& RepresentationFinder::findRepresentation(u256 const& _valu
 			continue;
 		Representation newRoutine;
 		if (m_dialect.evmVersion().hasBitwiseShifting())
-			newRoutine = represent(*auxHandles.shl, represent(bits), findRepresentation(upperPart));
+			newRoutine = represent(*auxHandles.shl, represent(bits), search(upperPart));
 		else
 		{
 			newRoutine = represent(*auxHandles.exp, represent(2), represent(bits));
 			if (upperPart != 1)
-				newRoutine = represent(*auxHandles.mul, findRepresentation(upperPart), newRoutine);
+				newRoutine = represent(*auxHandles.mul, search(upperPart), newRoutine);
 		}
 
 		if (newRoutine.cost >= routine.cost)
 			continue;
 
 		if (lowerPart > 0)
-			newRoutine = represent(*auxHandles.add, newRoutine, findRepresentation(u256(abs(lowerPart))));
+			newRoutine = represent(*auxHandles.add, newRoutine, search(u256(abs(lowerPart))));
 		else if (lowerPart < 0)
-			newRoutine = represent(*auxHandles.sub, newRoutine, findRepresentation(u256(abs(lowerPart))));
+			newRoutine = represent(*auxHandles.sub, newRoutine, search(u256(abs(lowerPart))));
 
 		if (m_maxSteps > 0)
 			m_maxSteps--;
+		searchSteps++;
 		routine = min(std::move(routine), std::move(newRoutine));
 	}
 	yulAssert(MiniEVMInterpreter{m_dialect}.eval(*routine.expression) == _value, "Invalid expression generated.");
+
+	// The loop is only cut short if the search runs out of steps.
+	routine.exact = bits == 8;
+	for (u256 const& constant: searchedConstants)
+	{
+		Representation const& searched = m_cache.at(constant);
+		routine.exact = routine.exact && searched.exact;
+		routine.searchSteps += searched.searchSteps;
+	}
+	routine.searchSteps += searchSteps;
+
+	if (routine.exact)
+	{
+		using evmasm::ConstantRepresentationCache;
+		bool computed = std::holds_alternative<FunctionCall>(*routine.expression);
+		ConstantRepresentationCache::store(cacheKey(m_dialect, m_meter, _value), {
+			computed ? ConstantRepresentationCache::Method::Compute : ConstantRepresentationCache::Method::Literal,
+			computed ? toRoutine(m_dialect, *routine.expression) : evmasm::AssemblyItems{},
+			routine.cost,
+			searchedConstants,
+			routine.searchSteps
+		});
+	}
 	return m_cache[_value] = std::move(routine);
 }
 
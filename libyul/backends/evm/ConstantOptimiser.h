@@ -27,6 +27,8 @@
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/ASTForward.h>
 
+#include <libevmasm/AssemblyItem.h>
+
 #include <liblangutil/DebugData.h>
 
 #include <libsolutil/Common.h>
@@ -43,6 +45,8 @@ class GasMeter;
 /**
  * Optimisation stage that replaces constants by expressions that compute them.
  *
+ * The representations found are memoised process-wide in evmasm::ConstantRepresentationCache.
+ *
  * Prerequisite: None
  */
 class ConstantOptimiser: public ASTModifier
@@ -59,9 +63,23 @@ public:
 	{
 		std::unique_ptr<Expression> expression;
 		bigint cost;
+		/// False if the search ran out of steps while looking for this representation or one it
+		/// is built from, so that a search from scratch might find a different one.
+		bool exact = true;
+		/// Upper bound on the steps a search from scratch takes to find this representation.
+		size_t searchSteps = 0;
 	};
 
 private:
+	/// Adds the representations memoised for @a _value and the constants searched along with it
+	/// to the cache, if they are what a search would find in the current state of the cache.
+	/// Newly built expressions carry @a _debugData, just like those of a search.
+	/// @returns false if that cannot be guaranteed, in which case the cache is not modified.
+	bool restoreRepresentation(u256 const& _value, langutil::DebugData::ConstPtr const& _debugData);
+	/// @returns the expression evaluating the items of @a _routine, with the representations of
+	/// the searched constants taken from the cache.
+	Expression fromRoutine(evmasm::AssemblyItems const& _routine, langutil::DebugData::ConstPtr const& _debugData) const;
+
 	EVMDialect const& m_dialect;
 	GasMeter const& m_meter;
 	std::map<u256, Representation> m_cache;
@@ -83,6 +101,9 @@ public:
 		m_cache(_cache)
 	{}
 
+	/// Number of steps after which the search stops looking for cheaper representations.
+	static size_t constexpr maxSteps = 10000;
+
 	/// @returns a cheaper representation for the number than its representation
 	/// as a literal or nullptr otherwise.
 	Expression const* tryFindRepresentation(u256 const& _value);
@@ -102,7 +123,7 @@ private:
 	GasMeter const& m_meter;
 	langutil::DebugData::ConstPtr m_debugData;
 	/// Counter for the complexity of optimization, will stop when it reaches zero.
-	size_t m_maxSteps = 10000;
+	size_t m_maxSteps = maxSteps;
 	std::map<u256, Representation>& m_cache;
 };
 
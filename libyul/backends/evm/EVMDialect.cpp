@@ -33,6 +33,7 @@
 #include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/view/enumerate.hpp>
 
+#include <mutex>
 #include <regex>
 #include <utility>
 #include <vector>
@@ -544,7 +545,9 @@ bool EVMDialect::reservedIdentifier(std::string_view _name) const
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion)
 {
 	static std::map<std::pair<langutil::EVMVersion, std::optional<uint8_t>>, std::unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static std::mutex mutex;
+	static YulStringRepository::ResetCallback callback{[&] { std::lock_guard<std::mutex> lock(mutex); dialects.clear(); }};
+	std::lock_guard<std::mutex> lock(mutex);
 	if (!dialects[{_evmVersion, _eofVersion}])
 		dialects[{_evmVersion, _eofVersion}] = std::make_unique<EVMDialect>(_evmVersion, _eofVersion, false);
 	return *dialects[{_evmVersion, _eofVersion}];
@@ -553,7 +556,9 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _evmVers
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion)
 {
 	static std::map<std::pair<langutil::EVMVersion, std::optional<uint8_t>>, std::unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static std::mutex mutex;
+	static YulStringRepository::ResetCallback callback{[&] { std::lock_guard<std::mutex> lock(mutex); dialects.clear(); }};
+	std::lock_guard<std::mutex> lock(mutex);
 	if (!dialects[{_evmVersion, _eofVersion}])
 		dialects[{_evmVersion, _eofVersion}] = std::make_unique<EVMDialect>(_evmVersion, _eofVersion, true);
 	return *dialects[{_evmVersion, _eofVersion}];
@@ -620,6 +625,7 @@ BuiltinHandle EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVari
 	auto const verbatimIndex = toContinuousVerbatimIndex(_arguments, _returnVariables);
 	yulAssert(verbatimIndex < verbatimIDOffset);
 
+	std::lock_guard<std::mutex> lock(m_verbatimFunctionsMutex);
 	if (
 		auto& verbatimFunctionPtr = m_verbatimFunctions[verbatimIndex];
 		!verbatimFunctionPtr
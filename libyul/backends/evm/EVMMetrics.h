@@ -55,6 +55,10 @@ public:
 	/// the costs for its arguments.
 	bigint instructionCosts(evmasm::Instruction _instruction) const;
 
+	bool isCreation() const { return m_isCreation; }
+	/// @returns the number of runs the run costs are weighted with, which is 1 for creation code.
+	bigint const& runs() const { return m_runs; }
+
 private:
 	bigint combineCosts(std::pair<bigint, bigint> _costs) const;
 
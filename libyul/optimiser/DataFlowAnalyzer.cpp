@@ -218,6 +218,21 @@ void DataFlowAnalyzer::operator()(Block& _block)
 	assertThrow(numScopes == m_variableScopes.size(), OptimizerException, "");
 }
 
+AssignedValue const* DataFlowAnalyzer::variableValue(YulName _variable) const
+{
+	if (std::optional<size_t> number = m_numbering.find(_variable))
+		if (AssignedValue const* value = m_state.value.find(*number); value && value->value)
+			return value;
+	return nullptr;
+}
+
+std::set<YulName> const* DataFlowAnalyzer::references(YulName _variable) const
+{
+	if (std::optional<size_t> number = m_numbering.find(_variable))
+		return m_state.references.find(*number);
+	return nullptr;
+}
+
 std::optional<YulName> DataFlowAnalyzer::storageValue(YulName _key) const
 {
 	if (YulName const* value = valueOrNullptr(m_state.environment.storage, _key))
@@ -266,7 +281,7 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulName> const& _variables, Exp
 	auto const& referencedVariables = movableChecker.referencedVariables();
 	for (auto const& name: _variables)
 	{
-		m_state.references[name] = referencedVariables;
+		setReferences(m_numbering(name), referencedVariables);
 		if (!_isDeclaration)
 		{
 			// assignment to slot denoted by "name"
@@ -309,10 +324,8 @@ void DataFlowAnalyzer::pushScope(bool _functionScope)
 void DataFlowAnalyzer::popScope()
 {
 	for (auto const& name: m_variableScopes.back().variables)
-	{
-		m_state.value.erase(name);
-		m_state.references.erase(name);
-	}
+		if (std::optional<size_t> number = m_numbering.find(name))
+			clearValue(*number);
 	m_variableScopes.pop_back();
 }
 
@@ -347,23 +360,43 @@ void DataFlowAnalyzer::clearValues(std::set<YulName> _variables)
 	});
 
 	// Also clear variables that reference variables to be cleared.
-	std::set<YulName> referencingVariables;
-	for (auto const& variableToClear: _variables)
-		for (auto const& [ref, names]: m_state.references)
-			if (names.count(variableToClear))
-				referencingVariables.emplace(ref);
+	// They have to be collected first, since clearing updates the inverse reference relation.
+	std::vector<size_t> variablesToClear;
+	for (auto const& name: _variables)
+		if (std::optional<size_t> number = m_numbering.find(name))
+		{
+			variablesToClear.emplace_back(*number);
+			if (std::vector<size_t> const* referencingVariables = m_state.referencedBy.find(*number))
+				variablesToClear += *referencingVariables;
+		}
 
 	// Clear the value and update the reference relation.
-	for (auto const& name: _variables + referencingVariables)
-	{
-		m_state.value.erase(name);
-		m_state.references.erase(name);
-	}
+	for (size_t variable: variablesToClear)
+		clearValue(variable);
 }
 
 void DataFlowAnalyzer::assignValue(YulName _variable, Expression const* _value)
 {
-	m_state.value[_variable] = {_value, m_loopDepth};
+	m_state.value[m_numbering(_variable)] = {_value, m_loopDepth};
+}
+
+void DataFlowAnalyzer::setReferences(size_t _variable, std::set<YulName> _references)
+{
+	if (std::set<YulName> const* oldReferences = m_state.references.find(_variable))
+		for (auto const& name: *oldReferences)
+			cxx20::erase_if(m_state.referencedBy[m_numbering(name)], [&](size_t _referencing) {
+				return _referencing == _variable;
+			});
+	for (auto const& name: _references)
+		m_state.referencedBy[m_numbering(name)].emplace_back(_variable);
+	m_state.references[_variable] = std::move(_references);
+}
+
+void DataFlowAnalyzer::clearValue(size_t _variable)
+{
+	if (AssignedValue* value = m_state.value.find(_variable))
+		*value = {};
+	setReferences(_variable, {});
 }
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
@@ -25,6 +25,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/optimiser/NameNumbering.h>
 #include <libyul/YulName.h>
 #include <libyul/AST.h> // Needed for m_zero below.
 #include <libyul/SideEffects.h>
@@ -34,6 +35,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -103,9 +105,8 @@ public:
 	void operator()(Block& _block) override;
 
 	/// @returns the current value of the given variable, if known - always movable.
-	AssignedValue const* variableValue(YulName _variable) const { return util::valueOrNullptr(m_state.value, _variable); }
-	std::set<YulName> const* references(YulName _variable) const { return util::valueOrNullptr(m_state.references, _variable); }
-	std::map<YulName, AssignedValue> const& allValues() const { return m_state.value; }
+	AssignedValue const* variableValue(YulName _variable) const;
+	std::set<YulName> const* references(YulName _variable) const;
 	std::optional<YulName> storageValue(YulName _key) const;
 	std::optional<YulName> memoryValue(YulName _key) const;
 	std::optional<YulName> keccakValue(YulName _start, YulName _length) const;
@@ -175,16 +176,26 @@ private:
 		/// If keccak[s, l] = y then y := keccak256(s, l) occurs in the code.
 		std::map<std::pair<YulName, YulName>, YulName> keccak;
 	};
+	/// Relations between variables, indexed by the numbers assigned by m_numbering.
 	struct State
 	{
-		/// Current values of variables, always movable.
-		std::map<YulName, AssignedValue> value;
-		/// m_references[a].contains(b) <=> the current expression assigned to a references b
-		std::unordered_map<YulName, std::set<YulName>> references;
+		/// Current values of variables, always movable. The value is unknown if its expression is null.
+		NameIndexedVector<AssignedValue> value;
+		/// references[a].contains(b) <=> the current expression assigned to a references b
+		NameIndexedVector<std::set<YulName>> references;
+		/// Inverse of references: referencedBy[b] lists all a with references[a].contains(b)
+		NameIndexedVector<std::vector<size_t>> referencedBy;
 
 		Environment environment;
 	};
 
+	/// Replaces the variables referenced by the value of the variable with number @a _variable,
+	/// keeping the inverse relation up to date.
+	void setReferences(size_t _variable, std::set<YulName> _references);
+
+	/// Forgets the value of the variable with number @a _variable and the variables it references.
+	void clearValue(size_t _variable);
+
 	/// Joins knowledge about storage and memory with an older point in the control-flow.
 	/// This only works if the current state is a direct successor of the older point,
 	/// i.e. `_olderState.storage` and `_olderState.memory` cannot have additional changes.
@@ -196,6 +207,9 @@ private:
 		std::unordered_map<YulName, YulName> const& _olderData
 	);
 
+	/// Numbers of all variables seen so far. Unlike m_state, this is never reset,
+	/// so that numbers stay valid when the state is saved and restored.
+	NameNumbering m_numbering;
 	State m_state;
 
 protected:
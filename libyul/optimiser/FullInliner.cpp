@@ -65,20 +65,31 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 		if (ssaValue.second && std::holds_alternative<Literal>(*ssaValue.second))
 			m_constants.emplace(ssaValue.first);
 
+	// Number the global block and all functions.
+	m_functionNumbers(YulName{});
+	for (auto const& statement: m_ast.statements)
+		if (std::holds_alternative<FunctionDefinition>(statement))
+			m_functionNumbers(std::get<FunctionDefinition>(statement).name);
+	m_functions.resize(m_functionNumbers.size(), nullptr);
+	m_noInlineFunctions.resize(m_functionNumbers.size(), false);
+	m_singleUse.resize(m_functionNumbers.size(), false);
+	m_functionSizes.resize(m_functionNumbers.size(), 0);
+
 	// Store size of global statements.
-	m_functionSizes[YulName{}] = CodeSize::codeSize(_ast);
+	m_functionSizes[functionNumber(YulName{})] = CodeSize::codeSize(_ast);
 	std::map<FunctionHandle, size_t> references = ReferencesCounter::countReferences(m_ast);
 	for (auto& statement: m_ast.statements)
 	{
 		if (!std::holds_alternative<FunctionDefinition>(statement))
 			continue;
 		FunctionDefinition& fun = std::get<FunctionDefinition>(statement);
-		m_functions[fun.name] = &fun;
+		size_t number = functionNumber(fun.name);
+		m_functions[number] = &fun;
 		if (LeaveFinder::containsLeave(fun))
-			m_noInlineFunctions.insert(fun.name);
+			m_noInlineFunctions[number] = true;
 		// Always inline functions that are only called once.
 		if (references[fun.name] == 1)
-			m_singleUse.emplace(fun.name);
+			m_singleUse[number] = true;
 		updateCodeSize(fun);
 	}
 
@@ -185,8 +196,9 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulName _callSite)
 	FunctionDefinition* calledFunction = function(functionName);
 	if (!calledFunction)
 		return false;
+	size_t calledFunctionNumber = functionNumber(functionName);
 
-	if (m_noInlineFunctions.count(functionName) || recursive(*calledFunction))
+	if (m_noInlineFunctions[calledFunctionNumber] || recursive(*calledFunction))
 		return false;
 
 	// No inlining of calls where argument expressions may have side-effects.
@@ -196,7 +208,7 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulName _callSite)
 			return false;
 
 	// Inline really, really tiny functions
-	size_t size = m_functionSizes.at(calledFunction->name);
+	size_t size = m_functionSizes[calledFunctionNumber];
 	if (size <= 1)
 		return true;
 
@@ -217,10 +229,10 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulName _callSite)
 	if (!m_hasMemoryGuard || m_recursiveFunctions.count(_callSite))
 		aggressiveInlining = false;
 
-	if (!aggressiveInlining && m_functionSizes.at(_callSite) > 45)
+	if (!aggressiveInlining && m_functionSizes[functionNumber(_callSite)] > 45)
 		return false;
 
-	if (m_singleUse.count(calledFunction->name))
+	if (m_singleUse[calledFunctionNumber])
 		return true;
 
 	// Constant arguments might provide a means for further optimization, so they cause a bonus.
@@ -240,12 +252,19 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulName _callSite)
 
 void FullInliner::tentativelyUpdateCodeSize(YulName _function, YulName _callSite)
 {
-	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
+	m_functionSizes[functionNumber(_callSite)] += m_functionSizes[functionNumber(_function)];
 }
 
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
 {
-	m_functionSizes[_fun.name] = CodeSize::codeSize(_fun.body);
+	m_functionSizes[functionNumber(_fun.name)] = CodeSize::codeSize(_fun.body);
+}
+
+size_t FullInliner::functionNumber(YulName _name) const
+{
+	std::optional<size_t> number = m_functionNumbers.find(_name);
+	yulAssert(number, "");
+	return *number;
 }
 
 void FullInliner::handleBlock(YulName _currentFunctionName, Block& _block)
@@ -25,6 +25,7 @@
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/NameNumbering.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/Exceptions.h>
 
@@ -33,6 +34,7 @@
 #include <optional>
 #include <set>
 #include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -79,9 +81,8 @@ public:
 
 	FunctionDefinition* function(YulName _name)
 	{
-		auto it = m_functions.find(_name);
-		if (it != m_functions.end())
-			return it->second;
+		if (std::optional<size_t> number = m_functionNumbers.find(_name))
+			return m_functions[*number];
 		return nullptr;
 	}
 
@@ -101,6 +102,8 @@ private:
 	std::map<FunctionHandle, size_t> callDepths() const;
 
 	void updateCodeSize(FunctionDefinition const& _fun);
+	/// @returns the number of the function @a _name or of the global block if @a _name is empty.
+	size_t functionNumber(YulName _name) const;
 	void handleBlock(YulName _currentFunctionName, Block& _block);
 	bool recursive(FunctionDefinition const& _fun) const;
 
@@ -108,18 +111,21 @@ private:
 	/// The AST to be modified. The root block itself will not be modified, because
 	/// we store pointers to functions.
 	Block& m_ast;
-	std::map<YulName, FunctionDefinition*> m_functions;
+	/// Numbers of all functions, used as indices into the vectors below.
+	/// The global block (the empty name) is number zero.
+	NameNumbering m_functionNumbers;
+	std::vector<FunctionDefinition*> m_functions;
 	/// Functions not to be inlined (because they contain the ``leave`` statement).
-	std::set<YulName> m_noInlineFunctions;
+	std::vector<bool> m_noInlineFunctions;
 	/// True, if the code contains a ``memoryguard`` and we can expect to be able to move variables to memory later.
 	bool m_hasMemoryGuard = false;
 	/// Set of recursive functions.
 	std::set<FunctionHandle> m_recursiveFunctions;
-	/// Names of functions to always inline.
-	std::set<YulName> m_singleUse;
+	/// Functions to always inline.
+	std::vector<bool> m_singleUse;
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulName> m_constants;
-	std::map<YulName, size_t> m_functionSizes;
+	std::vector<size_t> m_functionSizes;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
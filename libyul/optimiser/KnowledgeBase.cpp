@@ -87,13 +87,14 @@ std::optional<u256> KnowledgeBase::valueIfKnownConstant(Expression const& _expre
 
 KnowledgeBase::VariableOffset KnowledgeBase::explore(YulName _var)
 {
+	size_t number = m_numbering(_var);
 	Expression const* value = nullptr;
 	if (m_valuesAreSSA)
 	{
 		// In SSA, a once determined offset is always valid, so we first see
 		// if we already computed it.
-		if (VariableOffset const* varOff = util::valueOrNullptr(m_offsets, _var))
-			return *varOff;
+		if (std::optional<VariableOffset> const* varOff = m_offsets.find(number); varOff && *varOff)
+			return **varOff;
 		value = valueOf(_var);
 	}
 	else
@@ -101,8 +102,8 @@ KnowledgeBase::VariableOffset KnowledgeBase::explore(YulName _var)
 		// For non-SSA, we query the value first so that the variable is reset if it has changed
 		// since the last call.
 		value = valueOf(_var);
-		if (VariableOffset const* varOff = util::valueOrNullptr(m_offsets, _var))
-			return *varOff;
+		if (std::optional<VariableOffset> const* varOff = m_offsets.find(number); varOff && *varOff)
+			return **varOff;
 	}
 
 	if (value)
@@ -160,10 +161,11 @@ Expression const* KnowledgeBase::valueOf(YulName _var)
 	if (m_valuesAreSSA)
 		return currentValue;
 
-	Expression const* lastValue = m_lastKnownValue[_var];
-	if (lastValue != currentValue)
+	size_t number = m_numbering(_var);
+	Expression const* const* lastValue = m_lastKnownValue.find(number);
+	if ((lastValue ? *lastValue : nullptr) != currentValue)
 		reset(_var);
-	m_lastKnownValue[_var] = currentValue;
+	m_lastKnownValue[number] = currentValue;
 	return currentValue;
 }
 
@@ -171,46 +173,55 @@ void KnowledgeBase::reset(YulName _var)
 {
 	yulAssert(!m_valuesAreSSA);
 
-	m_lastKnownValue.erase(_var);
-	if (VariableOffset const* offset = util::valueOrNullptr(m_offsets, _var))
+	size_t number = m_numbering(_var);
+	if (Expression const** lastValue = m_lastKnownValue.find(number))
+		*lastValue = nullptr;
+	if (std::optional<VariableOffset>* offset = m_offsets.find(number); offset && *offset)
 	{
 		// Remove var from its group
-		if (!offset->isAbsolute())
-			m_groupMembers[offset->reference].erase(_var);
-		m_offsets.erase(_var);
+		if (!(*offset)->isAbsolute())
+			m_groupMembers[m_numbering((*offset)->reference)].erase(_var);
+		m_offsets[number].reset();
 	}
-	if (std::set<YulName>* group = util::valueOrNullptr(m_groupMembers, _var))
+	if (std::set<YulName>* groupMembers = m_groupMembers.find(number); groupMembers && !groupMembers->empty())
 	{
-		// _var was a representative, we might have to find a new one.
-		if (!group->empty())
+		// _var was a representative, we have to find a new one.
+		// The members are moved out first since the container might grow below.
+		std::set<YulName> group = std::move(*groupMembers);
+		groupMembers->clear();
+
+		YulName newRepresentative = *group.begin();
+		yulAssert(newRepresentative != _var);
+		u256 newOffset = offsetOf(newRepresentative).offset;
+		// newOffset = newRepresentative - _var
+		for (YulName groupMember: group)
 		{
-			YulName newRepresentative = *group->begin();
-			yulAssert(newRepresentative != _var);
-			u256 newOffset = m_offsets[newRepresentative].offset;
-			// newOffset = newRepresentative - _var
-			for (YulName groupMember: *group)
-			{
-				yulAssert(m_offsets[groupMember].reference == _var);
-				m_offsets[groupMember].reference = newRepresentative;
-				// groupMember = _var + m_offsets[groupMember].offset (old)
-				//             = newRepresentative - newOffset + m_offsets[groupMember].offset (old)
-				// so subtracting newOffset from .offset yields the original relation again,
-				// just with _var replaced by newRepresentative
-				m_offsets[groupMember].offset -= newOffset;
-			}
-			m_groupMembers[newRepresentative] = std::move(*group);
-
+			VariableOffset& memberOffset = offsetOf(groupMember);
+			yulAssert(memberOffset.reference == _var);
+			memberOffset.reference = newRepresentative;
+			// groupMember = _var + memberOffset.offset (old)
+			//             = newRepresentative - newOffset + memberOffset.offset (old)
+			// so subtracting newOffset from .offset yields the original relation again,
+			// just with _var replaced by newRepresentative
+			memberOffset.offset -= newOffset;
 		}
-		m_groupMembers.erase(_var);
+		m_groupMembers[m_numbering(newRepresentative)] = std::move(group);
 	}
 }
 
 KnowledgeBase::VariableOffset KnowledgeBase::setOffset(YulName _variable, VariableOffset _value)
 {
-	m_offsets[_variable] = _value;
+	m_offsets[m_numbering(_variable)] = _value;
 	// Constants are not tracked in m_groupMembers because
 	// the "representative" can never be reset.
 	if (!_value.reference.empty())
-		m_groupMembers[_value.reference].insert(_variable);
+		m_groupMembers[m_numbering(_value.reference)].insert(_variable);
 	return _value;
 }
+
+KnowledgeBase::VariableOffset& KnowledgeBase::offsetOf(YulName _variable)
+{
+	std::optional<VariableOffset>* offset = m_offsets.find(m_numbering(_variable));
+	yulAssert(offset && *offset);
+	return **offset;
+}
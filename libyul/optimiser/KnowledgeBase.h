@@ -24,12 +24,15 @@
 #include <libyul/ASTForward.h>
 #include <libyul/Dialect.h>
 #include <libyul/YulName.h>
+#include <libyul/optimiser/NameNumbering.h>
 
 #include <libsolutil/Common.h>
 #include <libsolutil/Numeric.h>
 
 #include <map>
 #include <functional>
+#include <optional>
+#include <set>
 
 namespace solidity::yul
 {
@@ -114,6 +117,9 @@ private:
 
 	VariableOffset setOffset(YulName _variable, VariableOffset _value);
 
+	/// @returns the offset of a variable that is a member of a group.
+	VariableOffset& offsetOf(YulName _variable);
+
 	/// If true, we can assume that variable values never change and skip some steps.
 	bool m_valuesAreSSA = false;
 	/// Callback to retrieve the current value of a variable.
@@ -121,13 +127,15 @@ private:
 	std::optional<BuiltinHandle> m_addBuiltinHandle;
 	std::optional<BuiltinHandle> m_subBuiltinHandle;
 
+	/// Numbers of the variables we queried, used as indices into the containers below.
+	NameNumbering m_numbering;
 	/// Offsets for each variable to one representative per group.
 	/// The empty string is the representative of the constant value zero.
-	std::map<YulName, VariableOffset> m_offsets;
+	NameIndexedVector<std::optional<VariableOffset>> m_offsets;
 	/// Last known value of each variable we queried.
-	std::map<YulName, Expression const*> m_lastKnownValue;
+	NameIndexedVector<Expression const*> m_lastKnownValue;
 	/// For each representative, variables that use it to offset from.
-	std::map<YulName, std::set<YulName>> m_groupMembers;
+	NameIndexedVector<std::set<YulName>> m_groupMembers;
 };
 
 }
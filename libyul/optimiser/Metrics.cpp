@@ -196,11 +196,13 @@ void CodeCost::addInstructionCost(evmasm::Instruction _instruction)
 void AssignmentCounter::operator()(Assignment const& _assignment)
 {
 	for (auto const& variable: _assignment.variableNames)
-		++m_assignmentCounters[variable.name];
+		++m_assignmentCounters[m_numbering(variable.name)];
 }
 
 size_t AssignmentCounter::assignmentCount(YulName _name) const
 {
-	auto it = m_assignmentCounters.find(_name);
-	return (it == m_assignmentCounters.end()) ? 0 : it->second;
+	if (std::optional<size_t> number = m_numbering.find(_name))
+		if (size_t const* count = m_assignmentCounters.find(*number))
+			return *count;
+	return 0;
 }
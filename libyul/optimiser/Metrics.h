@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/NameNumbering.h>
 #include <liblangutil/EVMVersion.h>
 
 namespace solidity::yul
@@ -141,7 +142,8 @@ public:
 	void operator()(Assignment const& _assignment) override;
 	std::size_t assignmentCount(YulName _name) const;
 private:
-	std::map<YulName, size_t> m_assignmentCounters;
+	NameNumbering m_numbering;
+	NameIndexedVector<size_t> m_assignmentCounters;
 };
 
 }
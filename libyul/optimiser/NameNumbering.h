@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that assigns dense numbers to names.
+ */
+#pragma once
+
+#include <libyul/YulName.h>
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Assigns consecutive numbers, starting at zero, to the names of variables and functions
+ * in the order in which an analysis first encounters them.
+ *
+ * The numbering is meant to live as long as a single optimiser step on a single object.
+ * It allows the step to keep per-name data in vectors indexed by the number instead of in
+ * maps keyed by the name. Looking up the number of a name does not hash or compare names:
+ * it indexes a vector by the ID of the name in the YulString repository, offset by the
+ * smallest ID seen. The names of a single object are created close to each other, so the
+ * vector stays small compared to the whole repository.
+ *
+ * Since the numbers depend on the traversal order, they must not be used to determine
+ * the order in which names are processed.
+ */
+class NameNumbering
+{
+public:
+	/// @returns the number of @a _name, assigning the next free number if it does not have one yet.
+	size_t operator()(YulName _name)
+	{
+		size_t const id = _name.id();
+		if (m_names.empty())
+			m_firstID = id;
+		else if (id < m_firstID)
+		{
+			m_numberByID.insert(m_numberByID.begin(), m_firstID - id, unassigned);
+			m_firstID = id;
+		}
+		if (id - m_firstID >= m_numberByID.size())
+			m_numberByID.resize(id - m_firstID + 1, unassigned);
+		size_t& number = m_numberByID[id - m_firstID];
+		if (number == unassigned)
+		{
+			number = m_names.size();
+			m_names.emplace_back(_name);
+		}
+		return number;
+	}
+	/// @returns the number of @a _name or nullopt if it was not assigned one yet.
+	std::optional<size_t> find(YulName _name) const
+	{
+		size_t const id = _name.id();
+		if (id < m_firstID || id - m_firstID >= m_numberByID.size() || m_numberByID[id - m_firstID] == unassigned)
+			return std::nullopt;
+		return m_numberByID[id - m_firstID];
+	}
+	/// @returns the name with the given number.
+	YulName name(size_t _number) const { return m_names.at(_number); }
+	/// @returns the amount of numbers assigned so far.
+	size_t size() const { return m_names.size(); }
+
+private:
+	static constexpr size_t unassigned = std::numeric_limits<size_t>::max();
+
+	/// Numbers of the names, indexed by their repository ID minus m_firstID.
+	std::vector<size_t> m_numberByID;
+	size_t m_firstID = 0;
+	std::vector<YulName> m_names;
+};
+
+/**
+ * Vector of values indexed by the numbers of a NameNumbering.
+ * Grows on write; reading an index that was never written yields a default-constructed value.
+ */
+template <typename T>
+class NameIndexedVector
+{
+public:
+	T& operator[](size_t _number)
+	{
+		if (_number >= m_values.size())
+			m_values.resize(_number + 1);
+		return m_values[_number];
+	}
+	/// @returns a pointer to the value at @a _number or nullptr if it was never written.
+	T const* find(size_t _number) const
+	{
+		return _number < m_values.size() ? &m_values[_number] : nullptr;
+	}
+	T* find(size_t _number)
+	{
+		return _number < m_values.size() ? &m_values[_number] : nullptr;
+	}
+	void clear() { m_values.clear(); }
+
+private:
+	std::vector<T> m_values;
+};
+
+}
@@ -110,7 +110,7 @@ void OptimiserSuite::run(
 
 	Block astRoot;
 	{
-		PROFILER_PROBE("Disambiguator", probe);
+		util::Profiler::Probe probe("Disambiguator", "yul-optimizer");
 		astRoot = std::get<Block>(Disambiguator(
 			dialect,
 			*_object.analysisInfo,
@@ -138,7 +138,7 @@ void OptimiserSuite::run(
 	// message once we perform code generation.
 	if (!usesOptimizedCodeGenerator)
 	{
-		PROFILER_PROBE("StackCompressor", probe);
+		util::Profiler::Probe probe("StackCompressor", "yul-optimizer");
 		_object.setCode(std::make_shared<AST>(dialect, std::move(astRoot)));
 		astRoot = std::get<1>(StackCompressor::run(
 			_object,
@@ -158,13 +158,13 @@ void OptimiserSuite::run(
 	{
 		yulAssert(_meter, "");
 		{
-			PROFILER_PROBE("ConstantOptimiser", probe);
+			util::Profiler::Probe probe("ConstantOptimiser", "yul-optimizer");
 			ConstantOptimiser{*evmDialect, *_meter}(astRoot);
 		}
 		if (usesOptimizedCodeGenerator)
 		{
 			{
-				PROFILER_PROBE("StackCompressor", probe);
+				util::Profiler::Probe probe("StackCompressor", "yul-optimizer");
 				_object.setCode(std::make_shared<AST>(dialect, std::move(astRoot)));
 				astRoot = std::get<1>(StackCompressor::run(
 					_object,
@@ -174,14 +174,14 @@ void OptimiserSuite::run(
 			}
 			if (evmDialect->providesObjectAccess())
 			{
-				PROFILER_PROBE("StackLimitEvader", probe);
+				util::Profiler::Probe probe("StackLimitEvader", "yul-optimizer");
 				_object.setCode(std::make_shared<AST>(dialect, std::move(astRoot)));
 				astRoot = StackLimitEvader::run(suite.m_context, _object);
 			}
 		}
 		else if (evmDialect->providesObjectAccess() && _optimizeStackAllocation)
 		{
-			PROFILER_PROBE("StackLimitEvader", probe);
+			util::Profiler::Probe probe("StackLimitEvader", "yul-optimizer");
 			_object.setCode(std::make_shared<AST>(dialect, std::move(astRoot)));
 			astRoot = StackLimitEvader::run(suite.m_context, _object);
 		}
@@ -189,11 +189,11 @@ void OptimiserSuite::run(
 
 	dispenser.reset(astRoot);
 	{
-		PROFILER_PROBE("NameSimplifier", probe);
+		util::Profiler::Probe probe("NameSimplifier", "yul-optimizer");
 		NameSimplifier::run(suite.m_context, astRoot);
 	}
 	{
-		PROFILER_PROBE("VarNameCleaner", probe);
+		util::Profiler::Probe probe("VarNameCleaner", "yul-optimizer");
 		VarNameCleaner::run(suite.m_context, astRoot);
 	}
 
@@ -222,42 +222,40 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static std::map<std::string, std::unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			UnusedStoreEliminator,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static std::map<std::string, std::unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EqualStoreEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		UnusedAssignEliminator,
+		UnusedStoreEliminator,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -473,7 +471,7 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 			std::cout << "Running " << step << std::endl;
 
 		{
-			PROFILER_PROBE(step, probe);
+			util::Profiler::Probe probe(step, "yul-optimizer");
 			allSteps().at(step)->run(m_context, _ast);
 		}
 
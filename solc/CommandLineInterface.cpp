@@ -41,6 +41,7 @@
 #include <libsolidity/lsp/LanguageServer.h>
 #include <libsolidity/lsp/Transport.h>
 
+#include <libyul/ObjectOptimizer.h>
 #include <libyul/YulStack.h>
 
 #include <libevmasm/Disassemble.h>
@@ -54,6 +55,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 
 #include <algorithm>
 #include <fstream>
@@ -182,7 +184,12 @@ void CommandLineInterface::handleEVMAssembly(std::string const& _contract)
 	if (m_options.compiler.outputs.asmJson)
 		assembly = util::jsonPrint(m_assemblyStack->assemblyJSON(_contract), m_options.formatting.json);
 	else
-		assembly = m_assemblyStack->assemblyString(_contract, m_fileReader.sourceUnits());
+	{
+		StringMap sourceCodes;
+		for (auto const& [sourceUnitName, sourceCode]: m_fileReader.sourceUnits())
+			sourceCodes[sourceUnitName] = sourceCode.str();
+		assembly = m_assemblyStack->assemblyString(_contract, sourceCodes);
+	}
 
 	if (!m_options.output.dir.empty())
 		createFile(
@@ -568,6 +575,9 @@ void CommandLineInterface::readInputFiles()
 		return;
 
 	m_fileReader.setBasePath(m_options.input.basePath);
+	// The server reads imports for each request and may run while the files are edited.
+	// Truncating a mapped file would make later accesses to it crash the server.
+	m_fileReader.setMapLargeFiles(m_options.input.mode != InputMode::StandardJsonServer);
 
 	if (m_fileReader.basePath() != "")
 	{
@@ -627,15 +637,14 @@ void CommandLineInterface::readInputFiles()
 		}
 
 		// NOTE: we ignore the FileNotFound exception as we manually check above
-		std::string fileContent = readFileAsString(infile);
 		if (m_options.input.mode == InputMode::StandardJson)
 		{
 			solAssert(!m_standardJsonInput.has_value());
-			m_standardJsonInput = std::move(fileContent);
+			m_standardJsonInput = readFileAsString(infile);
 		}
 		else
 		{
-			m_fileReader.addOrUpdateFile(infile, std::move(fileContent));
+			m_fileReader.addOrUpdateFile(infile, readFileAsSharedText(infile));
 			m_fileReader.allowDirectory(boost::filesystem::canonical(infile).remove_filename());
 		}
 	}
@@ -653,6 +662,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::StandardJsonServer &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -664,12 +674,12 @@ std::map<std::string, Json> CommandLineInterface::parseAstFromInput()
 	solAssert(m_options.input.mode == InputMode::CompilerWithASTImport);
 
 	std::map<std::string, Json> sourceJsons;
-	std::map<std::string, std::string> tmpSources;
+	FileReader::StringMap tmpSources;
 
 	for (SourceCode const& sourceCode: m_fileReader.sourceUnits() | ranges::views::values)
 	{
 		Json ast;
-		astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
+		astAssert(jsonParseStrict(sourceCode.str(), ast), "Input file could not be parsed to JSON");
 		astAssert(ast.contains("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
 
 		for (auto const& [src, value]: ast["sources"].items())
@@ -800,10 +810,14 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
+		compiler.setOptimizerCacheDirectory(m_options.optimizer.cacheDirectory);
 		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << std::endl;
 		m_standardJsonInput.reset();
 		break;
 	}
+	case InputMode::StandardJsonServer:
+		serveStandardJson();
+		break;
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
@@ -853,7 +867,7 @@ void CommandLineInterface::assembleFromEVMAssemblyJSON()
 	auto evmAssemblyStack = std::make_unique<evmasm::EVMAssemblyStack>(m_options.output.evmVersion, m_options.output.eofVersion);
 	try
 	{
-		evmAssemblyStack->parseAndAnalyze(sourceUnitName, source);
+		evmAssemblyStack->parseAndAnalyze(sourceUnitName, source.str());
 	}
 	catch (evmasm::AssemblyImportException const& _exception)
 	{
@@ -879,6 +893,10 @@ void CommandLineInterface::compile()
 
 	SourceReferenceFormatter formatter(serr(false), *m_compiler, coloredOutput(m_options), m_options.formatting.withErrorIds);
 
+	std::shared_ptr<util::Profiler> profiler;
+	if (!m_options.output.profileFile.empty())
+		profiler = std::make_shared<util::Profiler>();
+
 	try
 	{
 		if (m_options.metadata.literalSources)
@@ -890,6 +908,9 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setParallelism(m_options.output.parallelism);
+		m_compiler->setOptimizerCacheDirectory(m_options.optimizer.cacheDirectory);
+		m_compiler->setProfiler(profiler);
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
@@ -949,10 +970,18 @@ void CommandLineInterface::compile()
 			}
 		}
 		else
-			m_compiler->setSources(m_fileReader.sourceUnits());
+			m_compiler->setSourceTexts(m_fileReader.sourceUnits());
 
 		bool successful = m_compiler->compile(m_options.output.stopAfter);
 
+		if (profiler)
+		{
+			std::ofstream profileFile(m_options.output.profileFile.string());
+			profileFile << util::jsonCompactPrint(profiler->chromeTrace());
+			if (!profileFile)
+				solThrow(CommandLineOutputError, "Could not write profile to file \"" + m_options.output.profileFile.string() + "\".");
+		}
+
 		for (auto const& error: m_compiler->errors())
 		{
 			m_hasOutput = true;
@@ -1119,6 +1148,26 @@ void CommandLineInterface::handleAst()
 	}
 }
 
+void CommandLineInterface::serveStandardJson()
+{
+	solAssert(m_options.input.mode == InputMode::StandardJsonServer);
+
+	// The caches live as long as the server, so that later requests only compile what changed.
+	StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
+	compiler.setObjectOptimizer(std::make_shared<yul::ObjectOptimizer>());
+	compiler.setOptimizerCacheDirectory(m_options.optimizer.cacheDirectory);
+	compiler.setBuildCache(std::make_shared<CompilerStack::BuildCache>());
+
+	std::string request;
+	while (std::getline(m_sin, request))
+	{
+		if (boost::algorithm::trim_copy(request).empty())
+			continue;
+		// Flush after every response since clients wait for it before sending the next request.
+		sout() << compiler.compile(request) << std::endl;
+	}
+}
+
 void CommandLineInterface::serveLSP()
 {
 	lsp::StdioTransport transport;
@@ -1150,7 +1199,9 @@ void CommandLineInterface::link()
 		librariesReplacements[replacement] = library.second;
 	}
 
-	FileReader::StringMap sourceCodes = m_fileReader.sourceUnits();
+	StringMap sourceCodes;
+	for (auto const& [sourceUnitName, sourceCode]: m_fileReader.sourceUnits())
+		sourceCodes[sourceUnitName] = sourceCode.str();
 	for (auto& src: sourceCodes)
 	{
 		auto end = src.second.end();
@@ -1189,7 +1240,10 @@ void CommandLineInterface::link()
 		while (!src.second.empty() && *prev(src.second.end()) == '\n')
 			src.second.resize(src.second.size() - 1);
 	}
-	m_fileReader.setSourceUnits(std::move(sourceCodes));
+	FileReader::StringMap linkedSourceCodes;
+	for (auto& [sourceUnitName, sourceCode]: sourceCodes)
+		linkedSourceCodes[sourceUnitName] = std::move(sourceCode);
+	m_fileReader.setSourceUnits(std::move(linkedSourceCodes));
 }
 
 void CommandLineInterface::writeLinkedFiles()
@@ -1245,7 +1299,7 @@ void CommandLineInterface::assembleYul(yul::YulStack::Language _language, yul::Y
 				DebugInfoSelection::Default()
 		);
 
-		successful = successful && stack.parseAndAnalyze(sourceUnitName, yulSource);
+		successful = successful && stack.parseAndAnalyze(sourceUnitName, yulSource.str());
 		if (!successful)
 			solAssert(stack.hasErrors(), "No error reported, but parsing/analysis failed.");
 		else
@@ -87,6 +87,7 @@ private:
 	void printLicense();
 	void compile();
 	void assembleFromEVMAssemblyJSON();
+	void serveStandardJson();
 	void serveLSP();
 	void link();
 	void writeLinkedFiles();
@@ -25,6 +25,7 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #include <range/v3/view/transform.hpp>
 #include <range/v3/view/filter.hpp>
@@ -55,6 +56,7 @@ static std::string const g_strHelp = "help";
 static std::string const g_strImportAst = "import-ast";
 static std::string const g_strImportEvmAssemblerJson = "import-asm-json";
 static std::string const g_strInputFile = "input-file";
+static std::string const g_strJobs = "jobs";
 static std::string const g_strYul = "yul";
 static std::string const g_strYulDialect = "yul-dialect";
 static std::string const g_strDebugInfo = "debug-info";
@@ -68,6 +70,7 @@ static std::string const g_strNoCBORMetadata = "no-cbor-metadata";
 static std::string const g_strMetadataHash = "metadata-hash";
 static std::string const g_strMetadataLiteral = "metadata-literal";
 static std::string const g_strModelCheckerContracts = "model-checker-contracts";
+static std::string const g_strModelCheckerCrossCheckSolvers = "model-checker-cross-check-solvers";
 static std::string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static std::string const g_strModelCheckerEngine = "model-checker-engine";
 static std::string const g_strModelCheckerExtCalls = "model-checker-ext-calls";
@@ -80,15 +83,18 @@ static std::string const g_strModelCheckerSolvers = "model-checker-solvers";
 static std::string const g_strModelCheckerTargets = "model-checker-targets";
 static std::string const g_strModelCheckerTimeout = "model-checker-timeout";
 static std::string const g_strModelCheckerBMCLoopIterations = "model-checker-bmc-loop-iterations";
+static std::string const g_strModelCheckerCHCThreads = "model-checker-chc-threads";
 static std::string const g_strNone = "none";
 static std::string const g_strNoOptimizeYul = "no-optimize-yul";
 static std::string const g_strNoImportCallback = "no-import-callback";
 static std::string const g_strOptimize = "optimize";
 static std::string const g_strOptimizeRuns = "optimize-runs";
 static std::string const g_strOptimizeYul = "optimize-yul";
+static std::string const g_strOptimizerCacheDir = "optimizer-cache-dir";
 static std::string const g_strYulOptimizations = "yul-optimizations";
 static std::string const g_strOutputDir = "output-dir";
 static std::string const g_strOverwrite = "overwrite";
+static std::string const g_strProfile = "profile";
 static std::string const g_strRevertStrings = "revert-strings";
 static std::string const g_strStopAfter = "stop-after";
 static std::string const g_strParsing = "parsing";
@@ -102,6 +108,7 @@ static std::set<std::string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static std::string const g_strServer = "server";
 static std::string const g_strSources = "sources";
 static std::string const g_strSourceList = "sourceList";
 static std::string const g_strStandardJSON = "standard-json";
@@ -143,6 +150,7 @@ static std::map<InputMode, std::string> const g_inputModeName = {
 	{InputMode::CompilerWithASTImport, "compiler (AST import)"},
 	{InputMode::Assembler, "assembler"},
 	{InputMode::StandardJson, "standard JSON"},
+	{InputMode::StandardJsonServer, "standard JSON server"},
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
 	{InputMode::EVMAssemblerJSON, "EVM assembler (JSON format)"},
@@ -235,6 +243,8 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.viaIR == _other.output.viaIR &&
+		output.parallelism == _other.output.parallelism &&
+		output.profileFile == _other.output.profileFile &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -256,6 +266,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.optimizeYul == _other.optimizer.optimizeYul &&
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.cacheDirectory == _other.optimizer.cacheDirectory &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
@@ -339,7 +350,15 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				m_options.input.paths.insert(positionalArg);
 		}
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::StandardJsonServer)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strServer + " does not accept input files. Requests are read from standard input."
+			);
+	}
+	else if (m_options.input.mode == InputMode::StandardJson)
 	{
 		if (m_options.input.paths.size() > 1 || (m_options.input.paths.size() == 1 && m_options.input.addStdin))
 			solThrow(
@@ -497,6 +516,7 @@ void CommandLineParser::parseOutputSelection()
 		case InputMode::Assembler:
 			return util::contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
+		case InputMode::StandardJsonServer:
 		case InputMode::Linker:
 			return false;
 		}
@@ -641,6 +661,19 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			(g_strJobs + ",j").c_str(),
+			po::value<size_t>()->value_name("n")->default_value(1),
+			"Number of threads used to parse the sources and load their imports, to optimize and assemble "
+			"independent contracts when compiling via the IR and to optimize independent sub-assemblies. "
+			"0 uses one thread per hardware thread. Does not affect the output."
+		)
+		(
+			g_strProfile.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Write the wall time and peak memory usage of parsing, analysis, code generation and "
+			"optimization of every contract to the given file in the Chrome trace event format."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
@@ -668,6 +701,13 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strServer.c_str(),
+			("Switch to Standard JSON server mode. Reads Standard JSON requests from standard input, one per line, "
+			"and writes each response on a single line to standard output until the input ends. "
+			"Results of earlier requests are reused for sources and contracts that did not change. "
+			"Options apart from the ones valid in --" + g_strStandardJSON + " mode are ignored.").c_str()
+		)
 		(
 			g_strLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " "
@@ -839,6 +879,12 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("steps"),
 			"Forces Yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strOptimizerCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Store optimized Yul objects in the given directory and reuse them in subsequent compilations. "
+			"Only affects compilation via IR. Entries are specific to the compiler version."
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -851,6 +897,11 @@ General Information)").c_str(),
 			"Multiple pairs <source>:<contract> can be selected at the same time, separated by a comma "
 			"and no spaces."
 		)
+		(
+			g_strModelCheckerCrossCheckSolvers.c_str(),
+			"Wait for all selected solvers to answer each BMC query and report conflicting answers"
+			" instead of using the first answer."
+		)
 		(
 			g_strModelCheckerDivModNoSlacks.c_str(),
 			"Encode division and modulo operations with their precise operators"
@@ -915,6 +966,13 @@ General Information)").c_str(),
 			"Set loop unrolling depth for BMC engine."
 			"Default is 1."
 		)
+		(
+			g_strModelCheckerCHCThreads.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Number of verification targets the CHC engine queries Z3 or Eldarica for at the same time. "
+			"With more than one, targets are also queried if another query already found them unsafe. "
+			"Default is 1."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -966,6 +1024,7 @@ void CommandLineParser::processArgs()
 		g_strLicense,
 		g_strVersion,
 		g_strStandardJSON,
+		g_strServer,
 		g_strLink,
 		g_strAssemble,
 		g_strStrictAssembly,
@@ -982,6 +1041,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::Version;
 	else if (m_args.count(g_strStandardJSON) > 0)
 		m_options.input.mode = InputMode::StandardJson;
+	else if (m_args.count(g_strServer) > 0)
+		m_options.input.mode = InputMode::StandardJsonServer;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0)
@@ -1013,10 +1074,14 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strProfile, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strOptimizerCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson, InputMode::StandardJsonServer}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerCrossCheckSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerDivModNoSlacks, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerEngine, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerInvariants, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1027,6 +1092,7 @@ void CommandLineParser::processArgs()
 		{g_strModelCheckerSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerBMCLoopIterations, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerCHCThreads, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
 	};
@@ -1151,6 +1217,19 @@ void CommandLineParser::processArgs()
 
 	m_options.output.overwriteFiles = (m_args.count(g_strOverwrite) > 0);
 
+	if (m_args.count(g_strOptimizerCacheDir))
+	{
+		boost::filesystem::path cacheDirectory = m_args.at(g_strOptimizerCacheDir).as<std::string>();
+		if (cacheDirectory.empty())
+			solThrow(CommandLineValidationError, "Empty value is not allowed in --" + g_strOptimizerCacheDir + ".");
+		if (boost::filesystem::exists(cacheDirectory) && !boost::filesystem::is_directory(cacheDirectory))
+			solThrow(
+				CommandLineValidationError,
+				"Optimizer cache path \"" + cacheDirectory.string() + "\" exists but is not a directory."
+			);
+		m_options.optimizer.cacheDirectory = cacheDirectory;
+	}
+
 	if (m_args.count(g_strPrettyJson) > 0)
 	{
 		m_options.formatting.json.format = util::JsonFormat::Pretty;
@@ -1160,6 +1239,12 @@ void CommandLineParser::processArgs()
 		m_options.formatting.json.format = util::JsonFormat::Pretty;
 		m_options.formatting.json.indent = m_args[g_strJsonIndent].as<uint32_t>();
 	}
+	if (m_options.input.mode == InputMode::StandardJsonServer && m_options.formatting.json.format != util::JsonFormat::Compact)
+		solThrow(
+			CommandLineValidationError,
+			"Options --" + g_strPrettyJson + " and --" + g_strJsonIndent + " are not supported with --" + g_strServer + ", "
+			"which writes every response on a single line."
+		);
 
 	parseOutputSelection();
 
@@ -1205,7 +1290,7 @@ void CommandLineParser::processArgs()
 
 	parseInputPathsAndRemappings();
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::StandardJsonServer)
 		return;
 
 	if (m_args.count(g_strLibraries))
@@ -1366,6 +1451,9 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.contracts = std::move(*contracts);
 	}
 
+	if (m_args.count(g_strModelCheckerCrossCheckSolvers))
+		m_options.modelChecker.settings.crossCheckSolvers = true;
+
 	if (m_args.count(g_strModelCheckerDivModNoSlacks))
 		m_options.modelChecker.settings.divModNoSlacks = true;
 
@@ -1440,9 +1528,19 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.bmcLoopIterations = m_args[g_strModelCheckerBMCLoopIterations].as<unsigned>();
 	}
 
+	if (m_args.count(g_strModelCheckerCHCThreads))
+	{
+		unsigned chcThreads = m_args[g_strModelCheckerCHCThreads].as<unsigned>();
+		if (chcThreads == 0)
+			solThrow(CommandLineValidationError, "Invalid option for --" + g_strModelCheckerCHCThreads + ": 0");
+		m_options.modelChecker.settings.chcThreads = chcThreads;
+	}
+
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
+		m_args.count(g_strModelCheckerCHCThreads) ||
 		m_args.count(g_strModelCheckerContracts) ||
+		m_args.count(g_strModelCheckerCrossCheckSolvers) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerExtCalls) ||
@@ -1454,6 +1552,14 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerTargets) ||
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
+	m_options.output.parallelism = m_args[g_strJobs].as<size_t>();
+
+	if (m_args.count(g_strProfile))
+	{
+		m_options.output.profileFile = m_args.at(g_strProfile).as<std::string>();
+		if (m_options.output.profileFile.empty())
+			solThrow(CommandLineValidationError, "Empty value is not allowed in --" + g_strProfile + ".");
+	}
 
 	solAssert(
 		m_options.input.mode == InputMode::Compiler ||
@@ -30,6 +30,7 @@
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -1271,6 +1272,40 @@ BOOST_AUTO_TEST_CASE(peephole_truthy_and)
 }
 
 
+BOOST_AUTO_TEST_CASE(peephole_rounds_reexamine_rewritten_code)
+{
+	// Each round only removes the innermost push/pop pair, so the nested pairs in the middle
+	// of otherwise untouched code take one round each.
+	size_t const depth = 10;
+	AssemblyItems items;
+	for (size_t i = 0; i < 20; ++i)
+		items += AssemblyItems{u256(i), Instruction::CALLDATALOAD, Instruction::SLOAD};
+	AssemblyItems expectation = items;
+	for (size_t i = 0; i < depth; ++i)
+		items.emplace_back(u256(i));
+	for (size_t i = 0; i < depth; ++i)
+		items.emplace_back(Instruction::POP);
+	items += expectation;
+	expectation += AssemblyItems(expectation);
+
+	AssemblyItems itemsRescanned = items;
+	PeepholeOptimiser peepOpt(items, solidity::test::CommonOptions::get().evmVersion());
+	size_t rounds = 0;
+	while (peepOpt.optimise())
+	{
+		++rounds;
+		// A new optimiser examines all items.
+		BOOST_REQUIRE(PeepholeOptimiser(itemsRescanned, solidity::test::CommonOptions::get().evmVersion()).optimise());
+		BOOST_REQUIRE(items == itemsRescanned);
+	}
+	BOOST_CHECK(!PeepholeOptimiser(itemsRescanned, solidity::test::CommonOptions::get().evmVersion()).optimise());
+	BOOST_CHECK_EQUAL(rounds, depth);
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(peephole_iszero_iszero_jumpi)
 {
 	AssemblyItems items{
@@ -1399,6 +1434,86 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies, *boost::unit_test::precondi
 	);
 }
 
+BOOST_AUTO_TEST_CASE(subassemblies_optimised_concurrently, *boost::unit_test::precondition(nonEOF()))
+{
+	// Optimising independent sub-assemblies on several threads has to produce the same result
+	// as optimising them one after another, also if a sub-assembly is shared between several
+	// super-assemblies that reference different tags in it.
+	Assembly::OptimiserSettings settings = Assembly::OptimiserSettings::translateSettings(
+		OptimiserSettings::full(),
+		solidity::test::CommonOptions::get().evmVersion()
+	);
+
+	auto buildSub = [&](size_t _variant) {
+		AssemblyPointer sub = std::make_shared<Assembly>(settings.evmVersion, true, std::nullopt, std::string{});
+		sub->append(u256(_variant));
+		auto t1 = sub->newTag();
+		auto t2 = sub->newTag();
+		auto t3 = sub->newTag();
+		sub->append(t1);
+		sub->append(t3.pushTag());
+		sub->append(Instruction::JUMP);
+		sub->append(t2); // Identical to t1, will be unified
+		sub->append(t3.pushTag());
+		sub->append(Instruction::JUMP);
+		sub->append(t3);
+		sub->append(u256(0x1234567890) << 128);
+		sub->append(Instruction::POP);
+		sub->append(t3.pushTag());
+		sub->append(Instruction::JUMP);
+		return sub;
+	};
+
+	auto buildAndOptimise = [&](size_t _threadCount) {
+		AssemblyPointer shared = buildSub(0);
+		AssemblyPointer main = std::make_shared<Assembly>(settings.evmVersion, true, std::nullopt, std::string{});
+		for (size_t variant = 1; variant <= 6; ++variant)
+		{
+			AssemblyPointer sub = buildSub(variant);
+			size_t sharedId = static_cast<size_t>(sub->appendSubroutine(shared).data());
+			sub->append(AssemblyItem(PushTag, variant % 2 + 1).toSubAssemblyTag(sharedId));
+			size_t subId = static_cast<size_t>(main->appendSubroutine(sub).data());
+			main->append(AssemblyItem(PushTag, 2).toSubAssemblyTag(subId));
+		}
+		main->optimise(settings, _threadCount);
+		return main->assemblyString();
+	};
+
+	std::string const expectation = buildAndOptimise(1);
+	for (size_t threadCount: {2u, 4u, 8u})
+		BOOST_CHECK_EQUAL(buildAndOptimise(threadCount), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(constant_representations_memoised)
+{
+	// Representations found for constants are shared between assemblies. Reusing them
+	// has to produce the same code as searching for them from scratch.
+	langutil::EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	auto optimiseConstants = [&](bool _isCreation) {
+		Assembly assembly{evmVersion, _isCreation, std::nullopt, {}};
+		for (u256 const& value: {
+			(u256(1) << 160) - 1,
+			~((u256(1) << 160) - 1),
+			u256(0x1234567890) << 128,
+			u256(0xffffffff) << 224,
+			(u256(1) << 160) - 1
+		})
+		{
+			assembly.append(value);
+			assembly.append(Instruction::POP);
+		}
+		ConstantOptimisationMethod::optimiseConstants(_isCreation, 200, evmVersion, assembly);
+		return assembly.assemblyString();
+	};
+
+	for (bool isCreation: {false, true})
+	{
+		ConstantRepresentationCache::clear();
+		std::string const expectation = optimiseConstants(isCreation);
+		BOOST_CHECK_EQUAL(optimiseConstants(isCreation), expectation);
+	}
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
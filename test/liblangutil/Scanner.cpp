@@ -895,6 +895,44 @@ BOOST_AUTO_TEST_CASE(irregular_line_breaks_in_strings)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(long_tokens)
+{
+	// Long runs are consumed in chunks, so place the interesting characters at every offset.
+	for (size_t length = 0; length < 40; ++length)
+	{
+		std::string const run(length, 'a');
+		TestScanner scanner(
+			"x" + run + " \"" + run + "\\n" + run + "\" hex\"" + std::string(2 * length + 2, 'f') + "_00\"" +
+			" // " + run + "\xE2\x80\xA8 /* " + run + "* */ /// " + run + "\n/** " + run + "*\r\n* " + run + " */ y"
+		);
+		BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), "x" + run);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), run + "\n" + run);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::HexStringLiteral);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), std::string(length + 1, '\xff') + std::string(1, '\0'));
+		// The line separator ends the single-line comment and is illegal outside of it.
+		BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), "y");
+		BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), run + "*\n " + run + " ");
+		BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(directional_override_in_long_comment)
+{
+	std::string const text(40, 'a');
+	TestScanner scanner("/* " + text + "\xE2\x80\xAE" + text + " */ x");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::DirectionalOverrideMismatch);
+	scanner.reset("/* " + text + "\xE2\x80\xAE" + text + "\xE2\x80\xAC */ x");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "x");
+}
+
 BOOST_AUTO_TEST_CASE(solidity_keywords)
 {
 	// These are tokens which have a different meaning in Yul.
@@ -0,0 +1,137 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for the allocation of source units in an arena.
+ */
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+ASTPointer<SourceUnit> parse(std::string const& _source)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(_source, "");
+	ASTPointer<SourceUnit> sourceUnit = Parser(
+		errorReporter,
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion()
+	).parse(charStream);
+	BOOST_REQUIRE(sourceUnit);
+	BOOST_REQUIRE(errors.empty());
+	return sourceUnit;
+}
+
+std::vector<ASTNode const*> allNodes(ASTNode const& _root)
+{
+	std::vector<ASTNode const*> nodes;
+	SimpleASTVisitor visitor(
+		[&](ASTNode const& _node) { nodes.push_back(&_node); return true; },
+		[](ASTNode const&) {}
+	);
+	_root.accept(visitor);
+	return nodes;
+}
+
+std::string const source = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma solidity >=0.0;
+	contract C {
+		uint x;
+		struct S { uint a; bytes b; }
+		event E(uint indexed a);
+		function f(uint a, uint b) public returns (uint) {
+			for (uint i = 0; i < a; ++i)
+				x += b * i;
+			emit E(x);
+			return x;
+		}
+	}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(ASTArenaTest)
+
+BOOST_AUTO_TEST_CASE(nodes_keep_arena_alive)
+{
+	ASTPointer<SourceUnit> sourceUnit = parse(source);
+	ASTPointer<ContractDefinition> contract;
+	for (ASTPointer<ASTNode> const& node: sourceUnit->nodes())
+		if (auto contractDefinition = std::dynamic_pointer_cast<ContractDefinition>(node))
+			contract = contractDefinition;
+	BOOST_REQUIRE(contract);
+	sourceUnit.reset();
+
+	// The rest of the source unit is gone, but the contract with its subnodes, names and
+	// annotations still lives in the arena.
+	BOOST_CHECK_EQUAL(contract->name(), "C");
+	BOOST_REQUIRE_EQUAL(contract->definedFunctions().size(), 1);
+	BOOST_CHECK_EQUAL(contract->definedFunctions().front()->name(), "f");
+	for (ASTNode const* node: allNodes(*contract))
+		BOOST_CHECK(&node->annotation() == &node->annotation());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_annotation_requests)
+{
+	ASTPointer<SourceUnit> sourceUnit = parse(source);
+	std::vector<ASTNode const*> const nodes = allNodes(*sourceUnit);
+	BOOST_REQUIRE(nodes.size() > 20);
+
+	// None of the annotations exist yet, so all threads race to create them.
+	size_t const threadCount = 8;
+	std::vector<std::vector<ASTAnnotation const*>> annotations(threadCount);
+	std::vector<std::thread> threads;
+	for (size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+		threads.emplace_back([&, threadIndex]() {
+			for (ASTNode const* node: nodes)
+				annotations[threadIndex].push_back(&node->annotation());
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (size_t threadIndex = 1; threadIndex < threadCount; ++threadIndex)
+		BOOST_CHECK(annotations[threadIndex] == annotations[0]);
+	for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+		BOOST_CHECK(&nodes[nodeIndex]->annotation() == annotations[0][nodeIndex]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
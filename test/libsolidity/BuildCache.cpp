@@ -0,0 +1,130 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for reusing code generation results of earlier compilations.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+std::string const sourceA = R"(
+	pragma solidity >=0.0;
+	contract A { function f() public pure returns (uint) { return 1; } }
+)";
+
+std::string const sourceB = R"(
+	pragma solidity >=0.0;
+	import "a.sol";
+	contract B { function g() public returns (address) { return address(new A()); } }
+)";
+
+std::unique_ptr<CompilerStack> compile(
+	StringMap _sources,
+	bool _viaIR,
+	std::shared_ptr<CompilerStack::BuildCache> _cache
+)
+{
+	auto compilerStack = std::make_unique<CompilerStack>();
+	compilerStack->setSources(std::move(_sources));
+	compilerStack->setViaIR(_viaIR);
+	compilerStack->setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack->setBuildCache(std::move(_cache));
+	BOOST_REQUIRE(compilerStack->compile());
+	return compilerStack;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(BuildCache)
+
+BOOST_AUTO_TEST_CASE(unchanged_sources)
+{
+	for (bool viaIR: {false, true})
+	{
+		auto cache = std::make_shared<CompilerStack::BuildCache>();
+		auto first = compile({{"a.sol", sourceA}, {"b.sol", sourceB}}, viaIR, cache);
+		BOOST_CHECK_EQUAL(cache->size(), 2);
+		auto second = compile({{"a.sol", sourceA}, {"b.sol", sourceB}}, viaIR, cache);
+		BOOST_CHECK_EQUAL(cache->size(), 2);
+
+		for (std::string const contractName: {"a.sol:A", "b.sol:B"})
+		{
+			BOOST_CHECK(first->assemblyItems(contractName) == second->assemblyItems(contractName));
+			BOOST_CHECK(first->object(contractName).bytecode == second->object(contractName).bytecode);
+			BOOST_CHECK(first->runtimeObject(contractName).bytecode == second->runtimeObject(contractName).bytecode);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(changed_dependent)
+{
+	for (bool viaIR: {false, true})
+	{
+		auto cache = std::make_shared<CompilerStack::BuildCache>();
+		auto first = compile({{"a.sol", sourceA}, {"b.sol", sourceB}}, viaIR, cache);
+		auto second = compile({{"a.sol", sourceA}, {"b.sol", sourceB + "\n"}}, viaIR, cache);
+
+		BOOST_CHECK(first->assemblyItems("b.sol:B") != second->assemblyItems("b.sol:B"));
+		BOOST_CHECK(first->object("b.sol:B").bytecode != second->object("b.sol:B").bytecode);
+		// Legacy code generation has to compile A again to embed it in B.
+		BOOST_CHECK_EQUAL(first->assemblyItems("a.sol:A") == second->assemblyItems("a.sol:A"), viaIR);
+		BOOST_CHECK(first->object("a.sol:A").bytecode == second->object("a.sol:A").bytecode);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(changed_dependency)
+{
+	for (bool viaIR: {false, true})
+	{
+		auto cache = std::make_shared<CompilerStack::BuildCache>();
+		auto first = compile({{"a.sol", sourceA}, {"b.sol", sourceB}}, viaIR, cache);
+		auto second = compile({{"a.sol", sourceA + "\n"}, {"b.sol", sourceB}}, viaIR, cache);
+
+		for (std::string const contractName: {"a.sol:A", "b.sol:B"})
+		{
+			BOOST_CHECK(first->assemblyItems(contractName) != second->assemblyItems(contractName));
+			BOOST_CHECK(first->object(contractName).bytecode != second->object(contractName).bytecode);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(changed_settings)
+{
+	auto cache = std::make_shared<CompilerStack::BuildCache>();
+	auto first = compile({{"a.sol", sourceA}}, false /* _viaIR */, cache);
+	auto second = compile({{"a.sol", sourceA}}, true /* _viaIR */, cache);
+
+	BOOST_CHECK_EQUAL(cache->size(), 1);
+	BOOST_CHECK(first->assemblyItems("a.sol:A") != second->assemblyItems("a.sol:A"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -137,6 +137,8 @@ SMTCheckerTest::SMTCheckerTest(std::string const& _filename):
 	auto const& bmcLoopIterations = m_reader.sizetSetting("BMCLoopIterations", 1);
 	m_modelCheckerSettings.bmcLoopIterations = std::optional<unsigned>{bmcLoopIterations};
 
+	m_modelCheckerSettings.chcThreads = static_cast<unsigned>(m_reader.sizetSetting("SMTCHCThreads", 1));
+
 	// TODO: Enable EOF testing when EOF gets stable and smtCheckerTest starts using IR.
 	if (CommonOptions::get().eofVersion().has_value())
 		m_shouldRun = false;
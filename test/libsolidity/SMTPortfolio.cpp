@@ -0,0 +1,141 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for the selection of the answer of the solvers queried by the SMT portfolio.
+ */
+
+#include <libsmtutil/SMTPortfolio.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace solidity::smtutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Solver that gives a fixed answer after a delay, or as soon as it is interrupted.
+class FixedAnswerSolver: public BMCSolverInterface
+{
+public:
+	FixedAnswerSolver(CheckResult _result, std::vector<std::string> _values, std::chrono::milliseconds _delay):
+		m_result(_result), m_values(std::move(_values)), m_delay(_delay)
+	{}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(std::string const&, SortPointer const&) override {}
+	void addAssertion(Expression const&) override {}
+
+	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const&) override
+	{
+		auto const deadline = std::chrono::steady_clock::now() + m_delay;
+		while (std::chrono::steady_clock::now() < deadline)
+		{
+			if (m_interrupted)
+			{
+				m_wasInterrupted = true;
+				return {CheckResult::UNKNOWN, {}};
+			}
+			std::this_thread::sleep_for(1ms);
+		}
+		return {m_result, m_values};
+	}
+
+	bool supportsConcurrentCheck() const override { return true; }
+	void setInterrupted(bool _interrupted) override { m_interrupted = _interrupted; }
+
+	bool wasInterrupted() const { return m_wasInterrupted; }
+
+private:
+	CheckResult m_result;
+	std::vector<std::string> m_values;
+	std::chrono::milliseconds m_delay;
+	std::atomic<bool> m_interrupted = false;
+	std::atomic<bool> m_wasInterrupted = false;
+};
+
+std::pair<CheckResult, std::vector<std::string>> checkWithoutCrossCheck(
+	std::unique_ptr<FixedAnswerSolver> _first,
+	std::unique_ptr<FixedAnswerSolver> _second
+)
+{
+	std::vector<std::unique_ptr<BMCSolverInterface>> solvers;
+	solvers.emplace_back(std::move(_first));
+	solvers.emplace_back(std::move(_second));
+	SMTPortfolio portfolio(std::move(solvers), {}, false /* _crossCheck */);
+	return portfolio.check({});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+BOOST_AUTO_TEST_CASE(answer_of_first_solver_preferred)
+{
+	// The second solver answers first, but the answer of the first one is used.
+	auto [result, values] = checkWithoutCrossCheck(
+		std::make_unique<FixedAnswerSolver>(CheckResult::SATISFIABLE, std::vector<std::string>{"1"}, 200ms),
+		std::make_unique<FixedAnswerSolver>(CheckResult::SATISFIABLE, std::vector<std::string>{"2"}, 0ms)
+	);
+	BOOST_CHECK(result == CheckResult::SATISFIABLE);
+	BOOST_CHECK(values == std::vector<std::string>{"1"});
+}
+
+BOOST_AUTO_TEST_CASE(answer_of_second_solver_used_without_first_answer)
+{
+	auto [result, values] = checkWithoutCrossCheck(
+		std::make_unique<FixedAnswerSolver>(CheckResult::UNKNOWN, std::vector<std::string>{}, 100ms),
+		std::make_unique<FixedAnswerSolver>(CheckResult::SATISFIABLE, std::vector<std::string>{"2"}, 0ms)
+	);
+	BOOST_CHECK(result == CheckResult::SATISFIABLE);
+	BOOST_CHECK(values == std::vector<std::string>{"2"});
+}
+
+BOOST_AUTO_TEST_CASE(later_solvers_interrupted)
+{
+	auto first = std::make_unique<FixedAnswerSolver>(CheckResult::UNSATISFIABLE, std::vector<std::string>{}, 0ms);
+	auto second = std::make_unique<FixedAnswerSolver>(CheckResult::SATISFIABLE, std::vector<std::string>{"2"}, 60s);
+	FixedAnswerSolver const& secondSolver = *second;
+
+	std::vector<std::unique_ptr<BMCSolverInterface>> solvers;
+	solvers.emplace_back(std::move(first));
+	solvers.emplace_back(std::move(second));
+	SMTPortfolio portfolio(std::move(solvers), {}, false /* _crossCheck */);
+	auto [result, values] = portfolio.check({});
+	BOOST_CHECK(result == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(values.empty());
+	BOOST_CHECK(secondSolver.wasInterrupted());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -26,13 +26,17 @@
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
+#include <libyul/ObjectOptimizer.h>
+#include <libyul/YulString.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
 #include <test/Metadata.h>
 #include <test/Common.h>
 
 #include <algorithm>
+#include <map>
 #include <set>
+#include <thread>
 
 using namespace solidity::evmasm;
 using namespace std::string_literals;
@@ -1655,6 +1659,265 @@ BOOST_AUTO_TEST_CASE(stopAfter_ast_output)
 	BOOST_CHECK(result["sources"]["a.sol"]["ast"].is_object());
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_invalid_type)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"parallelism": -2,
+			"outputSelection":
+			{
+				"*": { "C": ["evm.bytecode"] }
+			}
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be an unsigned integer."));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_output)
+{
+	std::string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { uint x; function f() public { x = 1; } } contract B { function g() public returns (address) { return address(new A()); } } abstract contract I { function h() public virtual; } contract C is I { B b = new B(); function h() public override {} } contract D { function k() public pure returns (bytes memory) { return type(C).creationCode; } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"parallelism": <PARALLELISM>,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": ["irOptimized", "evm.bytecode", "evm.deployedBytecode", "evm.assembly"] }
+			}
+		}
+	}
+	)";
+
+	auto compileWithParallelism = [&](std::string const& _parallelism) {
+		return compile(boost::replace_all_copy(inputTemplate, "<PARALLELISM>", _parallelism));
+	};
+
+	Json sequentialResult = compileWithParallelism("1");
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(sequentialResult["contracts"]["A.sol"].size() == 5);
+	for (std::string const parallelism: {"2", "8", "32", "0"})
+		BOOST_CHECK(compileWithParallelism(parallelism) == sequentialResult);
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_ast)
+{
+	// Sources are parsed concurrently but have to get the same node IDs as when parsed one after
+	// another. C.sol lacks a license identifier and is therefore parsed again sequentially.
+	std::string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"./B.sol\";\nimport {C as D} from \"C.sol\";\ncontract A is B, D { function f() public pure returns (uint) { return g() + 1; } }"
+			},
+			"B.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"E.sol\";\n/// @notice B\ncontract B is E { struct S { uint x; } function g() internal pure returns (uint r) { assembly { r := 1 } } }"
+			},
+			"C.sol": {
+				"content": "pragma solidity >=0.0;\nimport \"E.sol\";\ncontract C is E { event Ev(uint indexed a); modifier m() { _; } }"
+			},
+			"E.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nenum X { Y, Z }\nerror Err(X);\ncontract E { mapping(uint => X) m; }"
+			}
+		},
+		"settings": {
+			"parallelism": <PARALLELISM>,
+			"outputSelection": {
+				"*": { "": ["ast"] }
+			}
+		}
+	}
+	)";
+
+	auto compileWithParallelism = [&](std::string const& _parallelism) {
+		return compile(boost::replace_all_copy(inputTemplate, "<PARALLELISM>", _parallelism));
+	};
+
+	Json sequentialResult = compileWithParallelism("1");
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(sequentialResult["sources"].size() == 4);
+	for (std::string const parallelism: {"2", "4", "0"})
+		BOOST_CHECK(compileWithParallelism(parallelism) == sequentialResult);
+}
+
+BOOST_AUTO_TEST_CASE(profile_invalid_type)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"profile": "yes"
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.profile\" must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(profile)
+{
+	std::string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "contract A { function f() public pure returns (uint) { return 1; } }" }
+		},
+		"settings": {
+			"viaIR": <VIAIR>,
+			"profile": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": ["evm.bytecode.object"] }
+			}
+		}
+	}
+	)";
+
+	for (std::string const viaIR: {"false", "true"})
+	{
+		Json result = compile(boost::replace_all_copy(inputTemplate, "<VIAIR>", viaIR));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		BOOST_REQUIRE(result["profile"]["traceEvents"].is_array());
+
+		std::map<std::string, std::string> phases;
+		for (Json const& event: result["profile"]["traceEvents"])
+			if (event["ph"] == "X")
+			{
+				BOOST_CHECK(event["dur"].is_number_unsigned());
+				phases[event["name"].get<std::string>()] = event["args"].value("detail", "");
+			}
+		BOOST_CHECK_EQUAL(phases["Parsing"], "A.sol");
+		BOOST_CHECK(phases.count("TypeChecker"));
+		if (viaIR == "true")
+		{
+			BOOST_CHECK_EQUAL(phases["IR generation"], "A.sol:A");
+			BOOST_CHECK_EQUAL(phases["IR optimization"], "A.sol:A");
+			BOOST_CHECK(phases.count("Yul object optimization"));
+			BOOST_CHECK_EQUAL(phases["EVM code generation"], "A.sol:A");
+		}
+		else
+		{
+			BOOST_CHECK_EQUAL(phases["Code generation"], "A.sol:A");
+			BOOST_CHECK(phases.count("PeepholeOptimiser"));
+		}
+	}
+
+	Json result = compile(boost::replace_all_copy(inputTemplate, "\"profile\": true,", ""));
+	BOOST_CHECK(!result.contains("profile"));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_compilations)
+{
+	std::string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { string s = \"<NAME>\"; mapping(uint => bytes32) m; function f(uint8 a, int16 b) public returns (uint) { m[a] = keccak256(bytes(s)); return uint(int(b)) + a; } }"
+			}
+		},
+		"settings": {
+			"viaIR": <VIAIR>,
+			"outputSelection": {
+				"*": { "*": ["abi", "storageLayout", "evm.bytecode.object", "evm.methodIdentifiers"], "": ["ast"] }
+			}
+		}
+	}
+	)";
+
+	std::vector<std::string> inputs;
+	for (std::string const viaIR: {"false", "true"})
+		for (std::string const name: {"x", "y", "z", "w"})
+			inputs.emplace_back(boost::replace_all_copy(
+				boost::replace_all_copy(inputTemplate, "<VIAIR>", viaIR),
+				"<NAME>",
+				name
+			));
+
+	std::vector<std::string> sequentialOutputs;
+	for (std::string const& input: inputs)
+		sequentialOutputs.emplace_back(frontend::StandardCompiler{}.compile(input));
+
+	// Boost.Test assertions are not thread-safe, so only compile inside the threads.
+	std::vector<std::string> concurrentOutputs(inputs.size());
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < inputs.size(); ++i)
+		threads.emplace_back([&, i]() { concurrentOutputs[i] = frontend::StandardCompiler{}.compile(inputs[i]); });
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (size_t i = 0; i < inputs.size(); ++i)
+	{
+		Json result;
+		BOOST_REQUIRE(util::jsonParseStrict(sequentialOutputs[i], result));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		BOOST_CHECK(concurrentOutputs[i] == sequentialOutputs[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(shared_object_optimizer_cache_bounded)
+{
+	std::string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { function f(uint x) external pure returns (uint) { return x * <FACTOR>; } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+		}
+	}
+	)";
+	size_t constexpr maxCachedObjects = 4;
+
+	auto objectOptimizer = std::make_shared<yul::ObjectOptimizer>();
+	frontend::StandardCompiler compiler;
+	compiler.setObjectOptimizer(objectOptimizer, maxCachedObjects);
+
+	std::vector<size_t> repositorySizes;
+	for (size_t factor = 2; factor < 14; ++factor)
+	{
+		std::string const input = boost::replace_all_copy(inputTemplate, "<FACTOR>", std::to_string(factor));
+		Json result;
+		BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input), result));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		// Each request adds the creation and the deployed object.
+		BOOST_TEST(objectOptimizer->size() <= maxCachedObjects + 2);
+		// The output must not depend on what the cache held before.
+		Json uncachedResult;
+		BOOST_REQUIRE(util::jsonParseStrict(frontend::StandardCompiler{}.compile(input), uncachedResult));
+		BOOST_TEST(
+			getContractResult(result, "A.sol", "A")["evm"]["bytecode"]["object"] ==
+			getContractResult(uncachedResult, "A.sol", "A")["evm"]["bytecode"]["object"]
+		);
+		// A string that is not in the repository yet gets the next free ID,
+		// i.e. the number of strings in the repository.
+		repositorySizes.push_back(yul::YulString("probe_" + std::to_string(factor)).id());
+	}
+	// Without a reset, the repository would only grow.
+	BOOST_TEST(!std::ranges::is_sorted(repositorySizes));
+}
+
 BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract)
 {
 	char const* input = R"(
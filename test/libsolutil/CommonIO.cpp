@@ -65,6 +65,48 @@ BOOST_AUTO_TEST_CASE(readFileAsString_symlink)
 	BOOST_TEST(readFileAsString(tempDir.path() / "symlink.txt") == "ABC\ndef\n");
 }
 
+BOOST_AUTO_TEST_CASE(readFileAsSharedText_regular_file)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	std::string largeContent;
+	while (largeContent.size() < c_fileMappingThreshold)
+		largeContent += "contract C {}\n";
+	createFileWithContent(tempDir.path() / "small.txt", "ABC\ndef\n");
+	createFileWithContent(tempDir.path() / "large.txt", largeContent);
+	createFileWithContent(tempDir.path() / "empty.txt", "");
+
+	BOOST_TEST(readFileAsSharedText(tempDir.path() / "small.txt").view() == "ABC\ndef\n");
+	BOOST_TEST(readFileAsSharedText(tempDir.path() / "large.txt").view() == largeContent);
+	BOOST_TEST(readFileAsSharedText(tempDir.path() / "empty.txt").empty());
+
+	SharedText copy = readFileAsSharedText(tempDir.path() / "large.txt");
+	BOOST_TEST(SharedText(copy).data() == copy.data());
+}
+
+BOOST_AUTO_TEST_CASE(readFileAsSharedText_zero_after_end)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	// Covers files that end in the middle of a page and files that end at a page boundary.
+	for (size_t size: {c_fileMappingThreshold, c_fileMappingThreshold + 1, c_fileMappingThreshold * 2 - 1})
+	{
+		std::string content(size, 'x');
+		boost::filesystem::path const path = tempDir.path() / (std::to_string(size) + ".txt");
+		createFileWithContent(path, content);
+
+		SharedText text = readFileAsSharedText(path);
+		BOOST_TEST(text.view() == content);
+		BOOST_TEST(text.data()[text.size()] == '\0');
+	}
+	BOOST_TEST(SharedText().data()[0] == '\0');
+}
+
+BOOST_AUTO_TEST_CASE(readFileAsSharedText_directory)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	BOOST_CHECK_THROW(readFileAsSharedText(tempDir), NotAFile);
+	BOOST_CHECK_THROW(readFileAsSharedText(tempDir.path() / "missing.txt"), FileNotFound);
+}
+
 BOOST_AUTO_TEST_CASE(readUntilEnd_no_ending_newline)
 {
 	std::istringstream inputStream("ABC\ndef");
@@ -26,6 +26,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 
 namespace solidity::util::test
 {
@@ -117,6 +119,45 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK(R"({"1":1,"2":"2","3":{"3.1":"3.1","3.2":2},"4":"\u0911 \u0912 \u0913 \u0914 \u0915 \u0916","5":"\u0010","6":"\u4e2d"})" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+	Json deferred;
+	deferred["a"] = Json::array();
+	deferred["b"] = {1, "\u4e2d", Json::object()};
+	Json expectation;
+	expectation["1"] = deferred;
+	expectation["2"] = Json::array({deferred, 2});
+	expectation["3"] = Json::object();
+
+	Json json;
+	json["1"] = JsonStreamWriter::deferredValue(0);
+	json["2"] = Json::array({JsonStreamWriter::deferredValue(1), 2});
+	json["3"] = Json::object();
+
+	for (JsonFormat format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		std::vector<uint64_t> ids;
+		std::ostringstream stream;
+		JsonStreamWriter writer(stream, format);
+		writer.value(json, [&](JsonStreamWriter& _writer, uint64_t _id) {
+			ids.push_back(_id);
+			_writer.beginObject();
+			_writer.key("a");
+			_writer.beginArray();
+			_writer.endArray();
+			_writer.key("b");
+			_writer.beginArray();
+			_writer.value(1);
+			_writer.value("\u4e2d");
+			_writer.value(Json::object());
+			_writer.endArray();
+			_writer.endObject();
+		});
+		BOOST_CHECK(stream.str() == jsonPrint(expectation, format));
+		BOOST_CHECK(ids == std::vector<uint64_t>({0, 1}));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
@@ -0,0 +1,137 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+std::vector<Json> completeEvents(Profiler const& _profiler)
+{
+	Json const trace = _profiler.chromeTrace();
+	std::vector<Json> events;
+	for (Json const& event: trace["traceEvents"])
+		if (event["ph"] == "X")
+			events.push_back(event);
+	return events;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ProfilerTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(probes_without_scope_are_ignored)
+{
+	Profiler profiler;
+	{
+		Profiler::Probe probe("outside", "test");
+	}
+	{
+		Profiler::Scope scope(&profiler);
+		Profiler::Scope disabled(nullptr);
+		Profiler::Probe probe("disabled", "test");
+	}
+	BOOST_CHECK(completeEvents(profiler).empty());
+	BOOST_CHECK(Profiler::current() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(nested_probes)
+{
+	Profiler profiler;
+	{
+		Profiler::Scope scope(&profiler);
+		Profiler::Probe outer("outer", "test", "detail");
+		{
+			Profiler::Probe inner("inner", "test");
+		}
+	}
+
+	std::vector<Json> events = completeEvents(profiler);
+	BOOST_REQUIRE_EQUAL(events.size(), 2);
+	// Probes are recorded when they end.
+	BOOST_CHECK_EQUAL(events[0]["name"], "inner");
+	BOOST_CHECK_EQUAL(events[1]["name"], "outer");
+	BOOST_CHECK_EQUAL(events[1]["cat"], "test");
+	BOOST_CHECK_EQUAL(events[1]["args"]["detail"], "detail");
+	BOOST_CHECK(!events[0]["args"].contains("detail"));
+	BOOST_CHECK(events[1]["ts"].get<int64_t>() <= events[0]["ts"].get<int64_t>());
+	BOOST_CHECK(
+		events[0]["ts"].get<int64_t>() + events[0]["dur"].get<int64_t>() <=
+		events[1]["ts"].get<int64_t>() + events[1]["dur"].get<int64_t>()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_tasks_inherit_profiler)
+{
+	Profiler profiler;
+	{
+		Profiler::Scope scope(&profiler);
+		runTaskGraph({{}, {}, {}, {0, 1, 2}}, 3, [](size_t _task) {
+			Profiler::Probe probe("task " + std::to_string(_task), "test");
+		});
+	}
+
+	std::set<std::string> names;
+	for (Json const& event: completeEvents(profiler))
+		names.insert(event["name"].get<std::string>());
+	BOOST_CHECK((names == std::set<std::string>{"task 0", "task 1", "task 2", "task 3"}));
+}
+
+BOOST_AUTO_TEST_CASE(creating_thread_is_main)
+{
+	Profiler profiler;
+	std::thread worker([&]() {
+		Profiler::Scope scope(&profiler);
+		Profiler::Probe probe("worker", "test");
+	});
+	worker.join();
+	{
+		Profiler::Scope scope(&profiler);
+		Profiler::Probe probe("main", "test");
+	}
+
+	Json const trace = profiler.chromeTrace();
+	std::map<size_t, std::string> threadNames;
+	for (Json const& event: trace["traceEvents"])
+		if (event["ph"] == "M")
+			threadNames[event["tid"].get<size_t>()] = event["args"]["name"].get<std::string>();
+	BOOST_CHECK((threadNames == std::map<size_t, std::string>{{0, "main"}, {1, "worker 1"}}));
+
+	std::vector<Json> events = completeEvents(profiler);
+	BOOST_REQUIRE_EQUAL(events.size(), 2);
+	BOOST_CHECK_EQUAL(events[0]["name"], "worker");
+	BOOST_CHECK_EQUAL(events[0]["tid"], 1);
+	BOOST_CHECK_EQUAL(events[1]["name"], "main");
+	BOOST_CHECK_EQUAL(events[1]["tid"], 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
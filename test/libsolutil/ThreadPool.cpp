@@ -0,0 +1,124 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(submit_returns_results)
+{
+	ThreadPool pool(4);
+	std::vector<std::future<size_t>> results;
+	for (size_t i = 0; i < 100; ++i)
+		results.emplace_back(pool.submit([i]() { return i * i; }));
+
+	for (size_t i = 0; i < 100; ++i)
+		BOOST_CHECK_EQUAL(results[i].get(), i * i);
+}
+
+BOOST_AUTO_TEST_CASE(submit_propagates_exceptions)
+{
+	ThreadPool pool(2);
+	std::future<int> result = pool.submit([]() -> int { throw std::runtime_error("failure"); });
+	BOOST_CHECK_THROW(result.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(wait_and_destructor_run_all_tasks)
+{
+	std::atomic<size_t> counter = 0;
+	{
+		ThreadPool pool(3);
+		for (size_t i = 0; i < 50; ++i)
+			pool.post([&]() { ++counter; });
+		pool.wait();
+		BOOST_CHECK_EQUAL(counter.load(), 50);
+
+		for (size_t i = 0; i < 50; ++i)
+			pool.post([&]() { ++counter; });
+	}
+	BOOST_CHECK_EQUAL(counter.load(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(task_graph_respects_dependencies)
+{
+	// 0 <- 1 <- 3, 0 <- 2 <- 3, 4 independent
+	std::vector<std::set<size_t>> dependencies{{}, {0}, {0}, {1, 2}, {}};
+	for (size_t threadCount: {1u, 2u, 8u})
+	{
+		std::mutex mutex;
+		std::vector<size_t> order;
+		runTaskGraph(dependencies, threadCount, [&](size_t _task) {
+			std::lock_guard<std::mutex> lock(mutex);
+			order.push_back(_task);
+		});
+
+		BOOST_REQUIRE_EQUAL(order.size(), dependencies.size());
+		auto position = [&](size_t _task) { return std::find(order.begin(), order.end(), _task) - order.begin(); };
+		for (size_t task = 0; task < dependencies.size(); ++task)
+			for (size_t dependency: dependencies[task])
+				BOOST_CHECK(position(dependency) < position(task));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(task_graph_single_thread_runs_in_index_order)
+{
+	std::vector<size_t> order;
+	runTaskGraph({{}, {}, {0}, {}}, 1, [&](size_t _task) { order.push_back(_task); });
+	BOOST_CHECK((order == std::vector<size_t>{0, 1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(task_graph_rethrows_lowest_failure)
+{
+	for (size_t threadCount: {1u, 4u})
+	{
+		std::atomic<bool> dependentRan = false;
+		BOOST_CHECK_EXCEPTION(
+			runTaskGraph({{}, {}, {1}}, threadCount, [&](size_t _task) {
+				if (_task == 1)
+					throw std::runtime_error("1");
+				if (_task == 2)
+					dependentRan = true;
+			}),
+			std::runtime_error,
+			[](std::runtime_error const& _error) { return std::string(_error.what()) == "1"; }
+		);
+		BOOST_CHECK(!dependentRan);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(task_graph_rejects_cycles)
+{
+	BOOST_CHECK_THROW(runTaskGraph({{1}, {0}}, 1, [](size_t) {}), InvalidTaskGraph);
+	BOOST_CHECK_THROW(runTaskGraph({{1}, {0}}, 2, [](size_t) {}), InvalidTaskGraph);
+	BOOST_CHECK_THROW(runTaskGraph({{5}}, 2, [](size_t) {}), InvalidTaskGraph);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -216,6 +216,29 @@ BOOST_AUTO_TEST_CASE(list_can_access_upper)
 	BOOST_CHECK_EQUAL(result, "(A)(A)");
 }
 
+BOOST_AUTO_TEST_CASE(list_element_as_conditional)
+{
+	std::string templ = "<#b><?+x>[<x>]<!+x>-</+x></b>";
+	std::vector<std::map<std::string, std::string>> list(2);
+	list[0]["x"] = "X";
+	list[1]["x"] = "";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("b", list).render(), "[X]-");
+}
+
+BOOST_AUTO_TEST_CASE(same_template_different_values)
+{
+	std::string templ = "<?c><a><!c>x</c><#b><e></b>";
+	Whiskers m1(templ);
+	Whiskers m2(templ);
+	std::vector<std::map<std::string, std::string>> list(1);
+	list[0]["e"] = "E";
+	m1("c", true)("a", "A")("b", list);
+	m2("c", false)("a", "B")("b", std::vector<std::map<std::string, std::string>>{});
+	BOOST_CHECK_EQUAL(m1.render(), "AE");
+	BOOST_CHECK_EQUAL(m2.render(), "x");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("a", "C")("b", list).render(), "CE");
+}
+
 BOOST_AUTO_TEST_CASE(parameter_collision)
 {
 	std::string templ = "a <#b></b>";
@@ -0,0 +1,158 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the memoisation of the Yul constant optimiser.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/backends/evm/ConstantOptimiser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/ConstantRepresentationCache.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace solidity::langutil;
+using namespace solidity::evmasm;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+EVMDialect const& dialect()
+{
+	return EVMDialect::strictAssemblyForEVMObjects(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion()
+	);
+}
+
+/// @returns @a _expression including the source location of every node.
+std::string describe(Expression const& _expression)
+{
+	if (Literal const* literal = std::get_if<Literal>(&_expression))
+		return formatNumber(literal->value.value()) + "@" + std::to_string(literal->debugData->nativeLocation.start);
+
+	FunctionCall const& call = std::get<FunctionCall>(_expression);
+	BuiltinName const& name = std::get<BuiltinName>(call.functionName);
+	std::string result =
+		dialect().builtin(name.handle).name + "@" +
+		std::to_string(call.debugData->nativeLocation.start) + "/" +
+		std::to_string(name.debugData->nativeLocation.start) + "(";
+	for (Expression const& argument: call.arguments)
+		result += describe(argument) + ",";
+	return result + ")";
+}
+
+/// Optimises a block of one expression statement per constant in @a _values, with the literals
+/// located at consecutive offsets starting at @a _firstOffset.
+std::vector<std::string> optimiseConstants(std::vector<u256> const& _values, int _firstOffset, bool _isCreation)
+{
+	Block block{DebugData::create(), {}};
+	int offset = _firstOffset;
+	for (u256 const& value: _values)
+	{
+		DebugData::ConstPtr debugData = DebugData::create(SourceLocation{offset, offset + 1, nullptr});
+		block.statements.emplace_back(ExpressionStatement{
+			debugData,
+			Literal{debugData, LiteralKind::Number, LiteralValue{value, formatNumber(value)}}
+		});
+		++offset;
+	}
+
+	GasMeter meter(dialect(), _isCreation, 200);
+	ConstantOptimiser{dialect(), meter}(block);
+
+	std::vector<std::string> result;
+	for (Statement const& statement: block.statements)
+		result.emplace_back(describe(std::get<ExpressionStatement>(statement).expression));
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulConstantOptimiser)
+
+BOOST_AUTO_TEST_CASE(memoised_representations_reproduce_search)
+{
+	// Constants sharing parts of their representations, so that a search reuses what earlier
+	// searches found and the debug data of reused parts points at the earlier literals.
+	std::vector<u256> const constants = {
+		(u256(1) << 160) - 1,
+		~((u256(1) << 160) - 1),
+		(u256(0x1234567890) << 128) + 0x12345,
+		u256(0xffffffff) << 224,
+		(u256(0xffffffff) << 224) + 0x12345,
+		(u256(1) << 160) - 1,
+		(u256(1) << 200) - 0x12345,
+	};
+	std::vector<u256> const otherConstants = {
+		u256(0xffffffff) << 224,
+		(u256(1) << 200) - 0x12345,
+		u256(0x12345),
+		~((u256(1) << 160) - 1),
+	};
+
+	for (bool isCreation: {false, true})
+	{
+		ConstantRepresentationCache::clear();
+		std::vector<std::string> const expectation = optimiseConstants(constants, 0, isCreation);
+
+		// Representations restored from the memo have to match the search in every detail,
+		// regardless of the order in which they were memoised.
+		ConstantRepresentationCache::clear();
+		optimiseConstants(otherConstants, 100, isCreation);
+		BOOST_CHECK(optimiseConstants(constants, 0, isCreation) == expectation);
+		BOOST_CHECK(optimiseConstants(constants, 0, isCreation) == expectation);
+	}
+	ConstantRepresentationCache::clear();
+}
+
+BOOST_AUTO_TEST_CASE(memoised_representations_are_used)
+{
+	u256 const value = (u256(1) << 160) - 1;
+	ConstantRepresentationCache::clear();
+	ScopeGuard clearCache([]() { ConstantRepresentationCache::clear(); });
+
+	BOOST_CHECK(optimiseConstants({value}, 0, false) != std::vector<std::string>{"0xffffffffffffffffffffffffffffffffffffffff@0"});
+
+	// A memoised choice to keep the literal takes precedence over searching.
+	ConstantRepresentationCache::clear();
+	ConstantRepresentationCache::Key key{
+		ConstantRepresentationCache::CostModel::Yul,
+		value,
+		dialect().evmVersion(),
+		false,
+		200
+	};
+	ConstantRepresentationCache::store(key, {ConstantRepresentationCache::Method::Literal, {}, 0, {}, 0});
+	BOOST_CHECK(optimiseConstants({value}, 0, false) == std::vector<std::string>{"0xffffffffffffffffffffffffffffffffffffffff@0"});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -10,6 +10,7 @@ import os
 import re
 import subprocess
 import sys
+import tempfile
 import traceback
 from collections import namedtuple
 from copy import deepcopy
@@ -239,6 +240,20 @@ class JsonRpcProcess:
         self.process.stdin.write(rpc_message.encode("utf-8"))
         self.process.stdin.flush()
 
+    def send_response(self, message_id: Any, result: Any) -> None:
+        if self.process.stdin is None:
+            return
+        message = {
+            'jsonrpc': '2.0',
+            'id': message_id,
+            'result': result
+        }
+        json_string = json.dumps(obj=message)
+        rpc_message = f"Content-Length: {len(json_string)}\r\n\r\n{json_string}"
+        self.trace(f'send_response ({message_id})', json.dumps(message, indent=4, sort_keys=True))
+        self.process.stdin.write(rpc_message.encode("utf-8"))
+        self.process.stdin.flush()
+
     def call_method(self, method_name: str, params: Optional[dict], expects_response: bool = True) -> Any:
         self.send_message(method_name, params)
         if not expects_response:
@@ -911,7 +926,8 @@ class SolidityLSPTestSuite: # {{{
         expose_project_root=True,
         file_load_strategy: FileLoadStrategy=FileLoadStrategy.DirectlyOpenedAndOnImport,
         custom_include_paths: list[str] = None,
-        project_root_subdir=None
+        project_root_subdir=None,
+        watch_files=False
     ):
         """
         Prepares the solc LSP server by calling `initialize`,
@@ -952,6 +968,9 @@ class SolidityLSPTestSuite: # {{{
         if not expose_project_root:
             params['rootUri'] = None
 
+        if watch_files:
+            params['capabilities']['workspace']['didChangeWatchedFiles'] = {'dynamicRegistration': True}
+
         lsp.call_method('initialize', params)
         lsp.send_notification('initialized')
 
@@ -990,6 +1009,16 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(message['method'], method_name, description="Ensure expected method name")
         return message['params']
 
+    def accept_watched_files_registration(self, solc: JsonRpcProcess) -> dict:
+        """
+        Receives the request of the server to watch files and confirms it.
+        Returns the registration.
+        """
+        message = solc.receive_message()
+        registration = self.require_params_for_method('client/registerCapability', message)['registrations'][0]
+        solc.send_response(message['id'], None)
+        return registration
+
     def wait_for_diagnostics(self, solc: JsonRpcProcess) -> List[dict]:
         """
         Return all published diagnostic reports sorted by file URI.
@@ -1871,6 +1900,82 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(reports[0]['uri'], f'{self.project_root_uri}/goto/lib.sol', "")
         self.expect_equal(len(reports[0]['diagnostics']), 0, "should not contain diagnostics")
 
+    def test_workspace_didChangeWatchedFiles(self, solc: JsonRpcProcess) -> None:
+        """
+        If the client supports it, the server registers a watcher for the Solidity files
+        and recompiles when an imported file that is not open changes on disk.
+        """
+
+        self.setup_lsp(solc, watch_files=True)
+        registration = self.accept_watched_files_registration(solc)
+        self.expect_equal(registration['method'], 'workspace/didChangeWatchedFiles')
+        self.expect_equal(registration['registerOptions']['watchers'], [{'globPattern': '**/*.sol'}])
+
+        TEST_NAME = 'didOpen_with_import'
+        published_diagnostics = self.open_file_and_wait_for_diagnostics(solc, TEST_NAME)
+        self.expect_equal(len(published_diagnostics), 2, "Diagnostic reports for 2 files")
+
+        solc.send_message('workspace/didChangeWatchedFiles', {
+            'changes': [{'uri': self.get_test_file_uri('lib', 'goto'), 'type': 2}]
+        })
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(published_diagnostics), 2, "Diagnostic reports for 2 files")
+        report = published_diagnostics[1]
+        self.expect_equal(report['uri'], self.get_test_file_uri('lib', 'goto'), "Correct file URI")
+        self.expect_equal(len(report['diagnostics']), 1, "one diagnostic")
+        marker = self.get_test_tags("lib", "goto")["@diagnostics"]
+        self.expect_diagnostic(report['diagnostics'][0], code=2072, marker=marker)
+
+    def test_workspace_didChangeWatchedFiles_include_path(self, solc: JsonRpcProcess) -> None:
+        """
+        Files imported from include paths outside of the watched workspace are still
+        checked for changes on disk before compiling.
+        """
+        LIB_SOURCE = "// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\nlibrary L { function f() internal pure {<BODY>} }\n"
+        with tempfile.TemporaryDirectory() as temp_dir:
+            include_dir = os.path.realpath(temp_dir)
+            lib_path = os.path.join(include_dir, 'watched_include_lib.sol')
+            with open(lib_path, 'w', encoding='utf-8') as lib_file:
+                lib_file.write(LIB_SOURCE.replace('<BODY>', ''))
+            lib_uri = PurePath(lib_path).as_uri()
+
+            self.setup_lsp(solc, custom_include_paths=[include_dir], watch_files=True)
+            self.accept_watched_files_registration(solc)
+
+            FILE_URI = self.get_test_file_uri('watched_include_user')
+            solc.send_message('textDocument/didOpen', {
+                'textDocument': {
+                    'uri': FILE_URI,
+                    'languageId': 'Solidity',
+                    'version': 1,
+                    'text':
+                        "// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\n"
+                        "import \"watched_include_lib.sol\";\n"
+                        "contract C { function g() public pure { L.f(); } }\n"
+                }
+            })
+            reports = {report['uri']: report for report in self.wait_for_diagnostics(solc)}
+            self.expect_equal(set(reports.keys()), {FILE_URI, lib_uri}, "Diagnostic reports for both files")
+            self.expect_equal(len(reports[lib_uri]['diagnostics']), 0, "no diagnostics")
+
+            with open(lib_path, 'w', encoding='utf-8') as lib_file:
+                lib_file.write(LIB_SOURCE.replace('<BODY>', ' uint x; '))
+            solc.send_message('textDocument/didChange', {
+                'textDocument': { 'uri': FILE_URI },
+                'contentChanges': [
+                    {
+                        'range': {
+                            'start': { 'line': 4, 'character': 0 },
+                            'end': { 'line': 4, 'character': 0 }
+                        },
+                        'text': "\n"
+                    }
+                ]
+            })
+            reports = {report['uri']: report for report in self.wait_for_diagnostics(solc)}
+            self.expect_equal(len(reports[lib_uri]['diagnostics']), 1, "one diagnostic")
+            self.expect_diagnostic(reports[lib_uri]['diagnostics'][0], code=2072, lineNo=2, startEndColumns=(41, 47))
+
     def test_textDocument_didChange_at_eol(self, solc: JsonRpcProcess) -> None:
         """
         Append at one line and insert a new one below.
@@ -1972,6 +2077,74 @@ class SolidityLSPTestSuite: # {{{
         published_diagnostics = self.wait_for_diagnostics(solc)
         self.verify_didOpen_with_import_diagnostics(published_diagnostics, 'a_new_file')
 
+    def test_textDocument_didChange_rapid_changes(self, solc: JsonRpcProcess) -> None:
+        """
+        Sends several changes right after each other, followed by a request, and checks
+        that the diagnostics eventually published are those of the final file content.
+        """
+        self.setup_lsp(solc)
+        FILE_NAME = 'didChange_template'
+        FILE_URI = self.get_test_file_uri(FILE_NAME)
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': FILE_URI,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': self.get_test_file_contents(FILE_NAME)
+            }
+        })
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(published_diagnostics), 1, "one publish diagnostics notification")
+        self.expect_equal(len(published_diagnostics[0]['diagnostics']), 0, "no diagnostics")
+
+        changes = [
+            ((4, 1), (4, 1), "\n  uint x = -1;"),
+            ((5, 11), (5, 13), "1"),
+            ((5, 14), (5, 14), "\n  function f() public pure { uint y; }"),
+        ]
+        for start, end, text in changes:
+            solc.send_message('textDocument/didChange', {
+                'textDocument': { 'uri': FILE_URI },
+                'contentChanges': [
+                    {
+                        'range': {
+                            'start': { 'line': start[0], 'character': start[1] },
+                            'end': { 'line': end[0], 'character': end[1] }
+                        },
+                        'text': text
+                    }
+                ]
+            })
+        solc.send_message('textDocument/definition', {
+            'textDocument': { 'uri': FILE_URI },
+            'position': { 'line': 3, 'character': 9 }
+        })
+
+        # Changes may or may not be compiled together, so reports of intermediate
+        # contents can arrive before the one of the final content.
+        intermediate_codes = [[7407], []]
+        response_received = False
+        final_diagnostics = None
+        while not response_received or final_diagnostics is None:
+            message = solc.receive_message()
+            assert message is not None # This can happen if the server aborts early.
+            if 'method' not in message:
+                self.expect_true('result' in message, "request answered without error")
+                response_received = True
+                continue
+            if message['method'] != '$/logTrace' or 'openFileCount' not in message['params']:
+                continue
+            self.expect_equal(message['params']['openFileCount'], 1, "one open file")
+            report = self.require_params_for_method('textDocument/publishDiagnostics', solc.receive_message())
+            self.expect_equal(report['uri'], FILE_URI, "Correct file URI")
+            codes = [diagnostic['code'] for diagnostic in report['diagnostics']]
+            if codes == [2072]:
+                final_diagnostics = report['diagnostics']
+            else:
+                self.expect_true(codes in intermediate_codes, f"diagnostics of an intermediate content: {codes}")
+
+        self.expect_diagnostic(final_diagnostics[0], 2072, 6, (29, 35))
+
     def test_textDocument_didChange_multi_line(self, solc: JsonRpcProcess) -> None:
         """
         Starts with an empty file and changes it to multiple times, changing
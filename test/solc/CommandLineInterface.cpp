@@ -29,13 +29,18 @@
 #include <liblangutil/SemVerHandler.h>
 #include <test/FilesystemUtils.h>
 
+#include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
 #include <libsolutil/TemporaryDirectory.h>
 
 #include <boost/algorithm/string.hpp>
 
 #include <range/v3/view/transform.hpp>
 
+#include <ctime>
+#include <fstream>
+#include <functional>
 #include <map>
 #include <ostream>
 #include <set>
@@ -65,7 +70,7 @@ std::ostream& operator<<(std::ostream& _out, std::vector<ImportRemapper::Remappi
 	return _out;
 }
 
-std::ostream& operator<<(std::ostream& _out, std::map<std::string, std::string> const& _map)
+std::ostream& operator<<(std::ostream& _out, FileReader::StringMap const& _map)
 {
 	_out << "{" << std::endl;
 	for (auto const& [key, value]: _map)
@@ -98,9 +103,9 @@ struct print_log_value<std::vector<ImportRemapper::Remapping>>
 };
 
 template<>
-struct print_log_value<std::map<std::string, std::string>>
+struct print_log_value<FileReader::StringMap>
 {
-	void operator()(std::ostream& _out, std::map<std::string, std::string> const& _value) { ::operator<<(_out, _value); }
+	void operator()(std::ostream& _out, FileReader::StringMap const& _value) { ::operator<<(_out, _value); }
 };
 
 template<>
@@ -210,7 +215,7 @@ BOOST_AUTO_TEST_CASE(cli_input)
 		{"", "a", "b/c/d"},
 		{"a", "b", "c/d/e/"},
 	};
-	std::map<std::string, std::string> expectedSources = {
+	FileReader::StringMap expectedSources = {
 		{"<stdin>", ""},
 		{(expectedDir1 / "input1.sol").generic_string(), ""},
 		{(expectedDir2 / "input2.sol").generic_string(), ""},
@@ -274,7 +279,7 @@ BOOST_AUTO_TEST_CASE(cli_ignore_missing_some_files_exist)
 	soltestAssert(expectedDir1.is_absolute() || expectedDir1.root_path() == "/", "");
 
 	// NOTE: Allowed paths should not be added for skipped files.
-	std::map<std::string, std::string> expectedSources = {{(expectedDir1 / "input1.sol").generic_string(), ""}};
+	FileReader::StringMap expectedSources = {{(expectedDir1 / "input1.sol").generic_string(), ""}};
 	PathSet expectedAllowedPaths = {boost::filesystem::canonical(tempDir1)};
 
 	OptionsReaderAndMessages result = parseCommandLineAndReadInputFiles({
@@ -442,6 +447,197 @@ BOOST_AUTO_TEST_CASE(standard_json_remapping)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(standard_json_server)
+{
+	std::string const request =
+		R"({"language": "Solidity", "sources": {"A.sol": {"content": "pragma solidity >=0.0; contract A {}"}}, )"
+		R"("settings": {"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}})";
+
+	OptionsReaderAndMessages result = runCLI({"solc", "--server"}, request + "\n\n" + request + "\n");
+	BOOST_REQUIRE(result.success);
+	BOOST_TEST(result.stderrContent == "");
+	BOOST_TEST(result.options.input.mode == InputMode::StandardJsonServer);
+
+	std::vector<std::string> responses;
+	boost::split(responses, boost::trim_copy(result.stdoutContent), boost::is_any_of("\n"));
+	BOOST_REQUIRE_EQUAL(responses.size(), 2);
+
+	std::vector<std::string> bytecodes;
+	for (std::string const& response: responses)
+	{
+		Json parsedResponse;
+		BOOST_REQUIRE(util::jsonParseStrict(response, parsedResponse));
+		for (Json const& errorDict: parsedResponse["errors"])
+			// The error list might contain pre-release compiler warning
+			BOOST_TEST(errorDict["severity"] != "error");
+		bytecodes.push_back(parsedResponse["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["object"].get<std::string>());
+	}
+	BOOST_TEST(!bytecodes[0].empty());
+	BOOST_TEST(bytecodes[0] == bytecodes[1]);
+}
+
+BOOST_AUTO_TEST_CASE(standard_json_server_via_ir)
+{
+	auto makeRequest = [](std::string const& _source) {
+		return
+			R"({"language": "Solidity", "sources": {"A.sol": {"content": ")" + _source + R"("}}, )"
+			R"("settings": {"viaIR": true, "optimizer": {"enabled": true}, )"
+			R"("outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}})";
+	};
+	std::string const requestA = makeRequest(
+		"pragma solidity >=0.0; contract A { function f(uint x) external pure returns (uint) { return x + 1; } }"
+	);
+	std::string const requestB = makeRequest(
+		"pragma solidity >=0.0; contract A { function g(uint y) external pure returns (uint) { return y * 3; } }"
+	);
+
+	// The optimized Yul objects cached for the first request must stay valid across requests.
+	OptionsReaderAndMessages result = runCLI(
+		{"solc", "--server"},
+		requestA + "\n" + requestA + "\n" + requestB + "\n" + requestA + "\n"
+	);
+	BOOST_REQUIRE(result.success);
+	BOOST_TEST(result.stderrContent == "");
+
+	std::vector<std::string> responses;
+	boost::split(responses, boost::trim_copy(result.stdoutContent), boost::is_any_of("\n"));
+	BOOST_REQUIRE_EQUAL(responses.size(), 4);
+
+	auto extractBytecode = [](std::string const& _response) {
+		Json parsedResponse;
+		BOOST_REQUIRE(util::jsonParseStrict(_response, parsedResponse));
+		for (Json const& errorDict: parsedResponse["errors"])
+			// The error list might contain pre-release compiler warning
+			BOOST_TEST(errorDict["severity"] != "error");
+		return parsedResponse["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["object"].get<std::string>();
+	};
+	std::vector<std::string> bytecodes;
+	for (std::string const& response: responses)
+		bytecodes.push_back(extractBytecode(response));
+
+	OptionsReaderAndMessages resultB = runCLI({"solc", "--standard-json"}, requestB);
+	BOOST_REQUIRE(resultB.success);
+
+	BOOST_TEST(!bytecodes[0].empty());
+	BOOST_TEST(bytecodes[1] == bytecodes[0]);
+	BOOST_TEST(bytecodes[2] == extractBytecode(boost::trim_copy(resultB.stdoutContent)));
+	BOOST_TEST(bytecodes[2] != bytecodes[0]);
+	BOOST_TEST(bytecodes[3] == bytecodes[0]);
+}
+
+BOOST_AUTO_TEST_CASE(standard_json_server_input_file)
+{
+	std::string expectedMessage = "--server does not accept input files. Requests are read from standard input.";
+
+	for (std::string const inputFile: {"input.json", "-"})
+		BOOST_CHECK_EXCEPTION(
+			parseCommandLineAndReadInputFiles({"solc", "--server", inputFile}),
+			CommandLineValidationError,
+			[&](auto const& _exception) { BOOST_TEST(_exception.what() == expectedMessage); return true; }
+		);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_cache_dir_reuses_entries)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	boost::filesystem::path const cacheDir = tempDir.path() / "cache";
+	createFileWithContent(
+		tempDir.path() / "input.sol",
+		"pragma solidity >=0.0;\n"
+		"contract C { function f(uint x) external pure returns (uint) { return x * 7 + 3; } }\n"
+	);
+	std::vector<std::string> const commandLine = {
+		"solc",
+		"--via-ir",
+		"--optimize",
+		"--bin",
+		"--optimizer-cache-dir=" + cacheDir.string(),
+		(tempDir.path() / "input.sol").string(),
+	};
+
+	OptionsReaderAndMessages coldResult = runCLI(commandLine, "");
+	BOOST_REQUIRE(coldResult.success);
+	BOOST_REQUIRE(!coldResult.stdoutContent.empty());
+
+	// Backdate the entries so that rewriting any of them would be visible.
+	std::time_t const backdated = std::time(nullptr) - 3600;
+	std::map<boost::filesystem::path, std::time_t> writeTimes;
+	for (auto const& entry: boost::filesystem::directory_iterator(cacheDir))
+	{
+		boost::filesystem::last_write_time(entry.path(), backdated);
+		writeTimes[entry.path()] = boost::filesystem::last_write_time(entry.path());
+	}
+	BOOST_REQUIRE(!writeTimes.empty());
+
+	OptionsReaderAndMessages warmResult = runCLI(commandLine, "");
+	BOOST_REQUIRE(warmResult.success);
+	BOOST_TEST(warmResult.stdoutContent == coldResult.stdoutContent);
+
+	size_t entryCount = 0;
+	for (auto const& entry: boost::filesystem::directory_iterator(cacheDir))
+	{
+		++entryCount;
+		BOOST_REQUIRE(writeTimes.count(entry.path()));
+		BOOST_TEST(boost::filesystem::last_write_time(entry.path()) == writeTimes.at(entry.path()));
+	}
+	BOOST_TEST(entryCount == writeTimes.size());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_cache_dir_ignores_damaged_entries)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	boost::filesystem::path const cacheDir = tempDir.path() / "cache";
+	createFileWithContent(
+		tempDir.path() / "input.sol",
+		"pragma solidity >=0.0;\n"
+		"contract C { function f(uint x) external pure returns (uint) { return x * 7 + 3; } }\n"
+	);
+	std::vector<std::string> const commandLine = {
+		"solc",
+		"--via-ir",
+		"--optimize",
+		"--bin",
+		"--optimizer-cache-dir=" + cacheDir.string(),
+		(tempDir.path() / "input.sol").string(),
+	};
+
+	OptionsReaderAndMessages referenceResult = runCLI(commandLine, "");
+	BOOST_REQUIRE(referenceResult.success);
+
+	std::map<boost::filesystem::path, std::string> originalContents;
+	for (auto const& entry: boost::filesystem::directory_iterator(cacheDir))
+		originalContents[entry.path()] = util::readFileAsString(entry.path());
+	BOOST_REQUIRE(!originalContents.empty());
+
+	std::map<std::string, std::function<std::string(std::string const&)>> const damages = {
+		{"truncated", [](std::string const& _content) { return _content.substr(0, _content.size() / 2); }},
+		{"empty", [](std::string const&) { return std::string{}; }},
+		{"checksum mismatch", [](std::string const& _content) {
+			return "// " + util::keccak256("").hex() + _content.substr(_content.find('\n'));
+		}},
+		{"unparsable", [](std::string const&) {
+			std::string const source = "object \"C\" { code { invalid }";
+			return "// " + util::keccak256(source).hex() + "\n" + source;
+		}},
+	};
+	for (auto const& [description, damage]: damages)
+	{
+		BOOST_TEST_CONTEXT(description)
+		{
+			for (auto const& [path, content]: originalContents)
+				std::ofstream(path.string(), std::ofstream::binary | std::ofstream::trunc) << damage(content);
+
+			OptionsReaderAndMessages result = runCLI(commandLine, "");
+			BOOST_REQUIRE(result.success);
+			BOOST_TEST(result.stdoutContent == referenceResult.stdoutContent);
+
+			// Damaged entries are not trusted and get replaced by freshly optimized ones.
+			for (auto const& [path, content]: originalContents)
+				BOOST_TEST(util::readFileAsString(path) == content);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_no_base_path)
 {
 	TemporaryDirectory tempDirCurrent(TEST_CASE_NAME);
@@ -475,7 +671,7 @@ BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_no_base_path)
 	};
 	expectedOptions.modelChecker.initialize = true;
 
-	std::map<std::string, std::string> expectedSources = {
+	FileReader::StringMap expectedSources = {
 		{"contract1.sol", ""},
 		{"c/d/contract2.sol", ""},
 		{"contract3.sol", ""},
@@ -537,7 +733,7 @@ BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_base_path_same_as_work_dir)
 	expectedOptions.input.basePath = currentDirNoSymlinks;
 	expectedOptions.modelChecker.initialize = true;
 
-	std::map<std::string, std::string> expectedSources = {
+	FileReader::StringMap expectedSources = {
 		{"contract1.sol", ""},
 		{"c/d/contract2.sol", ""},
 		{"contract3.sol", ""},
@@ -608,7 +804,7 @@ BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_base_path_different_from_wor
 	expectedOptions.input.basePath = baseDirNoSymlinks;
 	expectedOptions.modelChecker.initialize = true;
 
-	std::map<std::string, std::string> expectedSources = {
+	FileReader::StringMap expectedSources = {
 		{expectedWorkDir.generic_string() + "/contract1.sol", ""},
 		{expectedWorkDir.generic_string() + "/c/d/contract2.sol", ""},
 		{expectedCurrentDir.generic_string() + "/contract3.sol", ""},
@@ -676,7 +872,7 @@ BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_relative_base_path)
 	expectedOptions.input.basePath = "base";
 	expectedOptions.modelChecker.initialize = true;
 
-	std::map<std::string, std::string> expectedSources = {
+	FileReader::StringMap expectedSources = {
 		{expectedWorkDir.generic_string() + "/contract1.sol", ""},
 		{"contract2.sol", ""},
 		{expectedWorkDir.generic_string() + "/contract3.sol", ""},
@@ -806,7 +1002,7 @@ BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_normalization_and_weird_name
 	};
 	expectedOptions.modelChecker.initialize = true;
 
-	std::map<std::string, std::string> expectedSources = {
+	FileReader::StringMap expectedSources = {
 #if !defined(_WIN32)
 		{"file:/c/d/contract1.sol", ""},
 		{"file:/c/d/contract2.sol", ""},
@@ -906,7 +1102,7 @@ BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_symlinks)
 	expectedOptions.input.basePath = "../r/sym/z/";
 	expectedOptions.modelChecker.initialize = true;
 
-	std::map<std::string, std::string> expectedSources = {
+	FileReader::StringMap expectedSources = {
 		{"contract.sol", ""},
 		{(expectedWorkDir.parent_path() / "x/y/z/contract.sol").generic_string(), ""},
 		{"contract_symlink.sol", ""},
@@ -943,7 +1139,7 @@ BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_base_path_and_stdin)
 	expectedOptions.input.basePath = "base";
 	expectedOptions.modelChecker.initialize = true;
 
-	std::map<std::string, std::string> expectedSources = {
+	FileReader::StringMap expectedSources = {
 		{"<stdin>", ""},
 	};
 	FileReader::FileSystemPathSet expectedAllowedDirectories = {};
@@ -1026,7 +1222,7 @@ BOOST_AUTO_TEST_CASE(cli_include_paths)
 	expectedOptions.formatting.coloredOutput = false;
 	expectedOptions.modelChecker.initialize = true;
 
-	std::map<std::string, std::string> expectedSources = {
+	FileReader::StringMap expectedSources = {
 		{"main.sol", mainContractSource},
 		{"contract.sol", onlyPreamble},
 		{"contract_via_callback.sol", onlyPreamble},
@@ -1162,7 +1358,7 @@ BOOST_AUTO_TEST_CASE(standard_json_include_paths)
 	// NOTE: Source code from Standard JSON does not end up in FileReader. This is not a problem
 	// because FileReader is only used once to initialize the compiler stack and after that
 	// its sources are irrelevant (even though the callback still stores everything it loads).
-	std::map<std::string, std::string> expectedSources = {
+	FileReader::StringMap expectedSources = {
 		{"contract_via_callback.sol", onlyPreamble},
 		{"include_via_callback.sol", onlyPreamble},
 		{"nested_via_callback.sol", onlyPreamble},
@@ -120,6 +120,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--evm-version=spuriousDragon",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--jobs=4",
+			"--profile=/tmp/profile.json",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
@@ -143,8 +145,11 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize-yul",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--optimizer-cache-dir=/tmp/solc-cache",
 			"--model-checker-bmc-loop-iterations=2",
+			"--model-checker-chc-threads=3",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
+			"--model-checker-cross-check-solvers",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
 			"--model-checker-ext-calls=trusted",
@@ -181,6 +186,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.viaIR = true;
+		expectedOptions.output.parallelism = 4;
+		expectedOptions.output.profileFile = "/tmp/profile.json";
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -209,11 +216,14 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.optimizeYul = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.cacheDirectory = "/tmp/solc-cache";
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
 			2,
+			3, // --model-checker-chc-threads
 			{{{"contract1.yul", {"A"}}, {"contract2.yul", {"B"}}}},
+			true, // --model-checker-cross-check-solvers
 			true,
 			{true, false},
 			{ModelCheckerExtCalls::Mode::TRUSTED},
@@ -391,6 +401,7 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 			"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
 		"--gas",                           // Accepted but has no effect in Standard JSON mode
 		"--combined-json=abi,bin",         // Accepted but has no effect in Standard JSON mode
+		"--optimizer-cache-dir=/tmp/solc-cache",
 	};
 
 	CommandLineOptions expectedOptions;
@@ -411,6 +422,7 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	expectedOptions.compiler.combinedJsonRequests = CombinedJsonRequests{};
 	expectedOptions.compiler.combinedJsonRequests->abi = true;
 	expectedOptions.compiler.combinedJsonRequests->binary = true;
+	expectedOptions.optimizer.cacheDirectory = "/tmp/solc-cache";
 
 	CommandLineOptions parsedOptions = parseCommandLine(commandLine);
 
@@ -423,15 +435,20 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		// TODO: This should eventually contain all options.
 		{"--experimental-via-ir", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--jobs=4", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--profile=/tmp/profile.json", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--optimizer-cache-dir=/tmp/solc-cache", {"--assemble", "--strict-assembly", "--link"}},
 		{"--metadata-literal", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-unproved", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-unsupported", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-cross-check-solvers", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-div-mod-no-slacks", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-engine=bmc", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-invariants=contract,reentrancy", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-solvers=z3,smtlib2", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-chc-threads=3", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-timeout=5", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-contracts=contract1.yul:A,contract2.yul:B", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-targets=underflow,divByZero", {"--assemble", "--strict-assembly", "--standard-json", "--link"}}
@@ -94,7 +94,9 @@ void FuzzerUtil::testCompiler(
 		forceSMT(_input);
 		compiler.setModelCheckerSettings({
 			/*bmcLoopIterations*/1,
+			/*chcThreads=*/1,
 			frontend::ModelCheckerContracts::Default(),
+			/*crossCheckSolvers=*/false,
 			/*divModWithSlacks*/true,
 			frontend::ModelCheckerEngine::All(),
 			frontend::ModelCheckerExtCalls{},
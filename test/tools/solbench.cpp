@@ -0,0 +1,568 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compile-time benchmark running CompilerStack in-process over a corpus of contracts.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/FileReader.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/Scanner.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+std::atomic<uint64_t> g_allocationCount = 0;
+std::atomic<uint64_t> g_allocatedBytes = 0;
+
+/// @returns memory for @a _size bytes aligned to @a _alignment or null if there is none.
+void* countedAllocation(std::size_t _size, std::size_t _alignment) noexcept
+{
+	++g_allocationCount;
+	g_allocatedBytes += _size;
+	if (_size == 0)
+		_size = 1;
+	if (_alignment <= alignof(std::max_align_t))
+		return std::malloc(_size);
+#if defined(_WIN32)
+	return _aligned_malloc(_size, _alignment);
+#else
+	// aligned_alloc() requires the size to be a multiple of the alignment.
+	return std::aligned_alloc(_alignment, (_size + _alignment - 1) / _alignment * _alignment);
+#endif
+}
+
+void* countedAllocationOrThrow(std::size_t _size, std::size_t _alignment)
+{
+	if (void* memory = countedAllocation(_size, _alignment))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void deallocation(void* _memory, std::size_t _alignment) noexcept
+{
+#if defined(_WIN32)
+	if (_alignment > alignof(std::max_align_t))
+	{
+		_aligned_free(_memory);
+		return;
+	}
+#else
+	(void)_alignment;
+#endif
+	std::free(_memory);
+}
+
+}
+
+// Counting allocations is the reason this is a separate executable: the replacement operators
+// apply to the whole program, including all compiler libraries. All replaceable allocation
+// functions are replaced, so that the counts include aligned and non-throwing allocations.
+// Memory allocated directly with malloc(), e.g. by C libraries, is not counted.
+void* operator new(std::size_t _size) { return countedAllocationOrThrow(_size, 0); }
+void* operator new[](std::size_t _size) { return countedAllocationOrThrow(_size, 0); }
+void* operator new(std::size_t _size, std::nothrow_t const&) noexcept { return countedAllocation(_size, 0); }
+void* operator new[](std::size_t _size, std::nothrow_t const&) noexcept { return countedAllocation(_size, 0); }
+void* operator new(std::size_t _size, std::align_val_t _alignment)
+{
+	return countedAllocationOrThrow(_size, static_cast<std::size_t>(_alignment));
+}
+void* operator new[](std::size_t _size, std::align_val_t _alignment)
+{
+	return countedAllocationOrThrow(_size, static_cast<std::size_t>(_alignment));
+}
+void* operator new(std::size_t _size, std::align_val_t _alignment, std::nothrow_t const&) noexcept
+{
+	return countedAllocation(_size, static_cast<std::size_t>(_alignment));
+}
+void* operator new[](std::size_t _size, std::align_val_t _alignment, std::nothrow_t const&) noexcept
+{
+	return countedAllocation(_size, static_cast<std::size_t>(_alignment));
+}
+
+void operator delete(void* _memory) noexcept { deallocation(_memory, 0); }
+void operator delete[](void* _memory) noexcept { deallocation(_memory, 0); }
+void operator delete(void* _memory, std::size_t) noexcept { deallocation(_memory, 0); }
+void operator delete[](void* _memory, std::size_t) noexcept { deallocation(_memory, 0); }
+void operator delete(void* _memory, std::nothrow_t const&) noexcept { deallocation(_memory, 0); }
+void operator delete[](void* _memory, std::nothrow_t const&) noexcept { deallocation(_memory, 0); }
+void operator delete(void* _memory, std::align_val_t _alignment) noexcept
+{
+	deallocation(_memory, static_cast<std::size_t>(_alignment));
+}
+void operator delete[](void* _memory, std::align_val_t _alignment) noexcept
+{
+	deallocation(_memory, static_cast<std::size_t>(_alignment));
+}
+void operator delete(void* _memory, std::size_t, std::align_val_t _alignment) noexcept
+{
+	deallocation(_memory, static_cast<std::size_t>(_alignment));
+}
+void operator delete[](void* _memory, std::size_t, std::align_val_t _alignment) noexcept
+{
+	deallocation(_memory, static_cast<std::size_t>(_alignment));
+}
+void operator delete(void* _memory, std::align_val_t _alignment, std::nothrow_t const&) noexcept
+{
+	deallocation(_memory, static_cast<std::size_t>(_alignment));
+}
+void operator delete[](void* _memory, std::align_val_t _alignment, std::nothrow_t const&) noexcept
+{
+	deallocation(_memory, static_cast<std::size_t>(_alignment));
+}
+
+namespace
+{
+
+/// Sources compiled together in one benchmark: a single file or all files of a directory.
+struct BenchmarkInput
+{
+	std::string name;
+	fs::path basePath;
+	std::vector<fs::path> files;
+};
+
+/// Measurements of a single compilation.
+struct Sample
+{
+	bool successful = false;
+	size_t bytecodeSize = 0;
+	size_t tokenCount = 0;
+	double totalMilliseconds = 0;
+	std::map<std::string, double> stageMilliseconds;
+	std::map<std::string, double> phaseMilliseconds;
+	uint64_t allocationCount = 0;
+	uint64_t allocatedBytes = 0;
+};
+
+/// @returns minimum, median, mean and standard deviation of @a _values.
+Json statistics(std::vector<double> _values)
+{
+	if (_values.empty())
+		return Json::object();
+
+	std::sort(_values.begin(), _values.end());
+	size_t const count = _values.size();
+	double const median = (count % 2 == 1) ?
+		_values[count / 2] :
+		(_values[count / 2 - 1] + _values[count / 2]) / 2;
+	double const mean = std::accumulate(_values.begin(), _values.end(), 0.0) / static_cast<double>(count);
+	double squaredDeviations = 0;
+	for (double value: _values)
+		squaredDeviations += (value - mean) * (value - mean);
+	double const standardDeviation = count > 1 ? std::sqrt(squaredDeviations / static_cast<double>(count - 1)) : 0.0;
+
+	return Json{
+		{"min", _values.front()},
+		{"max", _values.back()},
+		{"median", median},
+		{"mean", mean},
+		{"stddev", standardDeviation}
+	};
+}
+
+std::vector<BenchmarkInput> collectInputs(std::vector<std::string> const& _paths)
+{
+	std::vector<BenchmarkInput> inputs;
+	for (std::string const& path: _paths)
+	{
+		fs::path const inputPath = fs::canonical(path);
+		BenchmarkInput input{inputPath.filename().string(), inputPath.parent_path(), {}};
+		if (fs::is_directory(inputPath))
+		{
+			input.basePath = inputPath;
+			for (auto const& entry: fs::recursive_directory_iterator(inputPath))
+				if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+					input.files.push_back(entry.path());
+			std::sort(input.files.begin(), input.files.end());
+		}
+		else
+			input.files.push_back(inputPath);
+
+		if (input.files.empty())
+			throw std::runtime_error("No Solidity files found in " + path + ".");
+		inputs.push_back(std::move(input));
+	}
+	return inputs;
+}
+
+Sample compileOnce(
+	BenchmarkInput const& _input,
+	bool _viaIR,
+	OptimiserSettings const& _optimiserSettings,
+	EVMVersion _evmVersion,
+	size_t _parallelism
+)
+{
+	using Clock = std::chrono::steady_clock;
+	auto const milliseconds = [](Clock::duration _duration) {
+		return std::chrono::duration<double, std::milli>(_duration).count();
+	};
+
+	// Reading the input is part of every compilation, but not of the measurements.
+	FileReader fileReader(_input.basePath, {}, {_input.basePath});
+	for (fs::path const& file: _input.files)
+		fileReader.addOrUpdateFile(file, readFileAsSharedText(file));
+
+	Sample sample;
+	uint64_t const allocationCountBefore = g_allocationCount;
+	uint64_t const allocatedBytesBefore = g_allocatedBytes;
+	auto const profiler = std::make_shared<Profiler>();
+	Clock::time_point const start = Clock::now();
+	{
+		CompilerStack compiler(fileReader.reader());
+		compiler.setSourceTexts(fileReader.sourceUnits());
+		compiler.setViaIR(_viaIR);
+		compiler.setOptimiserSettings(_optimiserSettings);
+		compiler.setEVMVersion(_evmVersion);
+		compiler.setParallelism(_parallelism);
+		compiler.setProfiler(profiler);
+
+		Clock::time_point stageStart = Clock::now();
+		sample.successful = compiler.parse();
+		sample.stageMilliseconds["parsing"] = milliseconds(Clock::now() - stageStart);
+		if (sample.successful)
+		{
+			stageStart = Clock::now();
+			sample.successful = compiler.analyze();
+			sample.stageMilliseconds["analysis"] = milliseconds(Clock::now() - stageStart);
+		}
+		if (sample.successful)
+		{
+			stageStart = Clock::now();
+			sample.successful = compiler.compile();
+			sample.stageMilliseconds["codegen"] = milliseconds(Clock::now() - stageStart);
+		}
+
+		if (sample.successful)
+			for (std::string const& contractName: compiler.contractNames())
+				sample.bytecodeSize += compiler.object(contractName).bytecode.size();
+		else
+			SourceReferenceFormatter{std::cerr, compiler, false, false}.printErrorInformation(compiler.errors());
+	}
+	sample.totalMilliseconds = milliseconds(Clock::now() - start);
+	sample.allocationCount = g_allocationCount - allocationCountBefore;
+	sample.allocatedBytes = g_allocatedBytes - allocatedBytesBefore;
+
+	// Nested phases are counted in full for every enclosing phase as well.
+	Json const trace = profiler->chromeTrace();
+	for (Json const& event: trace["traceEvents"])
+		if (event["ph"] == "X")
+			sample.phaseMilliseconds[event["cat"].get<std::string>() + "/" + event["name"].get<std::string>()] +=
+				event["dur"].get<double>() / 1000.0;
+
+	return sample;
+}
+
+/// Tokenizes every source of the input without parsing it.
+Sample scanOnce(std::vector<SharedText> const& _sources)
+{
+	using Clock = std::chrono::steady_clock;
+
+	Sample sample;
+	sample.successful = true;
+	uint64_t const allocationCountBefore = g_allocationCount;
+	uint64_t const allocatedBytesBefore = g_allocatedBytes;
+	Clock::time_point const start = Clock::now();
+	for (SharedText const& source: _sources)
+	{
+		CharStream stream(source, "");
+		for (Scanner scanner(stream); scanner.currentToken() != Token::EOS; scanner.next())
+		{
+			if (scanner.currentToken() == Token::Illegal)
+				sample.successful = false;
+			++sample.tokenCount;
+		}
+	}
+	sample.totalMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	sample.stageMilliseconds["scanning"] = sample.totalMilliseconds;
+	sample.allocationCount = g_allocationCount - allocationCountBefore;
+	sample.allocatedBytes = g_allocatedBytes - allocatedBytesBefore;
+	return sample;
+}
+
+Json summarize(std::vector<Sample> const& _samples)
+{
+	std::vector<double> totals;
+	std::vector<double> allocationCounts;
+	std::vector<double> allocatedBytes;
+	std::map<std::string, std::vector<double>> stages;
+	std::map<std::string, std::vector<double>> phases;
+	for (Sample const& sample: _samples)
+	{
+		totals.push_back(sample.totalMilliseconds);
+		allocationCounts.push_back(static_cast<double>(sample.allocationCount));
+		allocatedBytes.push_back(static_cast<double>(sample.allocatedBytes));
+		for (auto const& [stage, duration]: sample.stageMilliseconds)
+			stages[stage].push_back(duration);
+		for (auto const& [phase, duration]: sample.phaseMilliseconds)
+			phases[phase].push_back(duration);
+	}
+
+	Json result{
+		{"timeMs", statistics(totals)},
+		{"allocations", statistics(allocationCounts)},
+		{"allocatedBytes", statistics(allocatedBytes)},
+		{"stagesMs", Json::object()},
+		{"phasesMs", Json::object()}
+	};
+	for (auto const& [stage, durations]: stages)
+		result["stagesMs"][stage] = statistics(durations);
+	for (auto const& [phase, durations]: phases)
+		result["phasesMs"][phase] = statistics(durations);
+	return result;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		po::options_description options(
+			R"(solbench, compile-time benchmark for the Solidity compiler.
+	Usage: solbench [Options] <path>...
+	Compiles every <path> in-process with the legacy and the IR pipeline and reports
+	wall time per stage and phase, allocation counts and peak memory usage as JSON.
+	With --scanner-only, only tokenizes the sources and reports the scanner throughput.
+	A <path> is either a single source file or a directory whose .sol files are
+	compiled together. Imports are resolved relative to the directory.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"input-paths",
+				po::value<std::vector<std::string>>(),
+				"input files or directories"
+			)
+			(
+				"pipeline",
+				po::value<std::string>()->default_value("both"),
+				"pipelines to benchmark: legacy, ir or both"
+			)
+			(
+				"repetitions,r",
+				po::value<size_t>()->default_value(5),
+				"number of measured compilations of every input and pipeline"
+			)
+			(
+				"warmup",
+				po::value<size_t>()->default_value(1),
+				"number of unmeasured compilations preceding the measured ones"
+			)
+			(
+				"scanner-only",
+				"only measure the scanner by tokenizing the sources instead of compiling them"
+			)
+			(
+				"no-optimize",
+				"disable the optimizer"
+			)
+			(
+				"evm-version",
+				po::value<std::string>(),
+				"EVM version to compile for"
+			)
+			(
+				"jobs,j",
+				po::value<size_t>()->default_value(1),
+				"number of threads used for code generation of independent contracts via the IR"
+			)
+			(
+				"output,o",
+				po::value<std::string>(),
+				"write the report to the given file instead of standard output"
+			)
+			("help,h", "Show this help screen.");
+
+		po::positional_options_description filesPositions;
+		filesPositions.add("input-paths", -1);
+
+		po::variables_map arguments;
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help") || !arguments.count("input-paths"))
+		{
+			std::cout << options;
+			return arguments.count("help") ? 0 : 1;
+		}
+
+		std::string const pipeline = arguments["pipeline"].as<std::string>();
+		std::vector<bool> viaIRValues;
+		if (pipeline == "legacy" || pipeline == "both")
+			viaIRValues.push_back(false);
+		if (pipeline == "ir" || pipeline == "both")
+			viaIRValues.push_back(true);
+		if (viaIRValues.empty())
+		{
+			std::cerr << "Invalid pipeline: " << pipeline << std::endl;
+			return 1;
+		}
+
+		EVMVersion evmVersion;
+		if (arguments.count("evm-version"))
+		{
+			std::optional<EVMVersion> version = EVMVersion::fromString(arguments["evm-version"].as<std::string>());
+			if (!version)
+			{
+				std::cerr << "Invalid EVM version: " << arguments["evm-version"].as<std::string>() << std::endl;
+				return 1;
+			}
+			evmVersion = *version;
+		}
+
+		bool const optimize = !arguments.count("no-optimize");
+		OptimiserSettings const optimiserSettings = optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal();
+		size_t const repetitions = std::max<size_t>(arguments["repetitions"].as<size_t>(), 1);
+		size_t const warmup = arguments["warmup"].as<size_t>();
+		size_t const parallelism = arguments["jobs"].as<size_t>();
+
+		bool const scannerOnly = arguments.count("scanner-only");
+
+		Json benchmarks = Json::array();
+		for (BenchmarkInput const& input: collectInputs(arguments["input-paths"].as<std::vector<std::string>>()))
+			if (scannerOnly)
+			{
+				std::cerr << "Benchmarking " << input.name << " (scanner)" << std::endl;
+				std::vector<SharedText> sources;
+				size_t sourceBytes = 0;
+				for (fs::path const& file: input.files)
+				{
+					sources.emplace_back(readFileAsSharedText(file));
+					sourceBytes += sources.back().size();
+				}
+				for (size_t i = 0; i < warmup; ++i)
+					scanOnce(sources);
+
+				std::vector<Sample> samples;
+				std::vector<double> throughputs;
+				for (size_t i = 0; i < repetitions; ++i)
+				{
+					samples.emplace_back(scanOnce(sources));
+					// Bytes per millisecond are kilobytes per second, hence the division by 1000.
+					throughputs.push_back(static_cast<double>(sourceBytes) / samples.back().totalMilliseconds / 1000.0);
+				}
+
+				Json benchmark = summarize(samples);
+				benchmark["name"] = input.name;
+				benchmark["pipeline"] = "scanner";
+				benchmark["successful"] = std::all_of(samples.begin(), samples.end(), [](Sample const& _sample) { return _sample.successful; });
+				benchmark["sourceBytes"] = sourceBytes;
+				benchmark["tokenCount"] = samples.front().tokenCount;
+				benchmark["throughputMBps"] = statistics(throughputs);
+				benchmarks.emplace_back(std::move(benchmark));
+			}
+			else
+				for (bool viaIR: viaIRValues)
+				{
+					std::cerr << "Benchmarking " << input.name << " (" << (viaIR ? "ir" : "legacy") << ")" << std::endl;
+					for (size_t i = 0; i < warmup; ++i)
+						compileOnce(input, viaIR, optimiserSettings, evmVersion, parallelism);
+
+					std::vector<Sample> samples;
+					for (size_t i = 0; i < repetitions; ++i)
+						samples.emplace_back(compileOnce(input, viaIR, optimiserSettings, evmVersion, parallelism));
+
+					Json benchmark = summarize(samples);
+					benchmark["name"] = input.name;
+					benchmark["pipeline"] = viaIR ? "ir" : "legacy";
+					benchmark["successful"] = std::all_of(samples.begin(), samples.end(), [](Sample const& _sample) { return _sample.successful; });
+					benchmark["bytecodeSize"] = samples.front().bytecodeSize;
+					// The peak memory usage of the process never decreases, so this is an upper bound
+					// for the current benchmark that depends on the benchmarks run before it.
+					if (std::optional<size_t> peakMemory = Profiler::peakMemoryUsageKiB())
+						benchmark["peakMemoryKiB"] = *peakMemory;
+					benchmarks.emplace_back(std::move(benchmark));
+				}
+
+		Json report{
+			{"compilerVersion", VersionString},
+			{"optimize", optimize},
+			{"evmVersion", evmVersion.name()},
+			{"repetitions", repetitions},
+			{"warmup", warmup},
+			{"jobs", parallelism},
+			{"benchmarks", std::move(benchmarks)}
+		};
+
+		if (arguments.count("output"))
+		{
+			std::ofstream outputFile(arguments["output"].as<std::string>());
+			outputFile << jsonPrettyPrint(report) << std::endl;
+			if (!outputFile)
+			{
+				std::cerr << "Could not write to file " << arguments["output"].as<std::string>() << std::endl;
+				return 1;
+			}
+		}
+		else
+			std::cout << jsonPrettyPrint(report) << std::endl;
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+	catch (std::exception const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}